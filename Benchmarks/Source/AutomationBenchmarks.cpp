@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    AutomationBenchmarks.cpp
+    Created: 19 Oct 2026 11:48:20am
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <DspCore.h>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 512;
+    constexpr int NUM_CHANNELS = 2;
+    constexpr double SAMPLE_RATE = 48000.0;
+
+    const juce::StringArray CORE_NAMES { "easyverb", "gramophony", "wavefolder" };
+
+    // A core and the automation of its first continuous parameter, the same ramp every
+    // run. Block rate sets the last value of the block before processing, sample accurate
+    // splits the block at each event. Both call the same DspCore, so this only compares the
+    // two ways of applying automation to a core; the automation command of EditorBenchmarks
+    // times the CLAP plugin's process against the VST3 plugin's processBlock.
+    struct AutomationState
+    {
+        AutomationState (DspCoreType type, int num_events)
+            : core (dspcore_create (type)),
+              input (NUM_CHANNELS, std::vector<float> (NUM_FRAMES)),
+              channels (input)
+        {
+            juce::Random random (0x5eed);
+            for (auto& channel : input)
+            {
+                for (auto& sample : channel)
+                    sample = random.nextFloat() * 2.0f - 1.0f;
+            }
+            for (auto& channel : channels)
+                pointers.push_back (channel.data());
+
+            int index = 0;
+            while (index < dspcore_get_num_parameters (core) && dspcore_get_parameter_flags (core, index) != 0)
+                ++index;
+
+            DspCoreParameterInfo info;
+            dspcore_get_parameter_info (core, index, &info);
+
+            for (int event = 0; event < num_events; ++event)
+            {
+                const float position = static_cast<float> (event + 1) / static_cast<float> (num_events);
+                events.push_back ({ event * NUM_FRAMES / num_events, index, info.min_value + position * (info.max_value - info.min_value) });
+            }
+
+            dspcore_prepare (core, SAMPLE_RATE, NUM_FRAMES, NUM_CHANNELS);
+        }
+
+        ~AutomationState()
+        {
+            dspcore_destroy (core);
+        }
+
+        void refill()
+        {
+            for (size_t channel = 0; channel < channels.size(); ++channel)
+                std::copy (input[channel].begin(), input[channel].end(), channels[channel].begin());
+        }
+
+        DspCore* core;
+        std::vector<std::vector<float>> input;
+        std::vector<std::vector<float>> channels;
+        std::vector<float*> pointers;
+        std::vector<DspCoreParameterEvent> events;
+
+        JUCE_DECLARE_NON_COPYABLE (AutomationState)
+    };
+}
+
+std::vector<Benchmark> createAutomationBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    for (int type = 0; type < CORE_NAMES.size(); ++type)
+    {
+        for (int num_events : { 0, 8, 64 })
+        {
+            for (bool sample_accurate : { false, true })
+            {
+                auto state = std::make_shared<AutomationState> (static_cast<DspCoreType> (type), num_events);
+
+                Benchmark benchmark;
+                benchmark.name = "automation/" + CORE_NAMES[type] + "/" + juce::String (num_events) + " events/"
+                                 + (sample_accurate ? "sample accurate" : "block rate");
+                benchmark.samples_per_run = NUM_FRAMES;
+                benchmark.run = [state, sample_accurate]
+                {
+                    state->refill();
+
+                    if (sample_accurate)
+                    {
+                        dspcore_process_events (state->core, state->pointers.data(), NUM_CHANNELS, NUM_FRAMES, state->events.data(), static_cast<int> (state->events.size()));
+                    }
+                    else
+                    {
+                        if (! state->events.empty())
+                            dspcore_set_parameter (state->core, state->events.back().index, state->events.back().value);
+                        dspcore_process (state->core, state->pointers.data(), NUM_CHANNELS, NUM_FRAMES);
+                    }
+                };
+                benchmarks.push_back (std::move (benchmark));
+            }
+        }
+    }
+
+    return benchmarks;
+}
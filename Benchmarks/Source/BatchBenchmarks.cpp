@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    BatchBenchmarks.cpp
+    Created: 19 Oct 2026 8:51:09pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <FoldCascade.h>
+#include <FreeverbBatch.h>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 512;
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr float INPUT_GAIN = 2.0f;
+    constexpr float THRESHOLD = 0.2f;
+
+    // Every stream gets its own noise, so no lane can take a shortcut the others cannot
+    std::vector<std::vector<float>> makeStreams (int num_channels)
+    {
+        juce::Random random (0x5eed);
+        std::vector<std::vector<float>> channels (static_cast<size_t> (num_channels), std::vector<float> (NUM_FRAMES));
+        for (auto& channel : channels)
+        {
+            for (auto& sample : channel)
+                sample = random.nextFloat() * 2.0f - 1.0f;
+        }
+        return channels;
+    }
+
+    juce::Reverb::Parameters getReverbParameters()
+    {
+        juce::Reverb::Parameters parameters;
+        parameters.roomSize = 0.8f;
+        parameters.damping = 0.4f;
+        parameters.wetLevel = 1.0f;
+        parameters.dryLevel = 0.0f;
+        return parameters;
+    }
+
+    // The channels of num_streams streams, refilled with the same noise before every run so the
+    // reverbs never feed on their own output
+    struct Streams
+    {
+        Streams (int num_streams, int num_channels)
+            : input (makeStreams (num_streams * num_channels)),
+              channels (input)
+        {
+            for (auto& channel : channels)
+                pointers.push_back (channel.data());
+        }
+
+        void refill()
+        {
+            for (size_t channel = 0; channel < channels.size(); ++channel)
+                std::copy (input[channel].begin(), input[channel].end(), channels[channel].begin());
+        }
+
+        std::vector<std::vector<float>> input;
+        std::vector<std::vector<float>> channels;
+        std::vector<float*> pointers;
+    };
+
+    // num_streams separate reverbs, the way as many plugin instances would run them
+    struct SeparateReverbs
+    {
+        SeparateReverbs (int num_streams, int num_channels)
+            : streams (num_streams, num_channels),
+              reverbs (static_cast<size_t> (num_streams)),
+              arenas (static_cast<size_t> (num_streams)),
+              num_channels (num_channels)
+        {
+            for (size_t stream = 0; stream < reverbs.size(); ++stream)
+            {
+                arenas[stream].prepare (Freeverb::getRequiredBytes (SAMPLE_RATE, Freeverb::Precision::float32));
+                reverbs[stream].prepare (SAMPLE_RATE, Freeverb::Precision::float32, arenas[stream]);
+                reverbs[stream].setParameters (getReverbParameters());
+            }
+        }
+
+        void run()
+        {
+            streams.refill();
+            for (size_t stream = 0; stream < reverbs.size(); ++stream)
+            {
+                auto* const* channels = streams.pointers.data() + stream * static_cast<size_t> (num_channels);
+                if (num_channels == 2)
+                    reverbs[stream].processStereo (channels[0], channels[1], NUM_FRAMES);
+                else
+                    reverbs[stream].processMono (channels[0], NUM_FRAMES);
+            }
+        }
+
+        Streams streams;
+        std::vector<Freeverb> reverbs;
+        std::vector<Arena> arenas;
+        int num_channels;
+    };
+
+    struct BatchedReverbs
+    {
+        BatchedReverbs (int num_streams, int num_channels)
+            : streams (num_streams, num_channels)
+        {
+            arena.prepare (FreeverbBatch::getRequiredBytes (SAMPLE_RATE, num_streams, num_channels, NUM_FRAMES));
+            reverb.prepare (SAMPLE_RATE, num_streams, num_channels, NUM_FRAMES, arena);
+            reverb.setParameters (getReverbParameters());
+        }
+
+        void run()
+        {
+            streams.refill();
+            reverb.process (streams.pointers.data(), NUM_FRAMES);
+        }
+
+        Streams streams;
+        FreeverbBatch reverb;
+        Arena arena;
+    };
+
+    // The modulation of one block, the same for every stream
+    struct FoldStreams
+    {
+        explicit FoldStreams (int num_streams)
+            : input (static_cast<size_t> (NUM_FRAMES * num_streams)),
+              samples (input.size()),
+              input_gains (NUM_FRAMES, INPUT_GAIN),
+              biases (NUM_FRAMES, 0.0f),
+              thresholds (NUM_FRAMES, THRESHOLD)
+        {
+            juce::Random random (0x5eed);
+            for (auto& sample : input)
+                sample = random.nextFloat() * 2.0f - 1.0f;
+
+            fold.setStages (FoldCascade::Curve::sine, 4, 0.8f, 1.3f);
+        }
+
+        FoldCascade::Modulation getModulation() const { return { input_gains.data(), biases.data(), thresholds.data() }; }
+
+        std::vector<float> input;
+        std::vector<float> samples;
+        std::vector<float> input_gains;
+        std::vector<float> biases;
+        std::vector<float> thresholds;
+        FoldCascade fold;
+    };
+
+    juce::String getName (const juce::String& module, int num_streams, const juce::String& layout)
+    {
+        return "batch/" + module + "/" + juce::String (num_streams) + " streams/" + layout;
+    }
+}
+
+std::vector<Benchmark> createBatchBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    // The time per sample of one stream, so separate and batched runs compare directly
+    for (int num_channels : { 1, 2 })
+    {
+        const juce::String module = num_channels == 2 ? "reverb stereo" : "reverb mono";
+
+        for (int num_streams : { 1, 8, 64 })
+        {
+            auto separate = std::make_shared<SeparateReverbs> (num_streams, num_channels);
+
+            Benchmark separate_benchmark;
+            separate_benchmark.name = getName (module, num_streams, "separate");
+            separate_benchmark.samples_per_run = NUM_FRAMES * num_streams;
+            separate_benchmark.run = [separate] { separate->run(); };
+            benchmarks.push_back (std::move (separate_benchmark));
+
+            auto batched = std::make_shared<BatchedReverbs> (num_streams, num_channels);
+
+            Benchmark batched_benchmark;
+            batched_benchmark.name = getName (module, num_streams, "batched");
+            batched_benchmark.samples_per_run = NUM_FRAMES * num_streams;
+            batched_benchmark.run = [batched] { batched->run(); };
+            benchmarks.push_back (std::move (batched_benchmark));
+        }
+    }
+
+    for (int num_streams : { 1, 8, 64 })
+    {
+        auto state = std::make_shared<FoldStreams> (num_streams);
+
+        Benchmark separate;
+        separate.name = getName ("fold", num_streams, "separate");
+        separate.samples_per_run = NUM_FRAMES * num_streams;
+        separate.run = [state, num_streams]
+        {
+            std::copy (state->input.begin(), state->input.end(), state->samples.begin());
+            for (int stream = 0; stream < num_streams; ++stream)
+                state->fold.process (state->samples.data() + stream * NUM_FRAMES, NUM_FRAMES, 1, state->getModulation(), 0);
+        };
+        benchmarks.push_back (std::move (separate));
+
+        Benchmark batched;
+        batched.name = getName ("fold", num_streams, "batched");
+        batched.samples_per_run = NUM_FRAMES * num_streams;
+        batched.run = [state, num_streams]
+        {
+            std::copy (state->input.begin(), state->input.end(), state->samples.begin());
+            state->fold.processInterleaved (state->samples.data(), NUM_FRAMES, num_streams, 1, state->getModulation(), 0);
+        };
+        benchmarks.push_back (std::move (batched));
+    }
+
+    return benchmarks;
+}
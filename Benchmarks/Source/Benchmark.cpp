@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    Benchmark.cpp
+    Created: 19 Oct 2026 6:20:37pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+constexpr int NUM_REPEATS = 5;
+
+juce::String BenchmarkResult::toString() const
+{
+    const double samples_per_second = ns_per_sample > 0.0 ? 1.0e9 / ns_per_sample : 0.0;
+
+    return name.paddedRight (' ', 40)
+           + juce::String (ns_per_sample, 3).paddedLeft (' ', 10) + " ns/sample"
+           + juce::String (samples_per_second * 1.0e-6, 1).paddedLeft (' ', 10) + " Msamples/s";
+}
+
+BenchmarkResult measure (const Benchmark& benchmark, double min_seconds)
+{
+    jassert (benchmark.samples_per_run > 0);
+
+    BenchmarkResult result;
+    result.name = benchmark.name;
+
+    // Warm up the caches and the branch predictors
+    benchmark.run();
+
+    const auto repeat_ticks = juce::Time::secondsToHighResolutionTicks (min_seconds / NUM_REPEATS);
+    double best_seconds_per_run = std::numeric_limits<double>::max();
+
+    for (int repeat = 0; repeat < NUM_REPEATS; ++repeat)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        auto now = start;
+        juce::int64 num_runs = 0;
+
+        do
+        {
+            benchmark.run();
+            ++num_runs;
+            now = juce::Time::getHighResolutionTicks();
+        } while (now - start < repeat_ticks);
+
+        best_seconds_per_run = juce::jmin (best_seconds_per_run, juce::Time::highResolutionTicksToSeconds (now - start) / static_cast<double> (num_runs));
+        result.num_runs += num_runs;
+    }
+
+    result.ns_per_sample = best_seconds_per_run * 1.0e9 / benchmark.samples_per_run;
+    return result;
+}
+
+std::vector<Benchmark> createAllBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    for (auto* create : { &createFoldBenchmarks, &createBatchBenchmarks, &createAutomationBenchmarks, &createPipelineBenchmarks,
+                          &createRackBenchmarks, &createFastMathBenchmarks, &createOversamplingBenchmarks })
+    {
+        auto module_benchmarks = create();
+        std::move (module_benchmarks.begin(), module_benchmarks.end(), std::back_inserter (benchmarks));
+    }
+
+    return benchmarks;
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: 19 Oct 2026 6:20:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// One timed piece of DSP. run() processes samples_per_run samples, any state it needs is
+// owned by the closure and set up before the benchmark is returned, so it is not timed.
+struct Benchmark
+{
+    juce::String name;
+    int samples_per_run = 0;
+    std::function<void()> run;
+};
+
+struct BenchmarkResult
+{
+    juce::String name;
+    double ns_per_sample = 0.0;
+    juce::int64 num_runs = 0;
+
+    juce::String toString() const;
+};
+
+// Runs the benchmark until min_seconds have passed, after a warm up run. The result is the
+// fastest of a number of repeats, the one least disturbed by the rest of the system.
+BenchmarkResult measure (const Benchmark& benchmark, double min_seconds);
+
+// The benchmarks of each module, in the order they are listed and run
+std::vector<Benchmark> createFoldBenchmarks();
+std::vector<Benchmark> createBatchBenchmarks();
+std::vector<Benchmark> createAutomationBenchmarks();
+std::vector<Benchmark> createPipelineBenchmarks();
+std::vector<Benchmark> createRackBenchmarks();
+std::vector<Benchmark> createFastMathBenchmarks();
+std::vector<Benchmark> createOversamplingBenchmarks();
+
+std::vector<Benchmark> createAllBenchmarks();
+
+// One line per fast math function whose name contains filter, with its largest error over the
+// valid inputs and its time per sample scalar and SIMD, next to the std:: function it replaces.
+// See FastMath.h.
+juce::StringArray createFastMathTable (const juce::String& filter, double min_seconds);
+
+// One line per oversampling configuration whose name contains filter, e.g. "fir/4x/stereo",
+// with the time per sample of Oversampler and of juce::dsp::Oversampling set up with the same
+// stages, and the latency of both. See OversamplingBenchmarks.cpp.
+juce::StringArray createOversamplingTable (const juce::String& filter, double min_seconds);
@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    FastMathBenchmarks.cpp
+    Created: 19 Oct 2026 5:12:46pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <FastMath.h>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 4096;
+    // Points the error is measured at, spread evenly over the valid input range
+    constexpr int NUM_ACCURACY_POINTS = 1 << 20;
+
+    // A std:: function, the inputs the approximations of it are valid for and how their error
+    // is measured. y is only used by pow.
+    struct Function
+    {
+        juce::String name;
+        juce::Range<float> x;
+        juce::Range<float> y;
+        bool relative_error;
+    };
+
+    // x evenly spaced over the range for the accuracy, noise in the range for the timing, so
+    // no branch of a clamp is always taken. y is noise in both.
+    struct Inputs
+    {
+        Inputs (const Function& function, int num_points, bool evenly_spaced)
+            : x (static_cast<size_t> (num_points)),
+              y (static_cast<size_t> (num_points)),
+              output (static_cast<size_t> (num_points))
+        {
+            juce::Random random (0x5eed);
+            for (size_t point = 0; point < x.size(); ++point)
+            {
+                const float position = evenly_spaced ? static_cast<float> (point) / static_cast<float> (num_points - 1) : random.nextFloat();
+                x[point] = function.x.getStart() + position * function.x.getLength();
+                y[point] = function.y.getStart() + random.nextFloat() * function.y.getLength();
+            }
+        }
+
+        int size() const { return static_cast<int> (x.size()); }
+
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> output;
+    };
+
+    // One row of the table: the std:: function or one degree of its approximation
+    struct Entry
+    {
+        juce::String name;
+        // Null for the std:: function itself
+        std::function<double()> measure_error;
+        bool relative_error = false;
+        Benchmark scalar;
+        // Not run for the std:: function
+        Benchmark simd;
+    };
+
+    template <typename Approximation>
+    void runScalar (Inputs& inputs, Approximation& approximation)
+    {
+        for (size_t point = 0; point < inputs.x.size(); ++point)
+            inputs.output[point] = approximation (inputs.x[point], inputs.y[point]);
+    }
+
+    template <typename Approximation>
+    void runSimd (Inputs& inputs, Approximation& approximation)
+    {
+        FastMath::process (inputs.x.data(), inputs.y.data(), inputs.output.data(), inputs.size(), approximation);
+    }
+
+    // Largest error of the scalar and the SIMD version against reference in double precision
+    template <typename Reference, typename Approximation>
+    double measureError (const Function& function, Reference reference, Approximation approximation)
+    {
+        Inputs inputs (function, NUM_ACCURACY_POINTS, true);
+        double max_error = 0.0;
+
+        for (auto* run : { &runScalar<Approximation>, &runSimd<Approximation> })
+        {
+            run (inputs, approximation);
+
+            for (size_t point = 0; point < inputs.x.size(); ++point)
+            {
+                const double exact = reference (static_cast<double> (inputs.x[point]), static_cast<double> (inputs.y[point]));
+                double error = std::abs (static_cast<double> (inputs.output[point]) - exact);
+                if (function.relative_error)
+                    error /= std::abs (exact);
+                max_error = juce::jmax (max_error, error);
+            }
+        }
+
+        return max_error;
+    }
+
+    Benchmark makeBenchmark (const juce::String& name, std::function<void()> run)
+    {
+        Benchmark benchmark;
+        benchmark.name = "fastmath/" + name;
+        benchmark.samples_per_run = NUM_FRAMES;
+        benchmark.run = std::move (run);
+        return benchmark;
+    }
+
+    // reference and approximation take (x, y), reference in double and float, approximation
+    // in float and FastMath::Vec
+    template <typename Reference, typename Approximation>
+    Entry makeEntry (const Function& function, int degree, Reference reference, Approximation approximation)
+    {
+        auto inputs = std::make_shared<Inputs> (function, NUM_FRAMES, false);
+
+        Entry entry;
+        entry.name = function.name + "/" + juce::String (degree);
+        entry.relative_error = function.relative_error;
+        entry.measure_error = [function, reference, approximation] { return measureError (function, reference, approximation); };
+        entry.scalar = makeBenchmark (entry.name + "/scalar", [inputs, approximation]() mutable { runScalar (*inputs, approximation); });
+        entry.simd = makeBenchmark (entry.name + "/simd", [inputs, approximation]() mutable { runSimd (*inputs, approximation); });
+        return entry;
+    }
+
+    template <typename Reference>
+    Entry makeReferenceEntry (const Function& function, Reference reference)
+    {
+        auto inputs = std::make_shared<Inputs> (function, NUM_FRAMES, false);
+
+        Entry entry;
+        entry.name = function.name + "/std";
+        entry.scalar = makeBenchmark (entry.name, [inputs, reference]() mutable { runScalar (*inputs, reference); });
+        return entry;
+    }
+
+    // The ranges are the valid inputs in FastMath.h
+    std::vector<Entry> createEntries()
+    {
+        const Function sin_function { "sin", { -1000.0f, 1000.0f }, {}, false };
+        const Function tanh_function { "tanh", { -10.0f, 10.0f }, {}, false };
+        const Function exp2_function { "exp2", { -126.0f, 127.0f }, {}, true };
+        const Function exp_function { "exp", { -87.3f, 88.0f }, {}, true };
+        const Function log2_function { "log2", { std::numeric_limits<float>::min(), 1000.0f }, {}, false };
+        // |y log2 x| <= 4
+        const Function pow_function { "pow", { 0.0625f, 16.0f }, { -1.0f, 1.0f }, true };
+
+        const auto std_sin = [] (auto x, auto) { return std::sin (x); };
+        const auto std_tanh = [] (auto x, auto) { return std::tanh (x); };
+        const auto std_exp2 = [] (auto x, auto) { return std::exp2 (x); };
+        const auto std_exp = [] (auto x, auto) { return std::exp (x); };
+        const auto std_log2 = [] (auto x, auto) { return std::log2 (x); };
+        const auto std_pow = [] (auto x, auto y) { return std::pow (x, y); };
+
+        return {
+            makeReferenceEntry (sin_function, std_sin),
+            makeEntry (sin_function, 5, std_sin, [] (auto x, auto) { return FastMath::sin<5> (x); }),
+            makeEntry (sin_function, 7, std_sin, [] (auto x, auto) { return FastMath::sin<7> (x); }),
+            makeEntry (sin_function, 9, std_sin, [] (auto x, auto) { return FastMath::sin<9> (x); }),
+
+            makeReferenceEntry (tanh_function, std_tanh),
+            makeEntry (tanh_function, 3, std_tanh, [] (auto x, auto) { return FastMath::tanh<3> (x); }),
+            makeEntry (tanh_function, 5, std_tanh, [] (auto x, auto) { return FastMath::tanh<5> (x); }),
+            makeEntry (tanh_function, 7, std_tanh, [] (auto x, auto) { return FastMath::tanh<7> (x); }),
+
+            makeReferenceEntry (exp2_function, std_exp2),
+            makeEntry (exp2_function, 3, std_exp2, [] (auto x, auto) { return FastMath::exp2<3> (x); }),
+            makeEntry (exp2_function, 4, std_exp2, [] (auto x, auto) { return FastMath::exp2<4> (x); }),
+            makeEntry (exp2_function, 5, std_exp2, [] (auto x, auto) { return FastMath::exp2<5> (x); }),
+
+            makeReferenceEntry (exp_function, std_exp),
+            makeEntry (exp_function, 3, std_exp, [] (auto x, auto) { return FastMath::exp<3> (x); }),
+            makeEntry (exp_function, 4, std_exp, [] (auto x, auto) { return FastMath::exp<4> (x); }),
+            makeEntry (exp_function, 5, std_exp, [] (auto x, auto) { return FastMath::exp<5> (x); }),
+
+            makeReferenceEntry (log2_function, std_log2),
+            makeEntry (log2_function, 3, std_log2, [] (auto x, auto) { return FastMath::log2<3> (x); }),
+            makeEntry (log2_function, 5, std_log2, [] (auto x, auto) { return FastMath::log2<5> (x); }),
+            makeEntry (log2_function, 7, std_log2, [] (auto x, auto) { return FastMath::log2<7> (x); }),
+
+            makeReferenceEntry (pow_function, std_pow),
+            makeEntry (pow_function, 3, std_pow, [] (auto x, auto y) { return FastMath::pow<3> (x, y); }),
+            makeEntry (pow_function, 5, std_pow, [] (auto x, auto y) { return FastMath::pow<5> (x, y); }),
+        };
+    }
+}
+
+std::vector<Benchmark> createFastMathBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    for (auto& entry : createEntries())
+    {
+        benchmarks.push_back (std::move (entry.scalar));
+        if (entry.measure_error != nullptr)
+            benchmarks.push_back (std::move (entry.simd));
+    }
+
+    return benchmarks;
+}
+
+juce::StringArray createFastMathTable (const juce::String& filter, double min_seconds)
+{
+    juce::StringArray lines;
+    lines.add (juce::String ("function").paddedRight (' ', 16) + juce::String ("max error").paddedLeft (' ', 14)
+               + juce::String ("scalar").paddedLeft (' ', 16) + juce::String ("simd").paddedLeft (' ', 16));
+
+    for (const auto& entry : createEntries())
+    {
+        if (! entry.name.contains (filter))
+            continue;
+
+        auto line = entry.name.paddedRight (' ', 16);
+
+        if (entry.measure_error != nullptr)
+            line += (juce::String (entry.measure_error(), 2, true) + (entry.relative_error ? " rel" : " abs")).paddedLeft (' ', 14);
+        else
+            line += juce::String().paddedLeft (' ', 14);
+
+        line += (juce::String (measure (entry.scalar, min_seconds).ns_per_sample, 3) + " ns").paddedLeft (' ', 16);
+        if (entry.measure_error != nullptr)
+            line += (juce::String (measure (entry.simd, min_seconds).ns_per_sample, 3) + " ns").paddedLeft (' ', 16);
+
+        lines.add (line);
+    }
+
+    return lines;
+}
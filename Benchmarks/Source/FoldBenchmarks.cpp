@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    FoldBenchmarks.cpp
+    Created: 19 Oct 2026 6:34:02pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <FoldCascade.h>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 512;
+    constexpr float INPUT_GAIN = 2.0f;
+    constexpr float THRESHOLD = 0.2f;
+
+    const juce::StringArray CURVE_NAMES { "triangle", "sine", "buchla", "soft", "custom" };
+
+    // The samples, modulation and cascade one benchmark folds. Every run folds a fresh copy
+    // of the same noise, so all runs see the same amount of folding.
+    struct FoldState
+    {
+        FoldState (FoldCascade::Curve curve, int num_stages, int factor)
+            : input (static_cast<size_t> (NUM_FRAMES * factor)),
+              samples (input.size()),
+              input_gains (NUM_FRAMES, INPUT_GAIN),
+              biases (NUM_FRAMES, 0.0f),
+              thresholds (NUM_FRAMES, THRESHOLD),
+              table (FoldCurves::Lookup::TABLE_SIZE + 2)
+        {
+            juce::Random random (0x5eed);
+            for (auto& sample : input)
+                sample = random.nextFloat() * 2.0f - 1.0f;
+
+            // Any table costs the same, this one is a sine over the range
+            for (size_t i = 0; i < table.size(); ++i)
+                table[i] = std::sin (juce::MathConstants<float>::twoPi * static_cast<float> (i) / FoldCurves::Lookup::TABLE_SIZE);
+
+            fold.setCustomTable (table.data());
+            fold.setStages (curve, num_stages, 0.8f, 1.3f);
+        }
+
+        std::vector<float> input;
+        std::vector<float> samples;
+        std::vector<float> input_gains;
+        std::vector<float> biases;
+        std::vector<float> thresholds;
+        std::vector<float> table;
+        FoldCascade fold;
+    };
+}
+
+std::vector<Benchmark> createFoldBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    for (int curve = 0; curve < FoldCascade::NUM_CURVES; ++curve)
+    {
+        for (int num_stages : { 1, 4, FoldCascade::MAX_STAGES })
+        {
+            for (int factor : { 1, 8 })
+            {
+                auto state = std::make_shared<FoldState> (static_cast<FoldCascade::Curve> (curve), num_stages, factor);
+
+                Benchmark benchmark;
+                benchmark.name = "fold/" + CURVE_NAMES[curve] + "/" + juce::String (num_stages) + " stages/" + juce::String (factor) + "x";
+                benchmark.samples_per_run = NUM_FRAMES * factor;
+                benchmark.run = [state, factor]
+                {
+                    const FoldCascade::Modulation modulation { state->input_gains.data(), state->biases.data(), state->thresholds.data() };
+
+                    std::copy (state->input.begin(), state->input.end(), state->samples.begin());
+                    state->fold.process (state->samples.data(), static_cast<int> (state->samples.size()), factor, modulation, 0);
+                };
+                benchmarks.push_back (std::move (benchmark));
+            }
+        }
+    }
+
+    return benchmarks;
+}
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <JuceHeader.h>
+#include <iostream>
+
+namespace
+{
+    // Benchmarks whose name contains the --filter text, all of them without a filter
+    std::vector<Benchmark> selectBenchmarks (const juce::ArgumentList& args)
+    {
+        const auto filter = args.getValueForOption ("--filter");
+        auto benchmarks = createAllBenchmarks();
+
+        benchmarks.erase (std::remove_if (benchmarks.begin(), benchmarks.end(), [&filter] (const Benchmark& benchmark)
+                                          { return ! benchmark.name.contains (filter); }),
+                          benchmarks.end());
+
+        if (benchmarks.empty())
+            juce::ConsoleApplication::fail ("No benchmark matches " + filter);
+
+        return benchmarks;
+    }
+
+    void runBenchmarks (const juce::ArgumentList& args)
+    {
+        double seconds = 0.5;
+        if (args.containsOption ("--seconds"))
+            seconds = args.getValueForOption ("--seconds").getDoubleValue();
+
+        if (seconds <= 0.0)
+            juce::ConsoleApplication::fail ("The time per benchmark must be positive");
+
+        for (const auto& benchmark : selectBenchmarks (args))
+            std::cout << measure (benchmark, seconds).toString() << std::endl;
+    }
+
+    void printFastMathTable (const juce::ArgumentList& args)
+    {
+        double seconds = 0.5;
+        if (args.containsOption ("--seconds"))
+            seconds = args.getValueForOption ("--seconds").getDoubleValue();
+
+        if (seconds <= 0.0)
+            juce::ConsoleApplication::fail ("The time per benchmark must be positive");
+
+        for (const auto& line : createFastMathTable (args.getValueForOption ("--filter"), seconds))
+            std::cout << line << std::endl;
+    }
+
+    void printOversamplingTable (const juce::ArgumentList& args)
+    {
+        double seconds = 0.5;
+        if (args.containsOption ("--seconds"))
+            seconds = args.getValueForOption ("--seconds").getDoubleValue();
+
+        if (seconds <= 0.0)
+            juce::ConsoleApplication::fail ("The time per benchmark must be positive");
+
+        for (const auto& line : createOversamplingTable (args.getValueForOption ("--filter"), seconds))
+            std::cout << line << std::endl;
+    }
+
+    void listBenchmarks (const juce::ArgumentList& args)
+    {
+        for (const auto& benchmark : selectBenchmarks (args))
+            std::cout << benchmark.name << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addHelpCommand ("--help|-h", "Times the DSP kernels of the plugins.", true);
+
+    app.addCommand ({ "run",
+                      "run [--filter=<text>] [--seconds=<time per benchmark>]",
+                      "Runs the benchmarks and prints the time per sample of each.",
+                      "Only benchmarks whose name contains the --filter text are run. Build in Release, a Debug build\n"
+                      "times unoptimised code.",
+                      runBenchmarks });
+
+    app.addCommand ({ "fastmath",
+                      "fastmath [--filter=<text>] [--seconds=<time per benchmark>]",
+                      "Prints the largest error and the time per sample of each fast math function, next to the\n"
+                      "std:: function it replaces.",
+                      "Only functions whose name contains the --filter text are measured, e.g. --filter=tanh.",
+                      printFastMathTable });
+
+    app.addCommand ({ "oversampling",
+                      "oversampling [--filter=<text>] [--seconds=<time per benchmark>]",
+                      "Prints the time per sample of Oversampler next to juce::dsp::Oversampling with the same\n"
+                      "stages, for each factor, filter type and channel count.",
+                      "Only configurations whose name contains the --filter text are measured, e.g. --filter=fir/4x.",
+                      printOversamplingTable });
+
+    app.addCommand ({ "list",
+                      "list [--filter=<text>]",
+                      "Lists the names of the benchmarks.",
+                      "",
+                      listBenchmarks });
+
+    return app.findAndRunCommand (argc, argv);
+}
@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    OversamplingBenchmarks.cpp
+    Created: 19 Oct 2026 9:41:23pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <Oversampler.h>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 512;
+
+    using JuceOversampling = juce::dsp::Oversampling<float>;
+
+    // The half-band stages of Oversampler, from the one next to the host rate inwards, as JUCE
+    // takes them. Transition widths are normalised to the higher rate of the stage, like the
+    // ones in HalfBandFilter.h. The IIR stages are the allpass designs of Oversampler (8 and 4
+    // coefficients), which JUCE designs from the same two numbers. The FIR stages are the
+    // 63 and 23 tap kernels of Oversampler, JUCE's equiripple design is given the stop band
+    // those kernels reach at that width, so it lands on about the same number of taps.
+    struct StageSpec
+    {
+        float transition_width;
+        float stop_band_db;
+    };
+
+    constexpr StageSpec IIR_OUTER { 0.05f, -106.0f };
+    constexpr StageSpec IIR_INNER { 0.2f, -100.0f };
+    constexpr StageSpec FIR_OUTER { 0.1f, -81.0f };
+    constexpr StageSpec FIR_INNER { 0.2f, -63.0f };
+
+    // One row of the table, a configuration timed through both oversamplers
+    struct Entry
+    {
+        juce::String name;
+        Benchmark oversampler;
+        Benchmark juce_oversampling;
+        float oversampler_latency = 0.0f;
+        float juce_latency = 0.0f;
+    };
+
+    juce::String getChannelsName (int num_channels)
+    {
+        if (num_channels == 1)
+            return "mono";
+        if (num_channels == 2)
+            return "stereo";
+        return juce::String (num_channels) + " channels";
+    }
+
+    // Noise on every channel, copied back before every run so both oversamplers see the same
+    // input and the filters never run on their own output
+    struct Signal
+    {
+        explicit Signal (int num_channels)
+            : input (num_channels, NUM_FRAMES),
+              buffer (num_channels, NUM_FRAMES)
+        {
+            juce::Random random (0x5eed);
+            for (int channel = 0; channel < num_channels; ++channel)
+            {
+                auto* samples = input.getWritePointer (channel);
+                for (int sample = 0; sample < NUM_FRAMES; ++sample)
+                    samples[sample] = random.nextFloat() * 2.0f - 1.0f;
+            }
+        }
+
+        void refill()
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                std::copy (input.getReadPointer (channel), input.getReadPointer (channel) + NUM_FRAMES, buffer.getWritePointer (channel));
+        }
+
+        juce::AudioBuffer<float> input;
+        juce::AudioBuffer<float> buffer;
+    };
+
+    // Only the resampling is timed, nothing runs at the higher rate
+    struct OversamplerRun
+    {
+        OversamplerRun (int num_channels, int factor, Oversampler::FilterType filter_type)
+            : signal (num_channels)
+        {
+            oversampler.prepare (num_channels, NUM_FRAMES, factor, filter_type);
+        }
+
+        void run()
+        {
+            signal.refill();
+            oversampler.process (signal.buffer, signal.buffer.getNumChannels(), [] (juce::dsp::AudioBlock<float>&, int) {});
+        }
+
+        Signal signal;
+        Oversampler oversampler;
+    };
+
+    struct JuceRun
+    {
+        JuceRun (int num_channels, int factor, Oversampler::FilterType filter_type)
+            : signal (num_channels),
+              oversampling (static_cast<size_t> (num_channels))
+        {
+            const bool iir = filter_type == Oversampler::FilterType::lowLatency;
+            const auto type = iir ? JuceOversampling::filterHalfBandPolyphaseIIR : JuceOversampling::filterHalfBandFIREquiripple;
+
+            for (int stage = 0; (1 << stage) < factor; ++stage)
+            {
+                const auto& spec = stage == 0 ? (iir ? IIR_OUTER : FIR_OUTER) : (iir ? IIR_INNER : FIR_INNER);
+                oversampling.addOversamplingStage (type, spec.transition_width, spec.stop_band_db, spec.transition_width, spec.stop_band_db);
+            }
+
+            oversampling.initProcessing (NUM_FRAMES);
+        }
+
+        void run()
+        {
+            signal.refill();
+            juce::dsp::AudioBlock<float> block (signal.buffer);
+            oversampling.processSamplesUp (block);
+            oversampling.processSamplesDown (block);
+        }
+
+        Signal signal;
+        JuceOversampling oversampling;
+    };
+
+    template <typename Run>
+    Benchmark makeBenchmark (const juce::String& name, int num_channels, std::shared_ptr<Run> run)
+    {
+        Benchmark benchmark;
+        benchmark.name = "oversampling/" + name;
+        benchmark.samples_per_run = NUM_FRAMES * num_channels;
+        benchmark.run = [run] { run->run(); };
+        return benchmark;
+    }
+
+    std::vector<Entry> createEntries()
+    {
+        std::vector<Entry> entries;
+
+        for (auto filter_type : { Oversampler::FilterType::lowLatency, Oversampler::FilterType::linearPhase })
+        {
+            for (int factor : { 2, 4, 8 })
+            {
+                for (int num_channels : { 1, 2, 8 })
+                {
+                    const auto oversampler = std::make_shared<OversamplerRun> (num_channels, factor, filter_type);
+                    const auto juce_oversampling = std::make_shared<JuceRun> (num_channels, factor, filter_type);
+
+                    Entry entry;
+                    entry.name = juce::String (filter_type == Oversampler::FilterType::lowLatency ? "iir" : "fir") + "/"
+                                 + juce::String (factor) + "x/" + getChannelsName (num_channels);
+                    entry.oversampler = makeBenchmark (entry.name + "/oversampler", num_channels, oversampler);
+                    entry.juce_oversampling = makeBenchmark (entry.name + "/juce", num_channels, juce_oversampling);
+                    entry.oversampler_latency = oversampler->oversampler.getLatencySamples();
+                    entry.juce_latency = static_cast<float> (juce_oversampling->oversampling.getLatencyInSamples());
+                    entries.push_back (std::move (entry));
+                }
+            }
+        }
+
+        return entries;
+    }
+}
+
+std::vector<Benchmark> createOversamplingBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    for (auto& entry : createEntries())
+    {
+        benchmarks.push_back (std::move (entry.oversampler));
+        benchmarks.push_back (std::move (entry.juce_oversampling));
+    }
+
+    return benchmarks;
+}
+
+juce::StringArray createOversamplingTable (const juce::String& filter, double min_seconds)
+{
+    juce::StringArray lines;
+    lines.add (juce::String ("configuration").paddedRight (' ', 24) + juce::String ("latency").paddedLeft (' ', 18)
+               + juce::String ("Oversampler").paddedLeft (' ', 14) + juce::String ("juce").paddedLeft (' ', 14)
+               + juce::String ("speed up").paddedLeft (' ', 10));
+
+    for (const auto& entry : createEntries())
+    {
+        if (! entry.name.contains (filter))
+            continue;
+
+        const double oversampler_ns = measure (entry.oversampler, min_seconds).ns_per_sample;
+        const double juce_ns = measure (entry.juce_oversampling, min_seconds).ns_per_sample;
+
+        auto line = entry.name.paddedRight (' ', 24);
+        line += (juce::String (entry.oversampler_latency, 1) + " / " + juce::String (entry.juce_latency, 1)).paddedLeft (' ', 18);
+        line += (juce::String (oversampler_ns, 3) + " ns").paddedLeft (' ', 14);
+        line += (juce::String (juce_ns, 3) + " ns").paddedLeft (' ', 14);
+        line += (juce::String (juce_ns / oversampler_ns, 2) + "x").paddedLeft (' ', 10);
+        lines.add (line);
+    }
+
+    return lines;
+}
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    PipelineBenchmarks.cpp
+    Created: 19 Oct 2026 1:26:44pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <EasyverbCore.h>
+#include <GramophonyCore.h>
+#include <WaveFolderCore.h>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 4096;
+    constexpr int NUM_CHANNELS = 2;
+    constexpr double SAMPLE_RATE = 48000.0;
+
+    // A core that gets the same noise in host blocks of block_size every run. With the
+    // stages fused on micro blocks the time per sample should hardly depend on block_size.
+    template <typename Core>
+    struct PipelineState
+    {
+        PipelineState (int block_size, int parameter, float value)
+            : block_size (block_size),
+              input (NUM_CHANNELS, std::vector<float> (NUM_FRAMES)),
+              channels (input)
+        {
+            juce::Random random (0x5eed);
+            for (auto& channel : input)
+            {
+                for (auto& sample : channel)
+                    sample = random.nextFloat() * 2.0f - 1.0f;
+            }
+
+            if (parameter >= 0)
+                core.setParameter (parameter, value);
+            core.prepare (SAMPLE_RATE, block_size, NUM_CHANNELS);
+        }
+
+        void run()
+        {
+            for (size_t channel = 0; channel < channels.size(); ++channel)
+                std::copy (input[channel].begin(), input[channel].end(), channels[channel].begin());
+
+            for (int first_sample = 0; first_sample < NUM_FRAMES; first_sample += block_size)
+            {
+                std::array<float*, NUM_CHANNELS> block {};
+                for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+                    block[static_cast<size_t> (channel)] = channels[static_cast<size_t> (channel)].data() + first_sample;
+
+                core.process (block.data(), NUM_CHANNELS, juce::jmin (block_size, NUM_FRAMES - first_sample));
+            }
+        }
+
+        const int block_size;
+        std::vector<std::vector<float>> input;
+        std::vector<std::vector<float>> channels;
+        Core core;
+    };
+
+    template <typename Core>
+    void addBenchmarks (std::vector<Benchmark>& benchmarks, const juce::String& name, int parameter = -1, float value = 0.0f)
+    {
+        for (int block_size : { 64, 512, 4096 })
+        {
+            auto state = std::make_shared<PipelineState<Core>> (block_size, parameter, value);
+
+            Benchmark benchmark;
+            benchmark.name = "pipeline/" + name + "/" + juce::String (block_size) + " block";
+            benchmark.samples_per_run = NUM_FRAMES;
+            benchmark.run = [state] { state->run(); };
+            benchmarks.push_back (std::move (benchmark));
+        }
+    }
+}
+
+std::vector<Benchmark> createPipelineBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    addBenchmarks<EasyverbCore> (benchmarks, "easyverb");
+    // At 4x oversampling, where a whole host block falls out of L1 the soonest
+    addBenchmarks<GramophonyCore> (benchmarks, "gramophony 4x", GramophonyCore::OVERSAMPLING, 2.0f);
+    addBenchmarks<WaveFolderCore> (benchmarks, "wavefolder 4x", WaveFolderCore::OVERSAMPLING, 2.0f);
+
+    return benchmarks;
+}
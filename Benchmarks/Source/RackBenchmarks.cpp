@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    RackBenchmarks.cpp
+    Created: 19 Oct 2026 2:58:06pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+#include <RackCore.h>
+
+namespace
+{
+    constexpr int NUM_FRAMES = 4096;
+    constexpr int NUM_CHANNELS = 2;
+    constexpr double SAMPLE_RATE = 48000.0;
+
+    // Gramophony, WaveFolder and Easyverb on the same noise in host blocks of block_size, at
+    // 4x oversampling. Separate runs each core through the whole host block before the next,
+    // the way three plugins on a track run their DSP; the rack hands every micro block through
+    // all three. Only the cores are timed, `EditorBenchmarks rack` times the real plugins.
+    struct RackState
+    {
+        explicit RackState (int block_size)
+            : block_size (block_size),
+              input (NUM_CHANNELS, std::vector<float> (NUM_FRAMES)),
+              channels (input)
+        {
+            juce::Random random (0x5eed);
+            for (auto& channel : input)
+            {
+                for (auto& sample : channel)
+                    sample = random.nextFloat() * 2.0f - 1.0f;
+            }
+
+            gramophony.setParameter (GramophonyCore::OVERSAMPLING, 2.0f);
+            wavefolder.setParameter (WaveFolderCore::OVERSAMPLING, 2.0f);
+            rack.setParameter (RackCore::getFirstParameter (RackCore::GRAMOPHONY) + GramophonyCore::OVERSAMPLING, 2.0f);
+            rack.setParameter (RackCore::getFirstParameter (RackCore::WAVEFOLDER) + WaveFolderCore::OVERSAMPLING, 2.0f);
+
+            gramophony.prepare (SAMPLE_RATE, block_size, NUM_CHANNELS);
+            wavefolder.prepare (SAMPLE_RATE, block_size, NUM_CHANNELS);
+            easyverb.prepare (SAMPLE_RATE, block_size, NUM_CHANNELS);
+            rack.prepare (SAMPLE_RATE, block_size, NUM_CHANNELS);
+        }
+
+        template <typename Function>
+        void run (Function&& process_block)
+        {
+            for (size_t channel = 0; channel < channels.size(); ++channel)
+                std::copy (input[channel].begin(), input[channel].end(), channels[channel].begin());
+
+            for (int first_sample = 0; first_sample < NUM_FRAMES; first_sample += block_size)
+            {
+                std::array<float*, NUM_CHANNELS> block {};
+                for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+                    block[static_cast<size_t> (channel)] = channels[static_cast<size_t> (channel)].data() + first_sample;
+
+                process_block (block.data(), juce::jmin (block_size, NUM_FRAMES - first_sample));
+            }
+        }
+
+        const int block_size;
+        std::vector<std::vector<float>> input;
+        std::vector<std::vector<float>> channels;
+        GramophonyCore gramophony;
+        WaveFolderCore wavefolder;
+        EasyverbCore easyverb;
+        RackCore rack;
+    };
+}
+
+std::vector<Benchmark> createRackBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    for (int block_size : { 512, 4096 })
+    {
+        auto state = std::make_shared<RackState> (block_size);
+
+        Benchmark separate;
+        separate.name = "rack/separate/" + juce::String (block_size) + " block";
+        separate.samples_per_run = NUM_FRAMES;
+        separate.run = [state]
+        {
+            state->run ([&] (float* const* block, int num_samples) {
+                state->gramophony.process (block, NUM_CHANNELS, num_samples);
+                state->wavefolder.process (block, NUM_CHANNELS, num_samples);
+                state->easyverb.process (block, NUM_CHANNELS, num_samples);
+            });
+        };
+        benchmarks.push_back (std::move (separate));
+
+        Benchmark rack;
+        rack.name = "rack/rack/" + juce::String (block_size) + " block";
+        rack.samples_per_run = NUM_FRAMES;
+        rack.run = [state]
+        {
+            state->run ([&] (float* const* block, int num_samples) {
+                state->rack.process (block, NUM_CHANNELS, num_samples);
+            });
+        };
+        benchmarks.push_back (std::move (rack));
+    }
+
+    return benchmarks;
+}
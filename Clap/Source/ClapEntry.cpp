@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    ClapEntry.cpp
+    Created: 19 Oct 2026 11:05:31am
+
+  ==============================================================================
+*/
+
+#include "ClapPlugin.h"
+
+namespace
+{
+    const char* const EASYVERB_FEATURES[] = { CLAP_PLUGIN_FEATURE_AUDIO_EFFECT, CLAP_PLUGIN_FEATURE_REVERB, CLAP_PLUGIN_FEATURE_STEREO, nullptr };
+    const char* const GRAMOPHONY_FEATURES[] = { CLAP_PLUGIN_FEATURE_AUDIO_EFFECT, CLAP_PLUGIN_FEATURE_DISTORTION, CLAP_PLUGIN_FEATURE_FILTER, CLAP_PLUGIN_FEATURE_STEREO, nullptr };
+    const char* const WAVEFOLDER_FEATURES[] = { CLAP_PLUGIN_FEATURE_AUDIO_EFFECT, CLAP_PLUGIN_FEATURE_DISTORTION, CLAP_PLUGIN_FEATURE_STEREO, nullptr };
+
+    // Ids, names and versions follow the VST3 plugins, see their jucer files
+    const clap_plugin_descriptor DESCRIPTORS[] = {
+        { CLAP_VERSION_INIT, "com.martinheterjag.easyverb", "Easyverb", "Martinheterjag", "https://martinheterjag.com", "", "", "1.0.0", "Easy to use reverb", EASYVERB_FEATURES },
+        { CLAP_VERSION_INIT, "com.martinheterjag.gramophony", "Gramophony", "Martinheterjag", "https://martinheterjag.com", "", "", "1.0.2", "Old gramophone sound", GRAMOPHONY_FEATURES },
+        { CLAP_VERSION_INIT, "com.martinheterjag.wavefolder", "WaveFolder", "Martinheterjag", "https://martinheterjag.com", "", "", "1.0.1", "Wave folding distortion", WAVEFOLDER_FEATURES },
+    };
+    const DspCoreType TYPES[] = { DSPCORE_EASYVERB, DSPCORE_GRAMOPHONY, DSPCORE_WAVEFOLDER };
+
+    uint32_t getPluginCount (const clap_plugin_factory* /*factory*/)
+    {
+        return static_cast<uint32_t> (std::size (DESCRIPTORS));
+    }
+
+    const clap_plugin_descriptor* getPluginDescriptor (const clap_plugin_factory* /*factory*/, uint32_t index)
+    {
+        return index < std::size (DESCRIPTORS) ? &DESCRIPTORS[index] : nullptr;
+    }
+
+    const clap_plugin* createPlugin (const clap_plugin_factory* /*factory*/, const clap_host* host, const char* plugin_id)
+    {
+        if (! clap_version_is_compatible (host->clap_version))
+            return nullptr;
+
+        for (size_t index = 0; index < std::size (DESCRIPTORS); ++index)
+        {
+            if (std::strcmp (DESCRIPTORS[index].id, plugin_id) == 0)
+                return (new ClapPlugin (&DESCRIPTORS[index], host, TYPES[index]))->getPlugin();
+        }
+        return nullptr;
+    }
+
+    const clap_plugin_factory FACTORY { getPluginCount, getPluginDescriptor, createPlugin };
+}
+
+extern "C"
+{
+    CLAP_EXPORT const clap_plugin_entry clap_entry {
+        CLAP_VERSION_INIT,
+        [] (const char* /*plugin_path*/) { return true; },
+        [] () {},
+        [] (const char* factory_id) -> const void* {
+            return std::strcmp (factory_id, CLAP_PLUGIN_FACTORY_ID) == 0 ? &FACTORY : nullptr;
+        },
+    };
+}
@@ -0,0 +1,454 @@
+/*
+  ==============================================================================
+
+    ClapPlugin.cpp
+    Created: 19 Oct 2026 11:05:31am
+
+  ==============================================================================
+*/
+
+#include "ClapPlugin.h"
+
+const ClapPlugin::PortsConfig ClapPlugin::PORTS_CONFIGS[] = {
+    { "Mono", 1, CLAP_PORT_MONO },
+    { "Stereo", 2, CLAP_PORT_STEREO },
+    { "Quad", 4, nullptr },
+    { "5.1", 6, nullptr },
+    { "7.1", 8, nullptr },
+    { "7.1.4", 12, nullptr },
+};
+
+ClapPlugin::ClapPlugin (const clap_plugin_descriptor* descriptor, const clap_host* host, DspCoreType type)
+    : host_ (host), type_ (type)
+{
+    plugin_.desc = descriptor;
+    plugin_.plugin_data = this;
+    plugin_.init = [] (const clap_plugin* plugin) { return get (plugin).init(); };
+    plugin_.destroy = [] (const clap_plugin* plugin) { delete &get (plugin); };
+    plugin_.activate = [] (const clap_plugin* plugin, double sample_rate, uint32_t /*min_frames*/, uint32_t max_frames) { return get (plugin).activate (sample_rate, static_cast<int> (max_frames)); };
+    plugin_.deactivate = [] (const clap_plugin* plugin) { get (plugin).deactivate(); };
+    plugin_.start_processing = [] (const clap_plugin* /*plugin*/) { return true; };
+    plugin_.stop_processing = [] (const clap_plugin* /*plugin*/) {};
+    plugin_.reset = [] (const clap_plugin* plugin) {
+        for (auto& core : get (plugin).cores_)
+            dspcore_reset (core.get());
+    };
+    plugin_.process = [] (const clap_plugin* plugin, const clap_process* process) { return get (plugin).process (process); };
+    plugin_.get_extension = [] (const clap_plugin* plugin, const char* id) { return get (plugin).getExtension (id); };
+    plugin_.on_main_thread = [] (const clap_plugin* /*plugin*/) {};
+}
+
+bool ClapPlugin::init()
+{
+    info_core_.reset (dspcore_create (type_));
+    if (info_core_ == nullptr)
+        return false;
+
+    const int num_parameters = getNumParameters();
+    values_.reset (new std::atomic<float>[static_cast<size_t> (num_parameters)]);
+    for (int index = 0; index < num_parameters; ++index)
+        values_[static_cast<size_t> (index)] = dspcore_get_parameter (info_core_.get(), index);
+
+    prepared_values_.resize (static_cast<size_t> (num_parameters));
+    events_.resize (MAX_EVENTS);
+
+    // Extensions of the host may only be asked for from here on
+    host_latency_ = static_cast<const clap_host_latency*> (host_->get_extension (host_, CLAP_EXT_LATENCY));
+    host_params_ = static_cast<const clap_host_params*> (host_->get_extension (host_, CLAP_EXT_PARAMS));
+    host_thread_pool_ = static_cast<const clap_host_thread_pool*> (host_->get_extension (host_, CLAP_EXT_THREAD_POOL));
+    return true;
+}
+
+bool ClapPlugin::activate (double sample_rate, int max_block_size)
+{
+    const int num_parameters = getNumParameters();
+    const int num_groups = (num_channels_ + CHANNELS_PER_GROUP - 1) / CHANNELS_PER_GROUP;
+
+    for (int index = 0; index < num_parameters; ++index)
+        prepared_values_[static_cast<size_t> (index)] = values_[static_cast<size_t> (index)].load();
+
+    cores_.clear();
+    for (int group = 0; group < num_groups; ++group)
+    {
+        Core core (dspcore_create (type_));
+        const int group_channels = juce::jmin (CHANNELS_PER_GROUP, num_channels_ - group * CHANNELS_PER_GROUP);
+
+        if (core == nullptr)
+            return false;
+
+        for (int index = 0; index < num_parameters; ++index)
+            dspcore_set_parameter (core.get(), index, prepared_values_[static_cast<size_t> (index)]);
+        dspcore_set_first_channel (core.get(), group * CHANNELS_PER_GROUP);
+
+        if (dspcore_prepare (core.get(), sample_rate, max_block_size, group_channels) != 0)
+        {
+            cores_.clear();
+            return false;
+        }
+        cores_.push_back (std::move (core));
+    }
+
+    values_changed_ = false;
+    restart_requested_ = false;
+
+    // The host only takes a new latency while the plugin is being activated
+    const int latency = dspcore_get_latency_samples (cores_.front().get());
+    if (latency != latency_)
+    {
+        latency_ = latency;
+        if (host_latency_ != nullptr)
+            host_latency_->changed (host_);
+    }
+    return true;
+}
+
+void ClapPlugin::deactivate()
+{
+    cores_.clear();
+}
+
+clap_process_status ClapPlugin::process (const clap_process* process)
+{
+    if (process->audio_inputs_count == 0 || process->audio_outputs_count == 0)
+        return CLAP_PROCESS_CONTINUE;
+
+    juce::ScopedNoDenormals no_denormals;
+
+    if (values_changed_.exchange (false))
+        applyValues();
+
+    const auto& input = process->audio_inputs[0];
+    const auto& output = process->audio_outputs[0];
+    const int num_channels = juce::jmin (num_channels_, static_cast<int> (input.channel_count), static_cast<int> (output.channel_count));
+    const int num_samples = static_cast<int> (process->frames_count);
+
+    for (int channel = 0; channel < num_channels; ++channel)
+    {
+        if (output.data32[channel] != input.data32[channel])
+            std::copy (input.data32[channel], input.data32[channel] + num_samples, output.data32[channel]);
+    }
+
+    // The events come sorted by time, the cores apply them at their samples
+    num_events_ = 0;
+    const auto num_input_events = process->in_events->size (process->in_events);
+
+    for (uint32_t i = 0; i < num_input_events; ++i)
+    {
+        DspCoreParameterEvent event;
+        if (! readParameterEvent (process->in_events->get (process->in_events, i), event))
+            continue;
+
+        if (num_events_ < MAX_EVENTS)
+        {
+            events_[static_cast<size_t> (num_events_++)] = event;
+            values_[static_cast<size_t> (event.index)] = event.value;
+        }
+        else
+        {
+            setValue (event.index, event.value);
+        }
+
+        // Quality settings need the cores prepared again
+        if ((dspcore_get_parameter_flags (info_core_.get(), event.index) & DSPCORE_PARAMETER_NEEDS_PREPARE) != 0
+            && event.value != prepared_values_[static_cast<size_t> (event.index)] && ! restart_requested_)
+        {
+            host_->request_restart (host_);
+            restart_requested_ = true;
+        }
+    }
+
+    block_channels_ = output.data32;
+    block_num_channels_ = num_channels;
+    block_samples_ = num_samples;
+
+    // One task per group, the host runs them on its workers and returns when all are done
+    const int num_groups = static_cast<int> (cores_.size());
+    if (num_groups < 2 || host_thread_pool_ == nullptr || ! host_thread_pool_->request_exec (host_, static_cast<uint32_t> (num_groups)))
+    {
+        for (int group = 0; group < num_groups; ++group)
+            processGroup (group);
+    }
+    return CLAP_PROCESS_CONTINUE;
+}
+
+void ClapPlugin::processGroup (int group)
+{
+    const int first_channel = group * CHANNELS_PER_GROUP;
+    const int group_channels = juce::jmin (CHANNELS_PER_GROUP, block_num_channels_ - first_channel);
+
+    if (group_channels > 0)
+        dspcore_process_events (cores_[static_cast<size_t> (group)].get(), block_channels_ + first_channel, group_channels, block_samples_, events_.data(), num_events_);
+}
+
+void ClapPlugin::applyValues()
+{
+    for (int index = 0; index < getNumParameters(); ++index)
+    {
+        const float value = values_[static_cast<size_t> (index)].load();
+
+        for (auto& core : cores_)
+            dspcore_set_parameter (core.get(), index, value);
+
+        if ((dspcore_get_parameter_flags (info_core_.get(), index) & DSPCORE_PARAMETER_NEEDS_PREPARE) != 0
+            && value != prepared_values_[static_cast<size_t> (index)] && ! restart_requested_)
+        {
+            host_->request_restart (host_);
+            restart_requested_ = true;
+        }
+    }
+}
+
+bool ClapPlugin::readParameterEvent (const clap_event_header* header, DspCoreParameterEvent& event) const
+{
+    if (header->space_id != CLAP_CORE_EVENT_SPACE_ID || header->type != CLAP_EVENT_PARAM_VALUE)
+        return false;
+
+    const auto* parameter = reinterpret_cast<const clap_event_param_value*> (header);
+    if (parameter->param_id >= static_cast<clap_id> (getNumParameters()))
+        return false;
+
+    event.sample_offset = static_cast<int> (header->time);
+    event.index = static_cast<int> (parameter->param_id);
+    // The cores and the stored values get the same range, whichever path the event takes
+    event.value = clampValue (event.index, static_cast<float> (parameter->value));
+    return true;
+}
+
+float ClapPlugin::clampValue (int index, float value) const
+{
+    DspCoreParameterInfo info;
+    if (dspcore_get_parameter_info (info_core_.get(), index, &info) != 0)
+        return value;
+
+    return juce::jlimit (info.min_value, info.max_value, value);
+}
+
+void ClapPlugin::setValue (int index, float value)
+{
+    if (! juce::isPositiveAndBelow (index, getNumParameters()))
+        return;
+
+    values_[static_cast<size_t> (index)] = clampValue (index, value);
+    values_changed_ = true;
+}
+
+const void* ClapPlugin::getExtension (const char* id) const
+{
+    static const clap_plugin_audio_ports audio_ports { getNumAudioPorts, getAudioPortInfo };
+    static const clap_plugin_audio_ports_config ports_config { getNumPortsConfigs, getPortsConfig, selectPortsConfig };
+    static const clap_plugin_params params { getNumParameters, getParameterInfo, getParameterValue, parameterValueToText, parameterTextToValue, flushParameters };
+    static const clap_plugin_latency latency { getLatency };
+    static const clap_plugin_state state { saveState, loadState };
+    static const clap_plugin_thread_pool thread_pool { execTask };
+
+    if (std::strcmp (id, CLAP_EXT_AUDIO_PORTS) == 0)
+        return &audio_ports;
+    if (std::strcmp (id, CLAP_EXT_AUDIO_PORTS_CONFIG) == 0)
+        return &ports_config;
+    if (std::strcmp (id, CLAP_EXT_PARAMS) == 0)
+        return &params;
+    if (std::strcmp (id, CLAP_EXT_LATENCY) == 0)
+        return &latency;
+    if (std::strcmp (id, CLAP_EXT_STATE) == 0)
+        return &state;
+    if (std::strcmp (id, CLAP_EXT_THREAD_POOL) == 0)
+        return &thread_pool;
+    return nullptr;
+}
+
+//==============================================================================
+uint32_t ClapPlugin::getNumAudioPorts (const clap_plugin* /*plugin*/, bool /*is_input*/)
+{
+    return 1;
+}
+
+bool ClapPlugin::getAudioPortInfo (const clap_plugin* plugin, uint32_t index, bool /*is_input*/, clap_audio_port_info* info)
+{
+    if (index != 0)
+        return false;
+
+    const int num_channels = get (plugin).num_channels_;
+    info->id = 0;
+    std::strcpy (info->name, "Main");
+    info->flags = CLAP_AUDIO_PORT_IS_MAIN;
+    info->channel_count = static_cast<uint32_t> (num_channels);
+    info->port_type = num_channels == 1 ? CLAP_PORT_MONO : (num_channels == 2 ? CLAP_PORT_STEREO : nullptr);
+    // Processed in place, the input and the output may share their buffers
+    info->in_place_pair = 0;
+    return true;
+}
+
+uint32_t ClapPlugin::getNumPortsConfigs (const clap_plugin* /*plugin*/)
+{
+    return static_cast<uint32_t> (std::size (PORTS_CONFIGS));
+}
+
+bool ClapPlugin::getPortsConfig (const clap_plugin* /*plugin*/, uint32_t index, clap_audio_ports_config* config)
+{
+    if (index >= std::size (PORTS_CONFIGS))
+        return false;
+
+    const auto& ports = PORTS_CONFIGS[index];
+    config->id = index;
+    juce::String (ports.name).copyToUTF8 (config->name, CLAP_NAME_SIZE);
+    config->input_port_count = 1;
+    config->output_port_count = 1;
+    config->has_main_input = true;
+    config->main_input_channel_count = static_cast<uint32_t> (ports.num_channels);
+    config->main_input_port_type = ports.port_type;
+    config->has_main_output = true;
+    config->main_output_channel_count = static_cast<uint32_t> (ports.num_channels);
+    config->main_output_port_type = ports.port_type;
+    return true;
+}
+
+bool ClapPlugin::selectPortsConfig (const clap_plugin* plugin, clap_id config_id)
+{
+    // Only while deactivated, the groups are set up in activate()
+    auto& self = get (plugin);
+    if (config_id >= std::size (PORTS_CONFIGS) || ! self.cores_.empty())
+        return false;
+
+    self.num_channels_ = PORTS_CONFIGS[config_id].num_channels;
+    return true;
+}
+
+uint32_t ClapPlugin::getNumParameters (const clap_plugin* plugin)
+{
+    return static_cast<uint32_t> (get (plugin).getNumParameters());
+}
+
+bool ClapPlugin::getParameterInfo (const clap_plugin* plugin, uint32_t index, clap_param_info* info)
+{
+    const auto& self = get (plugin);
+    DspCoreParameterInfo parameter;
+
+    if (dspcore_get_parameter_info (self.info_core_.get(), static_cast<int> (index), &parameter) != 0)
+        return false;
+
+    // Quality settings restart the plugin, so they are not automatable
+    const int flags = dspcore_get_parameter_flags (self.info_core_.get(), static_cast<int> (index));
+    info->id = index;
+    info->flags = ((flags & DSPCORE_PARAMETER_NEEDS_PREPARE) != 0 ? 0 : CLAP_PARAM_IS_AUTOMATABLE)
+                  | ((flags & DSPCORE_PARAMETER_STEPPED) != 0 ? CLAP_PARAM_IS_STEPPED : 0);
+    info->cookie = nullptr;
+    juce::String (parameter.name).copyToUTF8 (info->name, CLAP_NAME_SIZE);
+    info->module[0] = '\0';
+    info->min_value = parameter.min_value;
+    info->max_value = parameter.max_value;
+    info->default_value = parameter.default_value;
+    return true;
+}
+
+bool ClapPlugin::getParameterValue (const clap_plugin* plugin, clap_id id, double* value)
+{
+    const auto& self = get (plugin);
+    if (id >= static_cast<clap_id> (self.getNumParameters()))
+        return false;
+
+    *value = self.values_[id].load();
+    return true;
+}
+
+bool ClapPlugin::parameterValueToText (const clap_plugin* plugin, clap_id id, double value, char* text, uint32_t capacity)
+{
+    const auto& self = get (plugin);
+    if (id >= static_cast<clap_id> (self.getNumParameters()))
+        return false;
+
+    const bool stepped = (dspcore_get_parameter_flags (self.info_core_.get(), static_cast<int> (id)) & DSPCORE_PARAMETER_STEPPED) != 0;
+    const auto string = stepped ? juce::String (juce::roundToInt (value)) : juce::String (value, 3);
+    string.copyToUTF8 (text, capacity);
+    return true;
+}
+
+bool ClapPlugin::parameterTextToValue (const clap_plugin* plugin, clap_id id, const char* text, double* value)
+{
+    if (id >= static_cast<clap_id> (get (plugin).getNumParameters()))
+        return false;
+
+    *value = juce::String (juce::CharPointer_UTF8 (text)).getDoubleValue();
+    return true;
+}
+
+void ClapPlugin::flushParameters (const clap_plugin* plugin, const clap_input_events* in, const clap_output_events* /*out*/)
+{
+    auto& self = get (plugin);
+    const auto num_events = in->size (in);
+
+    // Not processing, the next block or activation hands the values to the cores
+    for (uint32_t i = 0; i < num_events; ++i)
+    {
+        DspCoreParameterEvent event;
+        if (self.readParameterEvent (in->get (in, i), event))
+            self.setValue (event.index, event.value);
+    }
+}
+
+uint32_t ClapPlugin::getLatency (const clap_plugin* plugin)
+{
+    return static_cast<uint32_t> (get (plugin).latency_);
+}
+
+bool ClapPlugin::saveState (const clap_plugin* plugin, const clap_ostream* stream)
+{
+    const auto& self = get (plugin);
+    juce::String state;
+
+    // One "ID value" line per parameter, by id so parameters can be added later
+    for (int index = 0; index < self.getNumParameters(); ++index)
+    {
+        DspCoreParameterInfo info;
+        dspcore_get_parameter_info (self.info_core_.get(), index, &info);
+        state << info.id << " " << juce::String (self.values_[static_cast<size_t> (index)].load()) << "\n";
+    }
+
+    const auto* data = state.toRawUTF8();
+    const auto num_bytes = static_cast<juce::int64> (state.getNumBytesAsUTF8());
+
+    for (juce::int64 written = 0; written < num_bytes;)
+    {
+        const auto result = stream->write (stream, data + written, static_cast<uint64_t> (num_bytes - written));
+        if (result <= 0)
+            return false;
+        written += result;
+    }
+    return true;
+}
+
+bool ClapPlugin::loadState (const clap_plugin* plugin, const clap_istream* stream)
+{
+    auto& self = get (plugin);
+    juce::MemoryOutputStream state;
+    char buffer[4096];
+
+    for (;;)
+    {
+        const auto result = stream->read (stream, buffer, sizeof (buffer));
+        if (result < 0)
+            return false;
+        if (result == 0)
+            break;
+        state.write (buffer, static_cast<size_t> (result));
+    }
+
+    juce::StringArray lines;
+    lines.addLines (state.toString());
+
+    // Ids this version does not know are skipped, missing ones keep their value
+    for (const auto& line : lines)
+    {
+        const int index = dspcore_find_parameter (self.info_core_.get(), line.upToFirstOccurrenceOf (" ", false, false).toRawUTF8());
+        if (index >= 0)
+            self.setValue (index, line.fromFirstOccurrenceOf (" ", false, false).getFloatValue());
+    }
+
+    if (self.host_params_ != nullptr)
+        self.host_params_->rescan (self.host_, CLAP_PARAM_RESCAN_VALUES);
+    return true;
+}
+
+void ClapPlugin::execTask (const clap_plugin* plugin, uint32_t task_index)
+{
+    get (plugin).processGroup (static_cast<int> (task_index));
+}
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    ClapPlugin.h
+    Created: 19 Oct 2026 11:05:31am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <DspCore.h>
+#include <JuceHeader.h>
+#include <clap/clap.h>
+
+// One CLAP plugin instance running a DSP core of the DspCore library, without editor.
+//
+// Parameter events are applied at their exact sample by splitting the block there, see
+// dspcore_process_events(). The channels are processed in groups of CHANNELS_PER_GROUP with
+// one core each, and when the host offers its thread pool the groups of a block run on the
+// host's workers instead of one after another. The cores of all groups get the same events,
+// so their LFOs and smoothers stay in step.
+//
+// Quality parameters (oversampling, eco, precision) need the cores to be prepared again, a
+// change asks the host to restart the plugin. Parameter values are the plain values of the
+// cores, the state is a list of parameter ids and values.
+class ClapPlugin
+{
+public:
+    ClapPlugin (const clap_plugin_descriptor* descriptor, const clap_host* host, DspCoreType type);
+
+    const clap_plugin* getPlugin() const { return &plugin_; }
+
+private:
+    static constexpr int CHANNELS_PER_GROUP = 4;
+    // Parameter events per block that are applied at their sample, later ones apply at the
+    // end of the block
+    static constexpr int MAX_EVENTS = 1024;
+
+    struct CoreDeleter
+    {
+        void operator() (DspCore* core) const { dspcore_destroy (core); }
+    };
+    typedef std::unique_ptr<DspCore, CoreDeleter> Core;
+
+    struct PortsConfig
+    {
+        const char* name;
+        int num_channels;
+        const char* port_type;
+    };
+    static const PortsConfig PORTS_CONFIGS[];
+
+    static ClapPlugin& get (const clap_plugin* plugin) { return *static_cast<ClapPlugin*> (plugin->plugin_data); }
+
+    bool init();
+    bool activate (double sample_rate, int max_block_size);
+    void deactivate();
+    clap_process_status process (const clap_process* process);
+    const void* getExtension (const char* id) const;
+
+    // Audio thread: runs the cores of a group through the current block
+    void processGroup (int group);
+    // Audio thread: gives the cores the values changed on the main thread
+    void applyValues();
+    // Stores the value of a parameter event, clamped to its range, false for anything else
+    bool readParameterEvent (const clap_event_header* header, DspCoreParameterEvent& event) const;
+    float clampValue (int index, float value) const;
+    void setValue (int index, float value);
+    int getNumParameters() const { return dspcore_get_num_parameters (info_core_.get()); }
+
+    // Extensions
+    static uint32_t getNumAudioPorts (const clap_plugin* plugin, bool is_input);
+    static bool getAudioPortInfo (const clap_plugin* plugin, uint32_t index, bool is_input, clap_audio_port_info* info);
+    static uint32_t getNumPortsConfigs (const clap_plugin* plugin);
+    static bool getPortsConfig (const clap_plugin* plugin, uint32_t index, clap_audio_ports_config* config);
+    static bool selectPortsConfig (const clap_plugin* plugin, clap_id config_id);
+    static uint32_t getNumParameters (const clap_plugin* plugin);
+    static bool getParameterInfo (const clap_plugin* plugin, uint32_t index, clap_param_info* info);
+    static bool getParameterValue (const clap_plugin* plugin, clap_id id, double* value);
+    static bool parameterValueToText (const clap_plugin* plugin, clap_id id, double value, char* text, uint32_t capacity);
+    static bool parameterTextToValue (const clap_plugin* plugin, clap_id id, const char* text, double* value);
+    static void flushParameters (const clap_plugin* plugin, const clap_input_events* in, const clap_output_events* out);
+    static uint32_t getLatency (const clap_plugin* plugin);
+    static bool saveState (const clap_plugin* plugin, const clap_ostream* stream);
+    static bool loadState (const clap_plugin* plugin, const clap_istream* stream);
+    static void execTask (const clap_plugin* plugin, uint32_t task_index);
+
+    clap_plugin plugin_;
+    const clap_host* host_;
+    const clap_host_latency* host_latency_ = nullptr;
+    const clap_host_params* host_params_ = nullptr;
+    const clap_host_thread_pool* host_thread_pool_ = nullptr;
+    const DspCoreType type_;
+
+    // Answers parameter queries while no group is prepared
+    Core info_core_;
+    std::vector<Core> cores_;
+    int num_channels_ = 2;
+    int latency_ = 0;
+
+    // Plain values as the host last set them, read and written on any thread
+    std::unique_ptr<std::atomic<float>[]> values_;
+    std::atomic<bool> values_changed_ { false };
+    // Values of the quality parameters the cores were prepared with
+    std::vector<float> prepared_values_;
+    bool restart_requested_ = false;
+
+    // The block being processed, for the groups on the host's workers
+    std::vector<DspCoreParameterEvent> events_;
+    int num_events_ = 0;
+    float* const* block_channels_ = nullptr;
+    int block_num_channels_ = 0;
+    int block_samples_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (ClapPlugin)
+};
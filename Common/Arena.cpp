@@ -0,0 +1,14 @@
+#include "Arena.h"
+
+void Arena::prepare (size_t num_bytes)
+{
+    if (num_bytes > capacity_)
+    {
+        // Over allocate by one cache line so the start can be aligned by hand
+        memory_.allocate (num_bytes + ALIGNMENT, false);
+        const auto address = reinterpret_cast<std::uintptr_t> (memory_.get());
+        start_ = memory_.get() + ((ALIGNMENT - address % ALIGNMENT) % ALIGNMENT);
+        capacity_ = num_bytes;
+    }
+    used_ = 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// One contiguous block of memory that a processor carves all of its buffers out of.
+//
+// Every carved buffer starts on a cache line. A processor works out the bytes it needs with
+// getRequiredBytes(), prepares the arena once with the total and then allocates its buffers
+// in the order the audio thread touches them. Preparing again forgets every earlier buffer
+// and only reallocates when more memory is needed than before.
+//
+// Carving clears every buffer, which also has the system back all of its pages. Prepare and
+// carve off the audio thread, so it never takes the page faults.
+class Arena
+{
+public:
+    static constexpr size_t ALIGNMENT = 64;
+
+    template <typename T>
+    static size_t getRequiredBytes (size_t count)
+    {
+        return (count * sizeof (T) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+    void prepare (size_t num_bytes);
+
+    // Returns count zeroed values, the arena must have been prepared with room for them
+    template <typename T>
+    T* allocate (size_t count);
+
+    size_t getCapacity() const { return capacity_; }
+    size_t getUsedBytes() const { return used_; }
+
+private:
+    juce::HeapBlock<char> memory_;
+    char* start_ = nullptr;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+};
+
+template <typename T>
+T* Arena::allocate (size_t count)
+{
+    static_assert (std::is_trivially_copyable<T>::value, "Arena memory is never constructed or destroyed");
+    static_assert (alignof (T) <= ALIGNMENT, "Arena buffers are aligned to cache lines only");
+
+    const auto num_bytes = getRequiredBytes<T> (count);
+    jassert (used_ + num_bytes <= capacity_);
+
+    auto* result = start_ + used_;
+    std::memset (result, 0, num_bytes);
+    used_ += num_bytes;
+    return reinterpret_cast<T*> (result);
+}
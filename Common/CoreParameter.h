@@ -0,0 +1,20 @@
+#pragma once
+
+// Id, range and default of one parameter of a DSP core. The plugin builds its
+// AudioProcessorValueTreeState from the table, see CoreParameterLayout, choices are indexes
+// from 0. Plain C data, so the table can be handed out through the C interface of the core
+// library as it is.
+struct CoreParameter
+{
+    const char* id;
+    const char* name;
+    float min_value;
+    float max_value;
+    float default_value;
+    // Choices and counts, only whole numbers are meaningful
+    bool is_stepped = false;
+    // Quality settings that take effect at the next prepare()
+    bool needs_prepare = false;
+    // Names of the choices from 0 to max_value separated by '|', null for other parameters
+    const char* choices = nullptr;
+};
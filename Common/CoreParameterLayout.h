@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreParameter.h"
+#include <JuceHeader.h>
+
+// The AudioProcessorValueTreeState parameters of a core's PARAMETERS table, so a plugin and
+// its core can never disagree on an id, a range or a default. Parameters with choice names
+// become choices, other stepped ones counts and the rest continuous floats.
+namespace CoreParameterLayout
+{
+    inline std::unique_ptr<juce::RangedAudioParameter> makeParameter (const CoreParameter& parameter)
+    {
+        if (parameter.choices != nullptr)
+        {
+            const auto choices = juce::StringArray::fromTokens (parameter.choices, "|", "");
+            jassert (choices.size() == static_cast<int> (parameter.max_value) + 1 && parameter.min_value == 0.0f);
+            return std::make_unique<juce::AudioParameterChoice> (parameter.id, parameter.name, choices, static_cast<int> (parameter.default_value));
+        }
+
+        if (parameter.is_stepped)
+            return std::make_unique<juce::AudioParameterInt> (parameter.id, parameter.name, static_cast<int> (parameter.min_value), static_cast<int> (parameter.max_value), static_cast<int> (parameter.default_value));
+
+        return std::make_unique<juce::AudioParameterFloat> (parameter.id, parameter.name, parameter.min_value, parameter.max_value, parameter.default_value);
+    }
+
+    // Appends a parameter for every entry of the table, in its order
+    template <size_t NumParameters>
+    void addParameters (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& parameters, const CoreParameter (&table)[NumParameters])
+    {
+        for (const auto& parameter : table)
+            parameters.push_back (makeParameter (parameter));
+    }
+}
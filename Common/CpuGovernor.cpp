@@ -0,0 +1,55 @@
+#include "CpuGovernor.h"
+
+void CpuGovernor::prepare (double sample_rate, int max_block_size, int num_levels)
+{
+    sample_rate_ = sample_rate;
+    load_measurer_.reset (sample_rate, max_block_size);
+    seconds_since_step_ = 0.0;
+    seconds_below_ = 0.0;
+
+    num_levels_ = juce::jmax (1, num_levels);
+    level_ = juce::jmin (level_.load(), num_levels_.load() - 1);
+}
+
+void CpuGovernor::setEnabled (bool enabled)
+{
+    enabled_ = enabled;
+}
+
+int CpuGovernor::update (int num_samples)
+{
+    if (! enabled_.load())
+    {
+        level_ = 0;
+        return 0;
+    }
+
+    const double seconds = num_samples / sample_rate_;
+    const double load = getLoad();
+    int level = level_.load();
+    seconds_since_step_ += seconds;
+
+    if (load > STEP_DOWN_LOAD && level < num_levels_.load() - 1 && seconds_since_step_ >= SETTLE_SECONDS)
+    {
+        ++level;
+        seconds_since_step_ = 0.0;
+        seconds_below_ = 0.0;
+    }
+    else if (load < STEP_UP_LOAD && level > 0)
+    {
+        seconds_below_ += seconds;
+        if (seconds_below_ >= STEP_UP_SECONDS)
+        {
+            --level;
+            seconds_since_step_ = 0.0;
+            seconds_below_ = 0.0;
+        }
+    }
+    else
+    {
+        seconds_below_ = 0.0;
+    }
+
+    level_ = level;
+    return level;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Keeps an eye on how much of the buffer deadline processBlock() takes and trades quality for
+// time when it gets tight, so an overloaded session sounds a bit worse instead of dropping out.
+//
+// Level 0 is full quality and every level above it is one step cheaper, what a step means is
+// up to the processor. The level goes up as soon as the load stays above STEP_DOWN_LOAD and
+// comes back down only after the load has stayed below STEP_UP_LOAD for STEP_UP_SECONDS. The
+// gap between the two is wider than what one step saves, so the level does not oscillate.
+//
+// The load is the time of the block over its length in real time, measured with
+// juce::AudioProcessLoadMeasurer. Level and load can be read from any thread.
+class CpuGovernor
+{
+public:
+    static constexpr double STEP_DOWN_LOAD = 0.5;
+    static constexpr double STEP_UP_LOAD = 0.2;
+    static constexpr double STEP_UP_SECONDS = 2.0;
+    // Time for the load to show the effect of a step before the next one
+    static constexpr double SETTLE_SECONDS = 0.25;
+
+    // num_levels counts level 0, 1 leaves nothing to step down to. Keeps the current level
+    // where it can, a host that prepares again because the latency changed should not bring
+    // the load back.
+    void prepare (double sample_rate, int max_block_size, int num_levels);
+
+    // A disabled governor stays at level 0
+    void setEnabled (bool enabled);
+    bool isEnabled() const { return enabled_.load(); }
+
+    // Audio thread, at the start of processBlock(): steps with the load of the blocks so far
+    // and returns the level to run this block at
+    int update (int num_samples);
+
+    // Audio thread, times the block:
+    //     juce::AudioProcessLoadMeasurer::ScopedTimer timer (governor.getLoadMeasurer(), num_samples);
+    juce::AudioProcessLoadMeasurer& getLoadMeasurer() { return load_measurer_; }
+
+    int getLevel() const { return level_.load(); }
+    int getNumLevels() const { return num_levels_.load(); }
+    // Share of the deadline the recent blocks took, 1 is all of it
+    double getLoad() const { return load_measurer_.getLoadAsProportion(); }
+
+private:
+    juce::AudioProcessLoadMeasurer load_measurer_;
+    double sample_rate_ = 44100.0;
+    double seconds_since_step_ = 0.0;
+    double seconds_below_ = 0.0;
+
+    std::atomic<bool> enabled_ { false };
+    std::atomic<int> level_ { 0 };
+    std::atomic<int> num_levels_ { 1 };
+};
@@ -0,0 +1,33 @@
+#include "CpuGovernorDisplay.h"
+
+CpuGovernorDisplay::CpuGovernorDisplay (const CpuGovernor& governor, juce::Colour colour)
+    : governor_ (governor), colour_ (colour)
+{
+    setInterceptsMouseClicks (false, false);
+    startTimerHz (REFRESH_HZ);
+}
+
+void CpuGovernorDisplay::paint (juce::Graphics& g)
+{
+    g.setColour (colour_);
+    g.setFont (14.0f);
+    g.drawFittedText (text_, getLocalBounds(), juce::Justification::centredLeft, 1);
+}
+
+void CpuGovernorDisplay::timerCallback()
+{
+    juce::String text;
+
+    if (governor_.isEnabled())
+    {
+        const int level = governor_.getLevel();
+        text = "CPU " + juce::String (juce::roundToInt (governor_.getLoad() * 100.0)) + "%, "
+               + (level == 0 ? juce::String ("full quality") : "quality -" + juce::String (level));
+    }
+
+    if (text != text_)
+    {
+        text_ = text;
+        repaint();
+    }
+}
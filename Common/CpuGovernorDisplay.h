@@ -0,0 +1,25 @@
+#pragma once
+
+#include <CpuGovernor.h>
+#include <JuceHeader.h>
+
+// Shows the load and the level of a governor in an editor, and nothing while it is disabled
+class CpuGovernorDisplay : public juce::Component,
+                           private juce::Timer
+{
+public:
+    CpuGovernorDisplay (const CpuGovernor& governor, juce::Colour colour);
+
+    void paint (juce::Graphics& g) override;
+
+private:
+    static constexpr int REFRESH_HZ = 4;
+
+    void timerCallback() override;
+
+    const CpuGovernor& governor_;
+    juce::Colour colour_;
+    juce::String text_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CpuGovernorDisplay)
+};
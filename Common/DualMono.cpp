@@ -0,0 +1,20 @@
+#include "DualMono.h"
+
+bool DualMono::areChannelsIdentical (const float* const* channels, int num_channels, int num_samples)
+{
+    // Bit for bit, a memcmp stops at the first difference and costs next to nothing otherwise
+    const auto num_bytes = static_cast<size_t> (num_samples) * sizeof (float);
+
+    for (int channel = 1; channel < num_channels; ++channel)
+    {
+        if (std::memcmp (channels[0], channels[channel], num_bytes) != 0)
+            return false;
+    }
+    return true;
+}
+
+void DualMono::copyFirstChannel (float* const* channels, int num_channels, int num_samples)
+{
+    for (int channel = 1; channel < num_channels; ++channel)
+        std::copy (channels[0], channels[0] + num_samples, channels[channel]);
+}
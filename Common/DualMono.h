@@ -0,0 +1,57 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Spots blocks in which every channel carries the same signal, such as a mono source on a
+// stereo track, so a processor can run its expensive per channel stages on the first channel
+// only and copy the result to the others.
+//
+// The shortcut only starts once the per channel state of those stages has converged, so the
+// copies are what the channels would have computed themselves. The state of the first channel
+// is then copied to the others on the way in and again on the way out, and the channels carry
+// on from where they would have been without the shortcut.
+class DualMono
+{
+public:
+    // States closer than this, about -120 dBFS, count as converged
+    static constexpr float CONVERGED_DIFFERENCE = 1.0e-6f;
+
+    static bool areChannelsIdentical (const float* const* channels, int num_channels, int num_samples);
+    static void copyFirstChannel (float* const* channels, int num_channels, int num_samples);
+
+    // Audio thread, once per block before processing. Returns whether the block can run on
+    // the first channel. get_state_difference() returns the largest difference between the
+    // state of the first channel and any other, copy_state() gives all channels the state of
+    // the first one.
+    template <typename Difference, typename Copy>
+    bool update (const float* const* channels, int num_channels, int num_samples, Difference&& get_state_difference, Copy&& copy_state);
+
+    bool isActive() const { return active_; }
+    void reset() { active_ = false; }
+    // Off, update() ends a running shortcut and starts none, to compare the output without it
+    void setEnabled (bool enabled) { enabled_ = enabled; }
+
+private:
+    bool active_ = false;
+    bool enabled_ = true;
+};
+
+template <typename Difference, typename Copy>
+bool DualMono::update (const float* const* channels, int num_channels, int num_samples, Difference&& get_state_difference, Copy&& copy_state)
+{
+    const bool identical = enabled_ && num_channels > 1 && areChannelsIdentical (channels, num_channels, num_samples);
+
+    if (active_ && ! identical)
+    {
+        // The other channels skipped the blocks since the shortcut started
+        copy_state();
+        active_ = false;
+    }
+    else if (! active_ && identical && get_state_difference() <= CONVERGED_DIFFERENCE)
+    {
+        copy_state();
+        active_ = true;
+    }
+
+    return active_;
+}
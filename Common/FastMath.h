@@ -0,0 +1,351 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Polynomial and rational approximations of sin, tanh, exp, log and pow, for DSP kernels that
+// do not need the last bits of the std:: functions.
+//
+// Every function is a template over float and FastMath::Vec, so one kernel written as a
+// generic lambda runs on single samples and on SIMD registers alike, see FastMath::process.
+// The first template argument is the degree of the polynomial, or the order of the rational
+// function for tanh. A higher degree costs a multiply-add or two more and is more accurate,
+// so a kernel picks the lowest one that meets its own accuracy requirement:
+//
+//     function   degree   max error   valid input
+//     sin        5        7.0e-5      |x| <= 1000, absolute error
+//                7        7.3e-7
+//                9        1.8e-7
+//     tanh       3        2.4e-2      any x, absolute error
+//                5        1.4e-3
+//                7        9.7e-5
+//     exp2       3        7.5e-5      -126 <= x <= 127, relative error, clamped to the range
+//                4        2.7e-6
+//                5        1.6e-7
+//     exp        3        7.5e-5      -87.3 <= x <= 88.0, relative error, clamped to the range
+//                4        2.7e-6
+//                5        1.9e-7
+//     log2       3        7.8e-4      normal x > 0, absolute error
+//                5        1.5e-5
+//                7        8.9e-7
+//     pow        3        6.1e-4      normal x > 0 and |y log2 x| <= 4, relative error, which
+//                5        1.1e-5      grows in proportion to |y log2 x| beyond that
+//
+// The errors are measured against the std:: functions in double precision over the valid
+// range, float rounding included, by `Benchmarks fastmath`. That table also has the time per
+// sample of each function, scalar and SIMD, next to std::.
+namespace FastMath
+{
+    typedef juce::dsp::SIMDRegister<float> Vec;
+    constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+}
+
+namespace FastMathDetail
+{
+    using FastMath::Vec;
+
+    // Minimax coefficients, the constant term first
+    inline constexpr float SIN_5[] = { 0.999696791f, -0.165673077f, 0.00751437666f };
+    inline constexpr float SIN_7[] = { 0.999996603f, -0.166648284f, 0.00830632541f, -0.000183636541f };
+    inline constexpr float SIN_9[] = { 1.0f, -0.166666478f, 0.00833289977f, -0.000198008973f, 2.59048852e-06f };
+
+    inline constexpr float EXP2_3[] = { 0.999925196f, 0.695833564f, 0.226067156f, 0.0780245215f };
+    inline constexpr float EXP2_4[] = { 1.00000262f, 0.693003833f, 0.241442755f, 0.0520114601f, 0.0135341678f };
+    inline constexpr float EXP2_5[] = { 0.99999994f, 0.693153083f, 0.240153611f, 0.0558263175f, 0.00898934063f, 0.00187757669f };
+
+    // log2 (1 + t) / t on 0 <= t < 1
+    inline constexpr float LOG2_3[] = { 1.42459381f, -0.589206636f, 0.165383711f };
+    inline constexpr float LOG2_5[] = { 1.44196558f, -0.709662795f, 0.417595744f, -0.196269602f, 0.0463853441f };
+    inline constexpr float LOG2_7[] = { 1.44266784f, -0.720585465f, 0.473553389f, -0.325901955f, 0.194294289f, -0.0795577019f, 0.0155299092f };
+
+    template <typename T>
+    T broadcast (float value)
+    {
+        if constexpr (std::is_same<T, float>::value)
+            return value;
+        else
+            return Vec::expand (value);
+    }
+
+    template <typename T, size_t N>
+    T polynomial (T x, const float (&coefficients)[N])
+    {
+        T result = broadcast<T> (coefficients[N - 1]);
+        for (size_t i = N - 1; i > 0; --i)
+            result = result * x + coefficients[i - 1];
+        return result;
+    }
+
+    inline float toFloat (std::uint32_t bits)
+    {
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    inline std::uint32_t toBits (float value)
+    {
+        std::uint32_t bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        return bits;
+    }
+
+    // The operations SIMDRegister does not have, with the same signature for floats and for
+    // registers. Registers without SSE or NEON go lane by lane.
+    template <typename Function>
+    Vec forEachLane (Vec a, Vec b, Function&& function)
+    {
+        Vec result;
+        for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+            result.set (lane, function (a.get (lane), b.get (lane)));
+        return result;
+    }
+
+    inline float clamp (float x, float low, float high) { return juce::jlimit (low, high, x); }
+    inline Vec clamp (Vec x, float low, float high) { return Vec::min (Vec::max (x, Vec::expand (low)), Vec::expand (high)); }
+
+    inline float truncate (float x) { return static_cast<float> (static_cast<int> (x)); }
+    inline Vec truncate (Vec x) { return Vec::truncate (x); }
+
+    inline float divide (float a, float b) { return a / b; }
+    inline Vec divide (Vec a, Vec b)
+    {
+#if JUCE_USE_SSE_INTRINSICS
+        return Vec::fromNative (_mm_div_ps (a.value, b.value));
+#elif JUCE_USE_ARM_NEON && defined(__aarch64__)
+        return Vec::fromNative (vdivq_f32 (a.value, b.value));
+#else
+        return forEachLane (a, b, [] (float x, float y) { return divide (x, y); });
+#endif
+    }
+
+    // x * 2^exponent, for an integer exponent from -126 to 127
+    inline float scaleByPowerOfTwo (float x, float exponent)
+    {
+        return x * toFloat (static_cast<std::uint32_t> (static_cast<int> (exponent) + 127) << 23);
+    }
+
+    inline Vec scaleByPowerOfTwo (Vec x, Vec exponent)
+    {
+#if JUCE_USE_SSE_INTRINSICS
+        const auto bits = _mm_slli_epi32 (_mm_add_epi32 (_mm_cvttps_epi32 (exponent.value), _mm_set1_epi32 (127)), 23);
+        return x * Vec::fromNative (_mm_castsi128_ps (bits));
+#elif JUCE_USE_ARM_NEON
+        const auto bits = vshlq_n_s32 (vaddq_s32 (vcvtq_s32_f32 (exponent.value), vdupq_n_s32 (127)), 23);
+        return x * Vec::fromNative (vreinterpretq_f32_s32 (bits));
+#else
+        return forEachLane (x, exponent, [] (float a, float b) { return scaleByPowerOfTwo (a, b); });
+#endif
+    }
+
+    // Splits a normal x > 0 into 2^exponent * (1 + fraction), returns the exponent
+    inline float splitExponent (float x, float& fraction)
+    {
+        const auto bits = toBits (x);
+        fraction = toFloat ((bits & 0x007fffffu) | 0x3f800000u) - 1.0f;
+        return static_cast<float> (static_cast<int> (bits >> 23) - 127);
+    }
+
+    inline Vec splitExponent (Vec x, Vec& fraction)
+    {
+#if JUCE_USE_SSE_INTRINSICS
+        const auto bits = _mm_castps_si128 (x.value);
+        const auto mantissa = _mm_or_si128 (_mm_and_si128 (bits, _mm_set1_epi32 (0x007fffff)), _mm_set1_epi32 (0x3f800000));
+        fraction = Vec::fromNative (_mm_castsi128_ps (mantissa)) - Vec::expand (1.0f);
+        return Vec::fromNative (_mm_cvtepi32_ps (_mm_sub_epi32 (_mm_srli_epi32 (bits, 23), _mm_set1_epi32 (127))));
+#elif JUCE_USE_ARM_NEON
+        const auto bits = vreinterpretq_u32_f32 (x.value);
+        const auto mantissa = vorrq_u32 (vandq_u32 (bits, vdupq_n_u32 (0x007fffffu)), vdupq_n_u32 (0x3f800000u));
+        fraction = Vec::fromNative (vreinterpretq_f32_u32 (mantissa)) - Vec::expand (1.0f);
+        return Vec::fromNative (vcvtq_f32_s32 (vsubq_s32 (vreinterpretq_s32_u32 (vshrq_n_u32 (bits, 23)), vdupq_n_s32 (127))));
+#else
+        Vec exponent;
+        for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+        {
+            float lane_fraction;
+            exponent.set (lane, splitExponent (x.get (lane), lane_fraction));
+            fraction.set (lane, lane_fraction);
+        }
+        return exponent;
+#endif
+    }
+}
+
+namespace FastMath
+{
+    // sin (x) for |x| <= 1000. x is reduced to the half period around 0 with pi split in two,
+    // so that even at |x| = 1000 the reduction adds little to the error of the polynomial.
+    template <int Degree, typename T>
+    T sin (T x)
+    {
+        static_assert (Degree == 5 || Degree == 7 || Degree == 9, "sin has degrees 5, 7 and 9");
+        using namespace FastMathDetail;
+
+        // Stays positive for the truncation, and even, so the parity of half_turns is kept
+        constexpr float OFFSET = 4096.0f;
+        constexpr float INV_PI = 0.318309886f;
+        constexpr float PI_HIGH = 3.140625f;
+        constexpr float PI_LOW = 9.67653589793e-4f;
+
+        const T half_turns = truncate (x * INV_PI + (OFFSET + 0.5f));
+        const T odd = half_turns - truncate (half_turns * 0.5f) * 2.0f;
+        const T k = half_turns - OFFSET;
+        const T r = (x - k * PI_HIGH) - k * PI_LOW;
+        const T sign = broadcast<T> (1.0f) - odd * 2.0f;
+
+        const T r2 = r * r;
+        if constexpr (Degree == 5)
+            return sign * r * polynomial (r2, SIN_5);
+        else if constexpr (Degree == 7)
+            return sign * r * polynomial (r2, SIN_7);
+        else
+            return sign * r * polynomial (r2, SIN_9);
+    }
+
+    // Padé approximants of tanh from Lambert's continued fraction, clamped to +-1 where they
+    // reach it
+    template <int Order, typename T>
+    T tanh (T x)
+    {
+        static_assert (Order == 3 || Order == 5 || Order == 7, "tanh has orders 3, 5 and 7");
+        using namespace FastMathDetail;
+
+        if constexpr (Order == 3)
+        {
+            x = clamp (x, -3.0f, 3.0f);
+            const T x2 = x * x;
+            return divide (x * (x2 + 27.0f), x2 * 9.0f + 27.0f);
+        }
+        else if constexpr (Order == 5)
+        {
+            x = clamp (x, -3.6467f, 3.6467f);
+            const T x2 = x * x;
+            return clamp (divide (x * ((x2 + 105.0f) * x2 + 945.0f), (x2 * 15.0f + 420.0f) * x2 + 945.0f), -1.0f, 1.0f);
+        }
+        else
+        {
+            x = clamp (x, -4.9718f, 4.9718f);
+            const T x2 = x * x;
+            return clamp (divide (x * (((x2 + 378.0f) * x2 + 17325.0f) * x2 + 135135.0f),
+                                  ((x2 * 28.0f + 3150.0f) * x2 + 62370.0f) * x2 + 135135.0f),
+                          -1.0f,
+                          1.0f);
+        }
+    }
+
+    // 2^x, as 2^floor (x) from the exponent bits times a polynomial in the fraction
+    template <int Degree, typename T>
+    T exp2 (T x)
+    {
+        static_assert (Degree == 3 || Degree == 4 || Degree == 5, "exp2 has degrees 3, 4 and 5");
+        using namespace FastMathDetail;
+
+        // Above 0 for the truncation, that makes it a floor
+        constexpr float OFFSET = 128.0f;
+
+        x = clamp (x, -126.0f, 127.0f);
+        const T exponent = truncate (x + OFFSET) - OFFSET;
+        const T fraction = x - exponent;
+
+        if constexpr (Degree == 3)
+            return scaleByPowerOfTwo (polynomial (fraction, EXP2_3), exponent);
+        else if constexpr (Degree == 4)
+            return scaleByPowerOfTwo (polynomial (fraction, EXP2_4), exponent);
+        else
+            return scaleByPowerOfTwo (polynomial (fraction, EXP2_5), exponent);
+    }
+
+    // e^x, like exp2 but with the fraction taken from x with ln 2 split in two, so the
+    // rounding of x log2 e does not grow the error at large |x|
+    template <int Degree, typename T>
+    T exp (T x)
+    {
+        static_assert (Degree == 3 || Degree == 4 || Degree == 5, "exp has degrees 3, 4 and 5");
+        using namespace FastMathDetail;
+
+        constexpr float OFFSET = 128.0f;
+        constexpr float LOG2_E = 1.44269504f;
+        constexpr float LN2_HIGH = 0.693145752f;
+        constexpr float LN2_LOW = 1.42860677e-06f;
+
+        x = clamp (x, -87.3365f, 88.0296f);
+        const T exponent = truncate (x * LOG2_E + OFFSET) - OFFSET;
+        const T fraction = ((x - exponent * LN2_HIGH) - exponent * LN2_LOW) * LOG2_E;
+
+        if constexpr (Degree == 3)
+            return scaleByPowerOfTwo (polynomial (fraction, EXP2_3), exponent);
+        else if constexpr (Degree == 4)
+            return scaleByPowerOfTwo (polynomial (fraction, EXP2_4), exponent);
+        else
+            return scaleByPowerOfTwo (polynomial (fraction, EXP2_5), exponent);
+    }
+
+    // log2 (x), the exponent bits plus a polynomial in the mantissa
+    template <int Degree, typename T>
+    T log2 (T x)
+    {
+        static_assert (Degree == 3 || Degree == 5 || Degree == 7, "log2 has degrees 3, 5 and 7");
+        using namespace FastMathDetail;
+
+        T fraction;
+        const T exponent = splitExponent (x, fraction);
+
+        if constexpr (Degree == 3)
+            return exponent + fraction * polynomial (fraction, LOG2_3);
+        else if constexpr (Degree == 5)
+            return exponent + fraction * polynomial (fraction, LOG2_5);
+        else
+            return exponent + fraction * polynomial (fraction, LOG2_7);
+    }
+
+    // x^y as 2^(y log2 x), with log2 and exp2 of the same degree
+    template <int Degree, typename T>
+    T pow (T x, T y)
+    {
+        static_assert (Degree == 3 || Degree == 5, "pow has degrees 3 and 5");
+        return exp2<Degree> (y * log2<Degree> (x));
+    }
+
+    // Calls function on num_samples samples of input and writes the results to output, a
+    // register at a time and the samples that are left one by one. function takes and
+    // returns a float or a Vec, usually it is a generic lambda:
+    //
+    //     FastMath::process (input, output, num_samples, [] (auto x) { return FastMath::tanh<5> (x * 4.0f); });
+    //
+    // input and output may be the same and need not be aligned.
+    template <typename Function>
+    void process (const float* input, float* output, int num_samples, Function&& function)
+    {
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES] = {};
+        int sample = 0;
+
+        for (; sample + LANES <= num_samples; sample += LANES)
+        {
+            std::copy (input + sample, input + sample + LANES, lanes);
+            function (Vec::fromRawArray (lanes)).copyToRawArray (lanes);
+            std::copy (lanes, lanes + LANES, output + sample);
+        }
+
+        for (; sample < num_samples; ++sample)
+            output[sample] = function (input[sample]);
+    }
+
+    // The same for a function of two arguments, such as pow
+    template <typename Function>
+    void process (const float* x, const float* y, float* output, int num_samples, Function&& function)
+    {
+        alignas (Vec::SIMDRegisterSize) float x_lanes[LANES] = {};
+        alignas (Vec::SIMDRegisterSize) float y_lanes[LANES] = {};
+        int sample = 0;
+
+        for (; sample + LANES <= num_samples; sample += LANES)
+        {
+            std::copy (x + sample, x + sample + LANES, x_lanes);
+            std::copy (y + sample, y + sample + LANES, y_lanes);
+            function (Vec::fromRawArray (x_lanes), Vec::fromRawArray (y_lanes)).copyToRawArray (x_lanes);
+            std::copy (x_lanes, x_lanes + LANES, output + sample);
+        }
+
+        for (; sample < num_samples; ++sample)
+            output[sample] = function (x[sample], y[sample]);
+    }
+}
@@ -0,0 +1,415 @@
+#include "HalfBandFilter.h"
+
+namespace
+{
+    double integerPower (double x, int n)
+    {
+        double result = 1.0;
+        while (n != 0)
+        {
+            if ((n & 1) != 0)
+                result *= x;
+            n >>= 1;
+            x *= x;
+        }
+        return result;
+    }
+
+    double accumulateNumerator (double q, int order, int c)
+    {
+        double sum = 0.0;
+        double term = 0.0;
+        double sign = 1.0;
+        int i = 0;
+        do
+        {
+            term = integerPower (q, i * (i + 1)) * std::sin ((i * 2 + 1) * c * juce::MathConstants<double>::pi / order) * sign;
+            sum += term;
+            sign = -sign;
+            ++i;
+        } while (std::abs (term) > 1e-100);
+        return sum;
+    }
+
+    double accumulateDenominator (double q, int order, int c)
+    {
+        double sum = 0.0;
+        double term = 0.0;
+        double sign = -1.0;
+        int i = 1;
+        do
+        {
+            term = integerPower (q, i * i) * std::cos (i * 2 * c * juce::MathConstants<double>::pi / order) * sign;
+            sum += term;
+            sign = -sign;
+            ++i;
+        } while (std::abs (term) > 1e-100);
+        return sum;
+    }
+}
+
+std::vector<double> HalfBandIir::designCoefficients (int num_coefficients, double transition_bandwidth)
+{
+    jassert (num_coefficients > 0);
+    jassert (transition_bandwidth > 0.0 && transition_bandwidth < 0.5);
+
+    // Elliptic modulus and nome from the transition bandwidth
+    double k = std::tan ((1.0 - transition_bandwidth * 2.0) * juce::MathConstants<double>::pi / 4.0);
+    k *= k;
+    const double kk_root = std::pow (1.0 - k * k, 0.25);
+    const double e = 0.5 * (1.0 - kk_root) / (1.0 + kk_root);
+    const double e4 = e * e * e * e;
+    const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    const int order = num_coefficients * 2 + 1;
+    std::vector<double> coefficients;
+
+    for (int index = 0; index < num_coefficients; ++index)
+    {
+        const double numerator = accumulateNumerator (q, order, index + 1) * std::pow (q, 0.25);
+        const double denominator = accumulateDenominator (q, order, index + 1) + 0.5;
+        const double ww = numerator / denominator;
+        const double ww_squared = ww * ww;
+        const double x = std::sqrt ((1.0 - ww_squared * k) * (1.0 - ww_squared / k)) / (1.0 + ww_squared);
+        coefficients.push_back ((1.0 - x) / (1.0 + x));
+    }
+
+    return coefficients;
+}
+
+void HalfBandIir::setCoefficients (const std::vector<double>& coefficients)
+{
+    coefficients_.assign (coefficients.begin(), coefficients.end());
+
+    lane_coefficients_.clear();
+    for (auto coefficient : coefficients_)
+        lane_coefficients_.push_back (Vec::expand (coefficient));
+
+    prepare (num_channels_);
+}
+
+void HalfBandIir::prepare (int num_channels)
+{
+    num_channels_ = num_channels;
+    const auto num_groups = static_cast<size_t> ((num_channels + LANES - 1) / LANES);
+    x_.resize (coefficients_.size() * num_groups);
+    y_.resize (coefficients_.size() * num_groups);
+    reset();
+}
+
+void HalfBandIir::reset()
+{
+    std::fill (x_.begin(), x_.end(), Vec::expand (0.0f));
+    std::fill (y_.begin(), y_.end(), Vec::expand (0.0f));
+}
+
+float HalfBandIir::getStateDifference (int channel) const
+{
+    const auto num_coefficients = coefficients_.size();
+    const auto* x = x_.data() + static_cast<size_t> (channel / LANES) * num_coefficients;
+    const auto* y = y_.data() + static_cast<size_t> (channel / LANES) * num_coefficients;
+    const auto lane = static_cast<size_t> (channel % LANES);
+    float difference = 0.0f;
+
+    for (size_t i = 0; i < num_coefficients; ++i)
+    {
+        difference = juce::jmax (difference, std::abs (x[i].get (lane) - x_[i].get (0)));
+        difference = juce::jmax (difference, std::abs (y[i].get (lane) - y_[i].get (0)));
+    }
+    return difference;
+}
+
+void HalfBandIir::copyFirstChannelState (int channel)
+{
+    const auto num_coefficients = coefficients_.size();
+    auto* x = x_.data() + static_cast<size_t> (channel / LANES) * num_coefficients;
+    auto* y = y_.data() + static_cast<size_t> (channel / LANES) * num_coefficients;
+    const auto lane = static_cast<size_t> (channel % LANES);
+
+    for (size_t i = 0; i < num_coefficients; ++i)
+    {
+        x[i].set (lane, x_[i].get (0));
+        y[i].set (lane, y_[i].get (0));
+    }
+}
+
+void HalfBandIir::downsample (const float* const* input, float* const* output, int num_channels, int num_output_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    const int num_coefficients = getNumCoefficients();
+    const Vec* c = lane_coefficients_.data();
+    alignas (Vec::SIMDRegisterSize) float newer[LANES] = {};
+    alignas (Vec::SIMDRegisterSize) float older[LANES] = {};
+
+    for (int first = 0; first < num_channels; first += LANES)
+    {
+        const int used_lanes = juce::jmin (LANES, num_channels - first);
+        Vec* x = x_.data() + (first / LANES) * num_coefficients;
+        Vec* y = y_.data() + (first / LANES) * num_coefficients;
+
+        for (int i = 0; i < num_output_samples; ++i)
+        {
+            for (int lane = 0; lane < used_lanes; ++lane)
+            {
+                newer[lane] = input[first + lane][i * 2 + 1];
+                older[lane] = input[first + lane][i * 2];
+            }
+
+            // Even sections filter the newer sample of each pair, odd sections the older one
+            Vec path_0 = Vec::fromRawArray (newer);
+            Vec path_1 = Vec::fromRawArray (older);
+
+            for (int n = 0; n < num_coefficients; n += 2)
+            {
+                const Vec out_0 = (path_0 - y[n]) * c[n] + x[n];
+                x[n] = path_0;
+                y[n] = out_0;
+                path_0 = out_0;
+
+                if (n + 1 < num_coefficients)
+                {
+                    const Vec out_1 = (path_1 - y[n + 1]) * c[n + 1] + x[n + 1];
+                    x[n + 1] = path_1;
+                    y[n + 1] = out_1;
+                    path_1 = out_1;
+                }
+            }
+
+            ((path_0 + path_1) * 0.5f).copyToRawArray (newer);
+
+            for (int lane = 0; lane < used_lanes; ++lane)
+                output[first + lane][i] = newer[lane];
+        }
+    }
+}
+
+void HalfBandIir::upsample (const float* const* input, float* const* output, int num_channels, int num_input_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    const int num_coefficients = getNumCoefficients();
+    const Vec* c = lane_coefficients_.data();
+    alignas (Vec::SIMDRegisterSize) float even[LANES] = {};
+    alignas (Vec::SIMDRegisterSize) float odd[LANES] = {};
+
+    for (int first = 0; first < num_channels; first += LANES)
+    {
+        const int used_lanes = juce::jmin (LANES, num_channels - first);
+        Vec* x = x_.data() + (first / LANES) * num_coefficients;
+        Vec* y = y_.data() + (first / LANES) * num_coefficients;
+
+        for (int i = 0; i < num_input_samples; ++i)
+        {
+            for (int lane = 0; lane < used_lanes; ++lane)
+                even[lane] = input[first + lane][i];
+
+            Vec path_0 = Vec::fromRawArray (even);
+            Vec path_1 = path_0;
+
+            for (int n = 0; n < num_coefficients; n += 2)
+            {
+                const Vec out_0 = (path_0 - y[n]) * c[n] + x[n];
+                x[n] = path_0;
+                y[n] = out_0;
+                path_0 = out_0;
+
+                if (n + 1 < num_coefficients)
+                {
+                    const Vec out_1 = (path_1 - y[n + 1]) * c[n + 1] + x[n + 1];
+                    x[n + 1] = path_1;
+                    y[n + 1] = out_1;
+                    path_1 = out_1;
+                }
+            }
+
+            path_0.copyToRawArray (even);
+            path_1.copyToRawArray (odd);
+
+            for (int lane = 0; lane < used_lanes; ++lane)
+            {
+                output[first + lane][i * 2] = even[lane];
+                output[first + lane][i * 2 + 1] = odd[lane];
+            }
+        }
+    }
+}
+
+double HalfBandIir::getPathDelay (int path) const
+{
+    // A first order allpass (c + z^-1) / (1 + c z^-1) delays low frequencies by (1 - c) / (1 + c)
+    double delay = 0.0;
+    for (size_t n = static_cast<size_t> (path); n < coefficients_.size(); n += 2)
+        delay += (1.0 - coefficients_[n]) / (1.0 + coefficients_[n]);
+    return delay;
+}
+
+double HalfBandIir::getDownsamplingDelay() const
+{
+    return 2.0 * getPathDelay (1);
+}
+
+double HalfBandIir::getUpsamplingDelay() const
+{
+    return 2.0 * getPathDelay (0);
+}
+
+size_t HalfBandIir::getMemoryBytes() const
+{
+    return coefficients_.size() * sizeof (float) + (lane_coefficients_.size() + x_.size() + y_.size()) * sizeof (Vec);
+}
+
+//==============================================================================
+std::vector<float> HalfBandFir::designKernel (int num_taps, double kaiser_beta)
+{
+    jassert (num_taps > 0 && num_taps % 4 == 0);
+
+    // The full kernel has 2 * num_taps - 1 taps centred on num_taps - 1. Only the taps an
+    // odd distance away from the centre are non zero, those are the ones kept here.
+    const double centre = num_taps - 1;
+    const auto bessel_i0 = [] (double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    };
+
+    std::vector<float> kernel;
+    double sum = 0.0;
+    std::vector<double> taps;
+
+    for (int i = 0; i < num_taps; ++i)
+    {
+        const double offset = i * 2 - centre;
+        const double sinc = std::sin (juce::MathConstants<double>::halfPi * offset) / (juce::MathConstants<double>::halfPi * offset);
+        const double ratio = offset / centre;
+        const double window = bessel_i0 (kaiser_beta * std::sqrt (juce::jmax (0.0, 1.0 - ratio * ratio))) / bessel_i0 (kaiser_beta);
+        taps.push_back (0.5 * sinc * window);
+        sum += taps.back();
+    }
+
+    // Normalise for unity gain at DC, the centre tap contributes the other half
+    for (auto tap : taps)
+        kernel.push_back (static_cast<float> (tap * 0.5 / sum));
+
+    return kernel;
+}
+
+void HalfBandFir::setKernel (const std::vector<float>& kernel)
+{
+    jassert (kernel.size() % 4 == 0);
+    kernel_ = kernel;
+    prepare (num_channels_);
+}
+
+void HalfBandFir::prepare (int num_channels)
+{
+    num_channels_ = num_channels;
+    history_.assign (kernel_.size() * 4 * static_cast<size_t> (num_channels), 0.0f);
+    position_ = 0;
+}
+
+void HalfBandFir::reset()
+{
+    std::fill (history_.begin(), history_.end(), 0.0f);
+    position_ = 0;
+}
+
+float HalfBandFir::getStateDifference (int channel) const
+{
+    const auto history_size = kernel_.size() * 4;
+    const float* history = history_.data() + static_cast<size_t> (channel) * history_size;
+    float difference = 0.0f;
+
+    for (size_t i = 0; i < history_size; ++i)
+        difference = juce::jmax (difference, std::abs (history[i] - history_[i]));
+    return difference;
+}
+
+void HalfBandFir::copyFirstChannelState (int channel)
+{
+    const auto history_size = kernel_.size() * 4;
+    std::copy (history_.begin(), history_.begin() + static_cast<std::ptrdiff_t> (history_size), history_.begin() + static_cast<std::ptrdiff_t> (static_cast<size_t> (channel) * history_size));
+}
+
+void HalfBandFir::downsample (const float* const* input, float* const* output, int num_channels, int num_output_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    const int num_taps = getNumTaps();
+    int position = position_;
+
+    for (int channel = 0; channel < num_channels; ++channel)
+    {
+        float* even = history_.data() + channel * num_taps * 4;
+        float* odd = even + num_taps * 2;
+        position = position_;
+
+        for (int i = 0; i < num_output_samples; ++i)
+        {
+            // Newest sample first, window[k] is the sample k steps back
+            position = position == 0 ? num_taps - 1 : position - 1;
+            even[position] = even[position + num_taps] = input[channel][i * 2];
+            odd[position] = odd[position + num_taps] = input[channel][i * 2 + 1];
+
+            output[channel][i] = dotProduct (kernel_.data(), even + position, num_taps)
+                                 + 0.5f * odd[position + num_taps / 2];
+        }
+    }
+
+    position_ = position;
+}
+
+void HalfBandFir::upsample (const float* const* input, float* const* output, int num_channels, int num_input_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    const int num_taps = getNumTaps();
+    int position = position_;
+
+    for (int channel = 0; channel < num_channels; ++channel)
+    {
+        float* history = history_.data() + channel * num_taps * 4;
+        position = position_;
+
+        for (int i = 0; i < num_input_samples; ++i)
+        {
+            position = position == 0 ? num_taps - 1 : position - 1;
+            history[position] = history[position + num_taps] = input[channel][i];
+
+            // Zero stuffing halves the level, so the kernel is applied with twice the gain
+            output[channel][i * 2] = 2.0f * dotProduct (kernel_.data(), history + position, num_taps);
+            output[channel][i * 2 + 1] = history[position + num_taps / 2 - 1];
+        }
+    }
+
+    position_ = position;
+}
+
+float HalfBandFir::dotProduct (const float* a, const float* b, int num_values)
+{
+#if JUCE_USE_SSE_INTRINSICS
+    __m128 sum = _mm_setzero_ps();
+    for (int i = 0; i < num_values; i += 4)
+        sum = _mm_add_ps (sum, _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+
+    alignas (16) float lanes[4];
+    _mm_store_ps (lanes, sum);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+    // Four independent sums, which compilers turn into vector code on other targets
+    float sum_0 = 0.0f, sum_1 = 0.0f, sum_2 = 0.0f, sum_3 = 0.0f;
+    for (int i = 0; i < num_values; i += 4)
+    {
+        sum_0 += a[i] * b[i];
+        sum_1 += a[i + 1] * b[i + 1];
+        sum_2 += a[i + 2] * b[i + 2];
+        sum_3 += a[i + 3] * b[i + 3];
+    }
+    return (sum_0 + sum_1) + (sum_2 + sum_3);
+#endif
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Polyphase IIR half-band filter for decimating or interpolating by a factor of two.
+//
+// The filter is made of two parallel chains of first order allpass sections running at the
+// lower rate, so it only costs one multiply per coefficient and output sample. Coefficients
+// are designed for a given number of sections and transition bandwidth, using the same
+// elliptic design as Laurent de Soras' HIIR library. With 8 coefficients and a transition
+// bandwidth of 0.05 the stop band is attenuated by more than 110 dB.
+//
+// State is stored structure-of-arrays with one channel per SIMD lane, so up to four
+// channels are filtered for the price of one. Use one instance for decimation and another
+// for interpolation, each keeps its own state.
+class HalfBandIir
+{
+public:
+    // transition_bandwidth is relative to the higher sample rate, in the range ]0, 0.5[
+    static std::vector<double> designCoefficients (int num_coefficients, double transition_bandwidth);
+
+    void setCoefficients (const std::vector<double>& coefficients);
+    int getNumCoefficients() const { return static_cast<int> (coefficients_.size()); }
+
+    void prepare (int num_channels);
+    void reset();
+
+    // Largest difference between the allpass memory of channel and that of channel 0
+    float getStateDifference (int channel) const;
+    // Gives channel the allpass memory of channel 0
+    void copyFirstChannelState (int channel);
+
+    // Reads num_output_samples * 2 samples from every input and writes num_output_samples
+    void downsample (const float* const* input, float* const* output, int num_channels, int num_output_samples);
+    // Reads num_input_samples samples from every input and writes num_input_samples * 2
+    void upsample (const float* const* input, float* const* output, int num_channels, int num_input_samples);
+
+    // Group delay at low frequencies, in samples at the higher of the two rates
+    double getDownsamplingDelay() const;
+    double getUpsamplingDelay() const;
+
+    // Bytes of coefficient and state memory held for the prepared channels
+    size_t getMemoryBytes() const;
+
+private:
+    typedef juce::dsp::SIMDRegister<float> Vec;
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+
+    double getPathDelay (int path) const;
+
+    std::vector<float> coefficients_;
+    std::vector<Vec> lane_coefficients_;
+    // Allpass memory, num_coefficients registers per group of LANES channels
+    std::vector<Vec> x_;
+    std::vector<Vec> y_;
+    int num_channels_ = 0;
+};
+
+// Linear phase polyphase half-band FIR filter for decimating or interpolating by two.
+//
+// Every other tap of a half-band kernel is zero apart from the centre one, so only the
+// num_taps non zero taps of one polyphase branch are evaluated, as a SIMD dot product over
+// a history buffer that is written twice so the newest num_taps samples are always
+// contiguous. The other branch is a plain delay.
+class HalfBandFir
+{
+public:
+    // Windowed sinc kernel with num_taps non zero taps besides the centre, num_taps must be a
+    // multiple of 4. A larger kaiser_beta trades transition width for stop band attenuation.
+    static std::vector<float> designKernel (int num_taps, double kaiser_beta);
+
+    void setKernel (const std::vector<float>& kernel);
+    int getNumTaps() const { return static_cast<int> (kernel_.size()); }
+
+    void prepare (int num_channels);
+    void reset();
+
+    // Largest difference between the history of channel and that of channel 0
+    float getStateDifference (int channel) const;
+    // Gives channel the history of channel 0
+    void copyFirstChannelState (int channel);
+
+    void downsample (const float* const* input, float* const* output, int num_channels, int num_output_samples);
+    void upsample (const float* const* input, float* const* output, int num_channels, int num_input_samples);
+
+    // Delay in samples at the higher of the two rates, the same in both directions
+    double getDelay() const { return static_cast<double> (kernel_.size()) - 1.0; }
+
+private:
+    static float dotProduct (const float* a, const float* b, int num_values);
+
+    std::vector<float> kernel_;
+    // Two double written histories per channel, 4 * num_taps values per channel
+    std::vector<float> history_;
+    int position_ = 0;
+    int num_channels_ = 0;
+};
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+// 16 bit floating point storage types for buffers that do not need the precision of a float,
+// such as long reverb delay lines. Arithmetic stays in float, values are only rounded to 16
+// bits when stored, with round to nearest even.
+//
+// Float16 is IEEE half precision, 11 significant bits and a range of 6e-8 to 65504. BFloat16
+// is the upper half of a float, only 8 significant bits but the full float range.
+struct Float16
+{
+    Float16() = default;
+    explicit Float16 (float value) : bits (fromFloat (value)) {}
+    operator float() const { return toFloat (bits); }
+
+    static std::uint16_t fromFloat (float value);
+    static float toFloat (std::uint16_t bits);
+
+    std::uint16_t bits = 0;
+};
+
+struct BFloat16
+{
+    BFloat16() = default;
+    explicit BFloat16 (float value) : bits (fromFloat (value)) {}
+    operator float() const { return toFloat (bits); }
+
+    static std::uint16_t fromFloat (float value);
+    static float toFloat (std::uint16_t bits);
+
+    std::uint16_t bits = 0;
+};
+
+namespace HalfFloatDetail
+{
+    inline std::uint32_t toBits (float value)
+    {
+        std::uint32_t bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        return bits;
+    }
+
+    inline float fromBits (std::uint32_t bits)
+    {
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+}
+
+inline std::uint16_t Float16::fromFloat (float value)
+{
+#if defined(__F16C__)
+    return static_cast<std::uint16_t> (_cvtss_sh (value, _MM_FROUND_TO_NEAREST_INT));
+#else
+    // Branchy but exact conversion after F. Giesen's float_to_half_fast3_rtne
+    std::uint32_t f = HalfFloatDetail::toBits (value);
+    const std::uint32_t sign = f & 0x80000000u;
+    f ^= sign;
+
+    std::uint32_t half;
+    if (f >= 0x47800000u)
+    {
+        // Too large for a half becomes infinity, NaN stays NaN
+        half = f > 0x7f800000u ? 0x7e00u : 0x7c00u;
+    }
+    else if (f < 0x38800000u)
+    {
+        // Subnormal result, adding 0.5 lets the FPU do the rounding of the shifted mantissa
+        const float rounded = HalfFloatDetail::fromBits (f) + 0.5f;
+        half = HalfFloatDetail::toBits (rounded) - 0x3f000000u;
+    }
+    else
+    {
+        const std::uint32_t mantissa_odd = (f >> 13) & 1u;
+        f += 0xc8000fffu; // rebias the exponent from 127 to 15 and round half up
+        f += mantissa_odd; // which becomes half to even
+        half = f >> 13;
+    }
+    return static_cast<std::uint16_t> (half | (sign >> 16));
+#endif
+}
+
+inline float Float16::toFloat (std::uint16_t bits)
+{
+#if defined(__F16C__)
+    return _cvtsh_ss (bits);
+#else
+    constexpr std::uint32_t shifted_exponent = 0x7c00u << 13;
+
+    std::uint32_t f = (bits & 0x7fffu) << 13;
+    const std::uint32_t exponent = f & shifted_exponent;
+    f += (127u - 15u) << 23;
+
+    if (exponent == shifted_exponent)
+    {
+        // Infinity or NaN
+        f += (128u - 16u) << 23;
+    }
+    else if (exponent == 0)
+    {
+        // Zero or subnormal, renormalised by the FPU
+        f += 1u << 23;
+        f = HalfFloatDetail::toBits (HalfFloatDetail::fromBits (f) - HalfFloatDetail::fromBits (113u << 23));
+    }
+    return HalfFloatDetail::fromBits (f | static_cast<std::uint32_t> (bits & 0x8000u) << 16);
+#endif
+}
+
+inline std::uint16_t BFloat16::fromFloat (float value)
+{
+    const std::uint32_t f = HalfFloatDetail::toBits (value);
+
+    if ((f & 0x7fffffffu) > 0x7f800000u)
+        return static_cast<std::uint16_t> ((f >> 16) | 0x40u);
+
+    return static_cast<std::uint16_t> ((f + 0x7fffu + ((f >> 16) & 1u)) >> 16);
+}
+
+inline float BFloat16::toFloat (std::uint16_t bits)
+{
+    return HalfFloatDetail::fromBits (static_cast<std::uint32_t> (bits) << 16);
+}
@@ -0,0 +1,35 @@
+#include "Lfo.h"
+
+void Lfo::prepare (double sample_rate)
+{
+    table_ = SharedTables::get (SharedTables::Type::sine, TABLE_SIZE);
+    sample_rate_ = sample_rate;
+    reset();
+}
+
+void Lfo::reset()
+{
+    phase_ = 0.0f;
+    frequency_.reset (sample_rate_, 0.05);
+}
+
+float Lfo::processSample()
+{
+    jassert (table_ != nullptr);
+
+    const auto increment = static_cast<float> (juce::MathConstants<float>::twoPi * frequency_.getNextValue() / sample_rate_);
+    const auto x = juce::jlimit (-juce::MathConstants<float>::pi, juce::MathConstants<float>::pi, phase_ - juce::MathConstants<float>::pi);
+
+    phase_ += increment;
+    while (phase_ >= juce::MathConstants<float>::twoPi)
+        phase_ -= juce::MathConstants<float>::twoPi;
+
+    // Linear interpolation over the table spanning [-pi, pi]
+    constexpr auto scaler = static_cast<float> (TABLE_SIZE - 1) / juce::MathConstants<float>::twoPi;
+    constexpr auto offset = juce::MathConstants<float>::pi * scaler;
+    const auto index = scaler * x + offset;
+    const auto i = static_cast<size_t> (index);
+    const auto fraction = index - static_cast<float> (i);
+    const auto& values = *table_;
+    return values[i] + fraction * (values[i + 1] - values[i]);
+}
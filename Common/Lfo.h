@@ -0,0 +1,28 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <SharedTables.h>
+
+// Sine LFO reading a lookup table shared by every instance in the process.
+//
+// It produces the same output as a juce::dsp::Oscillator initialised with std::sin and a
+// lookup table, including the 50 ms frequency glide starting at 440 Hz, without building a
+// table of its own.
+class Lfo
+{
+public:
+    static constexpr int TABLE_SIZE = 128;
+
+    // Also resets the phase, call from prepareToPlay()
+    void prepare (double sample_rate);
+    void reset();
+
+    void setFrequency (float frequency) { frequency_.setTargetValue (frequency); }
+    float processSample();
+
+private:
+    SharedTables::Table table_;
+    double sample_rate_ = 44100.0;
+    float phase_ = 0.0f;
+    juce::SmoothedValue<float> frequency_ { 440.0f };
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Splits a host block into micro blocks of at most SIZE samples, so a processor can run every
+// one of its stages on a micro block before the next micro block starts.
+//
+// Stage by stage over a host block of thousands of samples, the output of one stage has left
+// L1 by the time the next stage reads it. A micro block and the scratch buffers it passes
+// through (dry copy, modulation, the oversampled signal) stay in L1 from the first stage to
+// the last, so the cost per sample no longer grows with the host block size. The stages keep
+// their state between micro blocks, the output is the same as with whole blocks.
+class MicroBlocks
+{
+public:
+    // At 8x oversampling a micro block of 64 samples is 2 KB per channel at the highest rate
+    static constexpr int SIZE = 64;
+
+    // Samples a scratch buffer needs when it only ever holds one micro block
+    static int getScratchSize (int max_block_size) { return juce::jlimit (1, SIZE, max_block_size); }
+
+    // Calls function (first_sample, num_samples) for the micro blocks of num_samples samples,
+    // in order
+    template <typename Function>
+    static void forEach (int num_samples, Function&& function)
+    {
+        for (int first_sample = 0; first_sample < num_samples; first_sample += SIZE)
+            function (first_sample, juce::jmin (SIZE, num_samples - first_sample));
+    }
+};
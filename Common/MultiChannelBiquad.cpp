@@ -0,0 +1,149 @@
+#include "MultiChannelBiquad.h"
+
+MultiChannelBiquad::Coefficients MultiChannelBiquad::makeHighPass (double sample_rate, float frequency, float q)
+{
+    const auto n = std::tan (juce::MathConstants<double>::pi * frequency / sample_rate);
+    const auto n_squared = n * n;
+    const auto inv_q = 1.0 / q;
+    const auto c1 = 1.0 / (1.0 + inv_q * n + n_squared);
+
+    Coefficients c;
+    c.b0 = static_cast<float> (c1);
+    c.b1 = static_cast<float> (c1 * -2.0);
+    c.b2 = static_cast<float> (c1);
+    c.a1 = static_cast<float> (c1 * 2.0 * (n_squared - 1.0));
+    c.a2 = static_cast<float> (c1 * (1.0 - inv_q * n + n_squared));
+    return c;
+}
+
+MultiChannelBiquad::Coefficients MultiChannelBiquad::makeBandPass (double sample_rate, float frequency, float q)
+{
+    const auto n = 1.0 / std::tan (juce::MathConstants<double>::pi * frequency / sample_rate);
+    const auto n_squared = n * n;
+    const auto inv_q = 1.0 / q;
+    const auto c1 = 1.0 / (1.0 + inv_q * n + n_squared);
+
+    Coefficients c;
+    c.b0 = static_cast<float> (c1 * n * inv_q);
+    c.b1 = 0.0f;
+    c.b2 = static_cast<float> (-c1 * n * inv_q);
+    c.a1 = static_cast<float> (c1 * 2.0 * (1.0 - n_squared));
+    c.a2 = static_cast<float> (c1 * (1.0 - inv_q * n + n_squared));
+    return c;
+}
+
+MultiChannelBiquad::Coefficients MultiChannelBiquad::makeHighShelf (double sample_rate, float frequency, float q, float gain_factor)
+{
+    const auto a = juce::jmax (0.0, std::sqrt (static_cast<double> (gain_factor)));
+    const auto a_minus_1 = a - 1.0;
+    const auto a_plus_1 = a + 1.0;
+    const auto omega = (2.0 * juce::MathConstants<double>::pi * juce::jmax (static_cast<double> (frequency), 2.0)) / sample_rate;
+    const auto cos_omega = std::cos (omega);
+    const auto beta = std::sin (omega) * std::sqrt (a) / q;
+    const auto a_minus_1_cos_omega = a_minus_1 * cos_omega;
+
+    const auto a0 = a_plus_1 - a_minus_1_cos_omega + beta;
+
+    Coefficients c;
+    c.b0 = static_cast<float> (a * (a_plus_1 + a_minus_1_cos_omega + beta) / a0);
+    c.b1 = static_cast<float> (a * -2.0 * (a_minus_1 + a_plus_1 * cos_omega) / a0);
+    c.b2 = static_cast<float> (a * (a_plus_1 + a_minus_1_cos_omega - beta) / a0);
+    c.a1 = static_cast<float> (2.0 * (a_minus_1 - a_plus_1 * cos_omega) / a0);
+    c.a2 = static_cast<float> ((a_plus_1 - a_minus_1_cos_omega - beta) / a0);
+    return c;
+}
+
+//==============================================================================
+void MultiChannelBiquad::prepare (int num_channels)
+{
+    num_channels_ = num_channels;
+    groups_.resize (static_cast<size_t> (juce::jmax (1, (num_channels + LANES - 1) / LANES)));
+
+    // Unused lanes get all zero coefficients so they stay silent
+    for (auto& group : groups_)
+    {
+        group.b0 = group.b1 = group.b2 = group.a1 = group.a2 = Vec::expand (0.0f);
+    }
+
+    reset();
+}
+
+void MultiChannelBiquad::reset()
+{
+    for (auto& group : groups_)
+    {
+        group.s1 = Vec::expand (0.0f);
+        group.s2 = Vec::expand (0.0f);
+    }
+}
+
+void MultiChannelBiquad::setCoefficients (int channel, const Coefficients& coefficients)
+{
+    jassert (juce::isPositiveAndBelow (channel, num_channels_));
+
+    auto& group = groups_[static_cast<size_t> (channel / LANES)];
+    auto lane = static_cast<size_t> (channel % LANES);
+    group.b0.set (lane, coefficients.b0);
+    group.b1.set (lane, coefficients.b1);
+    group.b2.set (lane, coefficients.b2);
+    group.a1.set (lane, coefficients.a1);
+    group.a2.set (lane, coefficients.a2);
+}
+
+void MultiChannelBiquad::process (juce::AudioBuffer<float>& buffer)
+{
+    process (buffer.getArrayOfWritePointers(), juce::jmin (num_channels_, buffer.getNumChannels()), buffer.getNumSamples());
+}
+
+void MultiChannelBiquad::process (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    switch (num_channels)
+    {
+        case 0:
+            break;
+        case 1:
+            processFixed<1> (channels, num_samples);
+            break;
+        case 2:
+            processFixed<2> (channels, num_samples);
+            break;
+        default:
+            processLanes (channels, num_channels, num_samples);
+            break;
+    }
+}
+
+void MultiChannelBiquad::processLanes (float* const* channels, int num_channels, int num_samples)
+{
+    alignas (Vec::SIMDRegisterSize) float frame[LANES] = {};
+
+    for (int first = 0; first < num_channels; first += LANES)
+    {
+        auto& group = groups_[static_cast<size_t> (first / LANES)];
+        const int used_lanes = juce::jmin (LANES, num_channels - first);
+        float* const* group_channels = channels + first;
+
+        Vec s1 = group.s1;
+        Vec s2 = group.s2;
+
+        for (int i = 0; i < num_samples; ++i)
+        {
+            for (int lane = 0; lane < used_lanes; ++lane)
+                frame[lane] = group_channels[lane][i];
+
+            const Vec in = Vec::fromRawArray (frame);
+            const Vec out = group.b0 * in + s1;
+            s1 = group.b1 * in - group.a1 * out + s2;
+            s2 = group.b2 * in - group.a2 * out;
+            out.copyToRawArray (frame);
+
+            for (int lane = 0; lane < used_lanes; ++lane)
+                group_channels[lane][i] = frame[lane];
+        }
+
+        group.s1 = s1;
+        group.s2 = s2;
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// A biquad filter with its own coefficients and state for every channel of a bus.
+//
+// Coefficients and state are stored structure-of-arrays, one SIMD register per variable
+// holding one channel per lane, so any number of channels is processed a register at a
+// time and the cost grows linearly with the layout. Mono and stereo, by far the most common
+// layouts, get kernels specialised at compile time that keep the state in registers.
+//
+// The filter uses the same transposed direct form II as juce::dsp::IIR::Filter and the
+// coefficient helpers match the juce::dsp::IIR::Coefficients functions of the same name.
+class MultiChannelBiquad
+{
+public:
+    struct Coefficients
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    static Coefficients makeHighPass (double sample_rate, float frequency, float q);
+    static Coefficients makeBandPass (double sample_rate, float frequency, float q);
+    static Coefficients makeHighShelf (double sample_rate, float frequency, float q, float gain_factor);
+
+    // Allocates state for num_channels channels, call from prepareToPlay().
+    void prepare (int num_channels);
+    void reset();
+
+    int getNumChannels() const { return num_channels_; }
+    // Bytes of coefficient and state memory held for the prepared channels
+    size_t getMemoryBytes() const { return groups_.size() * sizeof (LaneGroup); }
+    void setCoefficients (int channel, const Coefficients& coefficients);
+
+    void process (juce::AudioBuffer<float>& buffer);
+    void process (float* const* channels, int num_channels, int num_samples);
+
+private:
+    typedef juce::dsp::SIMDRegister<float> Vec;
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+
+    struct LaneGroup
+    {
+        Vec b0, b1, b2, a1, a2;
+        Vec s1, s2;
+    };
+
+    template <int NumChannels>
+    void processFixed (float* const* channels, int num_samples);
+    void processLanes (float* const* channels, int num_channels, int num_samples);
+
+    std::vector<LaneGroup> groups_;
+    int num_channels_ = 0;
+};
+
+template <int NumChannels>
+void MultiChannelBiquad::processFixed (float* const* channels, int num_samples)
+{
+    static_assert (NumChannels <= LANES, "Fixed kernels only cover the first lane group");
+    auto& group = groups_.front();
+
+    float b0[NumChannels], b1[NumChannels], b2[NumChannels], a1[NumChannels], a2[NumChannels];
+    float s1[NumChannels], s2[NumChannels];
+
+    for (int ch = 0; ch < NumChannels; ++ch)
+    {
+        b0[ch] = group.b0.get (static_cast<size_t> (ch));
+        b1[ch] = group.b1.get (static_cast<size_t> (ch));
+        b2[ch] = group.b2.get (static_cast<size_t> (ch));
+        a1[ch] = group.a1.get (static_cast<size_t> (ch));
+        a2[ch] = group.a2.get (static_cast<size_t> (ch));
+        s1[ch] = group.s1.get (static_cast<size_t> (ch));
+        s2[ch] = group.s2.get (static_cast<size_t> (ch));
+    }
+
+    for (int i = 0; i < num_samples; ++i)
+    {
+        for (int ch = 0; ch < NumChannels; ++ch)
+        {
+            const float in = channels[ch][i];
+            const float out = b0[ch] * in + s1[ch];
+            s1[ch] = b1[ch] * in - a1[ch] * out + s2[ch];
+            s2[ch] = b2[ch] * in - a2[ch] * out;
+            channels[ch][i] = out;
+        }
+    }
+
+    for (int ch = 0; ch < NumChannels; ++ch)
+    {
+        group.s1.set (static_cast<size_t> (ch), s1[ch]);
+        group.s2.set (static_cast<size_t> (ch), s2[ch]);
+    }
+}
+
+// A MultiChannelBiquad as a stage of a StageChain
+struct BiquadStage
+{
+    MultiChannelBiquad& filter;
+
+    void process (float* const* channels, int num_channels, int num_samples) { filter.process (channels, juce::jmin (num_channels, filter.getNumChannels()), num_samples); }
+};
@@ -0,0 +1,181 @@
+#include "Oversampler.h"
+
+// The outer stage sees the full host bandwidth, the inner ones only the bottom quarter of
+// their band and get away with a wide transition.
+constexpr int OUTER_IIR_COEFFICIENTS = 8;
+constexpr double OUTER_IIR_TRANSITION = 0.05;
+constexpr int INNER_IIR_COEFFICIENTS = 4;
+constexpr double INNER_IIR_TRANSITION = 0.2;
+
+constexpr int OUTER_FIR_TAPS = 32;
+constexpr double OUTER_FIR_BETA = 8.0;
+constexpr int INNER_FIR_TAPS = 12;
+constexpr double INNER_FIR_BETA = 6.0;
+
+void Oversampler::prepare (int num_channels, int max_block_size, int factor, FilterType filter_type)
+{
+    jassert (factor == 1 || factor == 2 || factor == 4 || factor == 8);
+
+    factor_ = factor;
+    num_stages_ = factor == 8 ? 3 : (factor == 4 ? 2 : (factor == 2 ? 1 : 0));
+    prepared_stages_ = num_stages_;
+    filter_type_ = filter_type;
+    max_block_size_ = juce::jmax (1, max_block_size);
+
+    for (int stage = 0; stage < MAX_STAGES; ++stage)
+    {
+        stage_buffers_[stage].setSize (num_channels, max_block_size_ * (2 << stage));
+    }
+    host_pointers_.resize (static_cast<size_t> (num_channels));
+
+    const auto outer_coefficients = HalfBandIir::designCoefficients (OUTER_IIR_COEFFICIENTS, OUTER_IIR_TRANSITION);
+    const auto inner_coefficients = HalfBandIir::designCoefficients (INNER_IIR_COEFFICIENTS, INNER_IIR_TRANSITION);
+    const auto outer_kernel = HalfBandFir::designKernel (OUTER_FIR_TAPS, OUTER_FIR_BETA);
+    const auto inner_kernel = HalfBandFir::designKernel (INNER_FIR_TAPS, INNER_FIR_BETA);
+    double latency = 0.0;
+    stage_latencies_.fill (0.0);
+
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        // Stage delays are in samples at twice the stage input rate
+        const double to_host_samples = 1.0 / (2 << stage);
+
+        if (filter_type == FilterType::lowLatency)
+        {
+            const auto& coefficients = stage == 0 ? outer_coefficients : inner_coefficients;
+            iir_up_[stage].setCoefficients (coefficients);
+            iir_up_[stage].prepare (num_channels);
+            iir_down_[stage].setCoefficients (coefficients);
+            iir_down_[stage].prepare (num_channels);
+            stage_latencies_[stage] = (iir_up_[stage].getUpsamplingDelay() + iir_down_[stage].getDownsamplingDelay()) * to_host_samples;
+        }
+        else
+        {
+            const auto& kernel = stage == 0 ? outer_kernel : inner_kernel;
+            fir_up_[stage].setKernel (kernel);
+            fir_up_[stage].prepare (num_channels);
+            fir_down_[stage].setKernel (kernel);
+            fir_down_[stage].prepare (num_channels);
+            stage_latencies_[stage] = (fir_up_[stage].getDelay() + fir_down_[stage].getDelay()) * to_host_samples;
+        }
+
+        latency += stage_latencies_[stage];
+    }
+
+    latency_ = static_cast<float> (latency);
+}
+
+void Oversampler::setActiveFactor (int factor)
+{
+    jassert (factor == 1 || factor == 2 || factor == 4 || factor == 8);
+
+    const int num_stages = juce::jmin (prepared_stages_, factor == 8 ? 3 : (factor == 4 ? 2 : (factor == 2 ? 1 : 0)));
+
+    // Stages that were skipped still hold the signal from before
+    for (int stage = num_stages_; stage < num_stages; ++stage)
+    {
+        iir_up_[stage].reset();
+        iir_down_[stage].reset();
+        fir_up_[stage].reset();
+        fir_down_[stage].reset();
+    }
+
+    num_stages_ = num_stages;
+    factor_ = 1 << num_stages;
+
+    double latency = 0.0;
+    for (int stage = 0; stage < num_stages_; ++stage)
+        latency += stage_latencies_[stage];
+    latency_ = static_cast<float> (latency);
+}
+
+float Oversampler::getStateDifference (int num_channels) const
+{
+    float difference = 0.0f;
+
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        for (int channel = 1; channel < num_channels; ++channel)
+        {
+            if (filter_type_ == FilterType::lowLatency)
+                difference = juce::jmax (difference, iir_up_[stage].getStateDifference (channel), iir_down_[stage].getStateDifference (channel));
+            else
+                difference = juce::jmax (difference, fir_up_[stage].getStateDifference (channel), fir_down_[stage].getStateDifference (channel));
+        }
+    }
+    return difference;
+}
+
+void Oversampler::copyFirstChannelState (int num_channels)
+{
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        for (int channel = 1; channel < num_channels; ++channel)
+        {
+            if (filter_type_ == FilterType::lowLatency)
+            {
+                iir_up_[stage].copyFirstChannelState (channel);
+                iir_down_[stage].copyFirstChannelState (channel);
+            }
+            else
+            {
+                fir_up_[stage].copyFirstChannelState (channel);
+                fir_down_[stage].copyFirstChannelState (channel);
+            }
+        }
+    }
+}
+
+void Oversampler::reset()
+{
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        iir_up_[stage].reset();
+        iir_down_[stage].reset();
+        fir_up_[stage].reset();
+        fir_down_[stage].reset();
+    }
+}
+
+juce::dsp::AudioBlock<float> Oversampler::upsample (float* const* channels, int num_channels, int num_samples)
+{
+    const float* const* stage_input = channels;
+    int stage_samples = num_samples;
+
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        auto* const* stage_output = stage_buffers_[stage].getArrayOfWritePointers();
+
+        if (filter_type_ == FilterType::lowLatency)
+            iir_up_[stage].upsample (stage_input, stage_output, num_channels, stage_samples);
+        else
+            fir_up_[stage].upsample (stage_input, stage_output, num_channels, stage_samples);
+
+        stage_input = stage_output;
+        stage_samples *= 2;
+    }
+
+    return juce::dsp::AudioBlock<float> (stage_buffers_[num_stages_ - 1].getArrayOfWritePointers(),
+                                         static_cast<size_t> (num_channels),
+                                         0,
+                                         static_cast<size_t> (stage_samples));
+}
+
+void Oversampler::downsample (float* const* channels, int num_channels, int num_samples)
+{
+    int stage_samples = num_samples << (num_stages_ - 1);
+
+    for (int stage = num_stages_ - 1; stage >= 0; --stage)
+    {
+        // Each stage writes into the buffer of the stage below, which has been used up already
+        const float* const* stage_input = stage_buffers_[stage].getArrayOfReadPointers();
+        auto* const* stage_output = stage == 0 ? channels : stage_buffers_[stage - 1].getArrayOfWritePointers();
+
+        if (filter_type_ == FilterType::lowLatency)
+            iir_down_[stage].downsample (stage_input, stage_output, num_channels, stage_samples);
+        else
+            fir_down_[stage].downsample (stage_input, stage_output, num_channels, stage_samples);
+
+        stage_samples /= 2;
+    }
+}
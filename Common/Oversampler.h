@@ -0,0 +1,110 @@
+#pragma once
+
+#include <HalfBandFilter.h>
+#include <JuceHeader.h>
+
+// Runs a nonlinear stage at 2, 4 or 8 times the host sample rate.
+//
+// The signal goes up and back down through a cascade of half-band stages, either the
+// polyphase IIR ones for a low, slightly frequency dependent latency, or the linear phase FIR
+// ones. The first stage next to the host rate is the steep one, the inner stages only have
+// to reject the images of an already band limited signal and use much shorter filters.
+//
+// Only the stage that creates new harmonics should run oversampled, linear filters and
+// modulation stay at the host rate. All buffers are allocated for MAX_FACTOR in prepare(),
+// so later calls with another factor or filter type only reconfigure the filters.
+class Oversampler
+{
+public:
+    enum class FilterType
+    {
+        lowLatency = 0,
+        linearPhase
+    };
+
+    static constexpr int MAX_FACTOR = 8;
+
+    // factor is 1, 2, 4 or 8, 1 bypasses the resampling altogether. Allocates, so call it
+    // from prepareToPlay() or with processing suspended.
+    void prepare (int num_channels, int max_block_size, int factor, FilterType filter_type);
+    void reset();
+
+    // Runs only the first stages of the prepared cascade, e.g. to save CPU under load. factor
+    // is at most the prepared one. Realtime safe, it changes the latency and clears the stages
+    // that come back.
+    void setActiveFactor (int factor);
+
+    // Largest difference between the filter state of channel 0 and that of channels 1 to
+    // num_channels - 1
+    float getStateDifference (int num_channels) const;
+    // Gives channels 1 to num_channels - 1 the filter state of channel 0, so channel 0 can be
+    // processed alone for all of them and they can carry on from it later
+    void copyFirstChannelState (int num_channels);
+
+    int getFactor() const { return factor_; }
+    int getPreparedFactor() const { return 1 << prepared_stages_; }
+    FilterType getFilterType() const { return filter_type_; }
+    // Round trip delay of the resampling filters, in host samples
+    float getLatencySamples() const { return latency_; }
+
+    // Calls process_oversampled (juce::dsp::AudioBlock<float>& block, int first_sample) on the
+    // first num_channels channels of buffer at the oversampled rate, in chunks of at most the
+    // prepared block size. first_sample is where the chunk starts in buffer, in host samples.
+    template <typename Function>
+    void process (juce::AudioBuffer<float>& buffer, int num_channels, Function&& process_oversampled);
+    // The same on num_channels planar channels of num_samples samples
+    template <typename Function>
+    void process (float* const* channels, int num_channels, int num_samples, Function&& process_oversampled);
+
+private:
+    static constexpr int MAX_STAGES = 3;
+
+    juce::dsp::AudioBlock<float> upsample (float* const* channels, int num_channels, int num_samples);
+    void downsample (float* const* channels, int num_channels, int num_samples);
+
+    int factor_ = 1;
+    int num_stages_ = 0;
+    int prepared_stages_ = 0;
+    FilterType filter_type_ = FilterType::lowLatency;
+    int max_block_size_ = 0;
+    float latency_ = 0.0f;
+    // Round trip delay each stage adds, in host samples
+    std::array<double, MAX_STAGES> stage_latencies_ {};
+
+    std::array<HalfBandIir, MAX_STAGES> iir_up_;
+    std::array<HalfBandIir, MAX_STAGES> iir_down_;
+    std::array<HalfBandFir, MAX_STAGES> fir_up_;
+    std::array<HalfBandFir, MAX_STAGES> fir_down_;
+
+    // Signal at 2, 4 and 8 times the host rate
+    std::array<juce::AudioBuffer<float>, MAX_STAGES> stage_buffers_;
+    std::vector<float*> host_pointers_;
+};
+
+template <typename Function>
+void Oversampler::process (juce::AudioBuffer<float>& buffer, int num_channels, Function&& process_oversampled)
+{
+    process (buffer.getArrayOfWritePointers(), num_channels, buffer.getNumSamples(), std::forward<Function> (process_oversampled));
+}
+
+template <typename Function>
+void Oversampler::process (float* const* channels, int num_channels, int num_samples, Function&& process_oversampled)
+{
+    if (num_stages_ == 0)
+    {
+        auto block = juce::dsp::AudioBlock<float> (channels, static_cast<size_t> (num_channels), 0, static_cast<size_t> (num_samples));
+        process_oversampled (block, 0);
+        return;
+    }
+
+    for (int first_sample = 0; first_sample < num_samples; first_sample += max_block_size_)
+    {
+        const int chunk_size = juce::jmin (max_block_size_, num_samples - first_sample);
+        for (int channel = 0; channel < num_channels; ++channel)
+            host_pointers_[static_cast<size_t> (channel)] = channels[channel] + first_sample;
+
+        auto block = upsample (host_pointers_.data(), num_channels, chunk_size);
+        process_oversampled (block, first_sample);
+        downsample (host_pointers_.data(), num_channels, chunk_size);
+    }
+}
@@ -0,0 +1,293 @@
+#include "PresetBank.h"
+
+namespace
+{
+    const char BANK_MAGIC[4] = { 'M', 'H', 'P', 'B' };
+    constexpr juce::uint32 BANK_VERSION = 1;
+
+    // Bounds checked little endian reader over a memory mapped bank file.
+    class BankReader
+    {
+    public:
+        BankReader (const void* data, size_t size) : data_ (static_cast<const juce::uint8*> (data)), size_ (size) {}
+
+        bool readBytes (void* dest, size_t num_bytes)
+        {
+            if (failed_ || position_ + num_bytes > size_)
+            {
+                failed_ = true;
+                return false;
+            }
+            std::memcpy (dest, data_ + position_, num_bytes);
+            position_ += num_bytes;
+            return true;
+        }
+
+        juce::uint32 readUint32()
+        {
+            juce::uint8 bytes[4] = {};
+            readBytes (bytes, sizeof (bytes));
+            return juce::ByteOrder::littleEndianInt (bytes);
+        }
+
+        float readFloat()
+        {
+            juce::uint32 bits = readUint32();
+            float value;
+            std::memcpy (&value, &bits, sizeof (value));
+            return value;
+        }
+
+        juce::String readShortString()
+        {
+            juce::uint8 length = 0;
+            readBytes (&length, 1);
+            char text[256] = {};
+            readBytes (text, length);
+            return failed_ ? juce::String() : juce::String::fromUTF8 (text, length);
+        }
+
+        bool failed() const { return failed_; }
+
+    private:
+        const juce::uint8* data_;
+        size_t size_;
+        size_t position_ = 0;
+        bool failed_ = false;
+    };
+
+    void writeShortString (juce::OutputStream& out, const juce::String& text)
+    {
+        auto utf8 = text.toUTF8();
+        auto length = static_cast<int> (juce::jmin<size_t> (utf8.sizeInBytes() - 1, 255));
+        out.writeByte (static_cast<char> (length));
+        out.write (utf8.getAddress(), static_cast<size_t> (length));
+    }
+}
+
+//==============================================================================
+PresetBank::PresetBank (juce::AudioProcessorValueTreeState& apvts, const juce::StringArray& parameter_ids)
+    : apvts_ (apvts), parameter_ids_ (parameter_ids)
+{
+    jassert (parameter_ids_.size() <= MAX_SNAPSHOT_PARAMETERS);
+}
+
+bool PresetBank::loadFromFile (const juce::File& file)
+{
+    juce::MemoryMappedFile mapped (file, juce::MemoryMappedFile::readOnly);
+
+    if (mapped.getData() == nullptr)
+        return false;
+
+    BankReader reader (mapped.getData(), mapped.getSize());
+
+    char magic[4] = {};
+    reader.readBytes (magic, sizeof (magic));
+    if (reader.failed() || std::memcmp (magic, BANK_MAGIC, sizeof (magic)) != 0)
+        return false;
+
+    if (reader.readUint32() != BANK_VERSION)
+        return false;
+
+    auto num_file_parameters = reader.readUint32();
+    auto num_presets = reader.readUint32();
+
+    // Map every parameter in the file to its index in our layout, -1 for unknown ones
+    std::vector<int> parameter_map;
+    for (juce::uint32 i = 0; i < num_file_parameters && ! reader.failed(); ++i)
+        parameter_map.push_back (parameter_ids_.indexOf (reader.readShortString()));
+
+    std::vector<ParameterSnapshot> snapshots;
+    for (juce::uint32 i = 0; i < num_presets && ! reader.failed(); ++i)
+    {
+        auto snapshot = makeDefaultSnapshot();
+        snapshot.name = reader.readShortString();
+
+        for (auto index : parameter_map)
+        {
+            float value = reader.readFloat();
+            if (index < 0)
+                continue;
+
+            auto* parameter = apvts_.getParameter (parameter_ids_[index]);
+            snapshot.values[static_cast<size_t> (index)] = parameter->getNormalisableRange().getRange().clipValue (value);
+        }
+        snapshots.push_back (snapshot);
+    }
+
+    if (reader.failed() || snapshots.empty())
+        return false;
+
+    snapshots_ = std::move (snapshots);
+    return true;
+}
+
+bool PresetBank::saveToFile (const juce::File& file) const
+{
+    file.getParentDirectory().createDirectory();
+    juce::FileOutputStream out (file);
+
+    if (! out.openedOk())
+        return false;
+
+    out.setPosition (0);
+    out.truncate();
+
+    out.write (BANK_MAGIC, sizeof (BANK_MAGIC));
+    out.writeInt (static_cast<int> (BANK_VERSION));
+    out.writeInt (parameter_ids_.size());
+    out.writeInt (size());
+
+    for (const auto& id : parameter_ids_)
+        writeShortString (out, id);
+
+    for (const auto& snapshot : snapshots_)
+    {
+        writeShortString (out, snapshot.name);
+        for (int i = 0; i < parameter_ids_.size(); ++i)
+            out.writeFloat (snapshot.values[static_cast<size_t> (i)]);
+    }
+
+    return true;
+}
+
+void PresetBank::addPreset (const juce::String& name, const juce::StringPairArray& values)
+{
+    auto snapshot = makeDefaultSnapshot();
+    snapshot.name = name;
+
+    for (int i = 0; i < parameter_ids_.size(); ++i)
+    {
+        if (! values.containsKey (parameter_ids_[i]))
+            continue;
+
+        auto* parameter = apvts_.getParameter (parameter_ids_[i]);
+        auto value = values[parameter_ids_[i]].getFloatValue();
+        snapshot.values[static_cast<size_t> (i)] = parameter->getNormalisableRange().getRange().clipValue (value);
+    }
+
+    snapshots_.push_back (snapshot);
+}
+
+juce::File PresetBank::getDefaultBankFile()
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+        .getChildFile (JucePlugin_Manufacturer)
+        .getChildFile (JucePlugin_Name ".mhpb");
+}
+
+ParameterSnapshot PresetBank::makeDefaultSnapshot() const
+{
+    ParameterSnapshot snapshot;
+    snapshot.name = "Default";
+
+    for (int i = 0; i < parameter_ids_.size(); ++i)
+    {
+        auto* parameter = apvts_.getParameter (parameter_ids_[i]);
+        jassert (parameter != nullptr);
+        snapshot.values[static_cast<size_t> (i)] = parameter->convertFrom0to1 (parameter->getDefaultValue());
+    }
+
+    return snapshot;
+}
+
+//==============================================================================
+ProgramSwitcher::ProgramSwitcher (juce::AudioProcessorValueTreeState& apvts, const juce::StringArray& parameter_ids)
+    : apvts_ (apvts), parameter_ids_ (parameter_ids), bank_ (apvts, parameter_ids)
+{
+    for (int i = 0; i < parameter_ids_.size(); ++i)
+    {
+        raw_values_[static_cast<size_t> (i)] = apvts_.getRawParameterValue (parameter_ids_[i]);
+        current_[static_cast<size_t> (i)] = raw_values_[static_cast<size_t> (i)]->load();
+    }
+}
+
+ProgramSwitcher::~ProgramSwitcher()
+{
+    cancelPendingUpdate();
+}
+
+void ProgramSwitcher::setCurrentProgram (int index)
+{
+    if (! juce::isPositiveAndBelow (index, bank_.size()))
+        return;
+
+    current_program_ = index;
+    synced_ = false;
+    pending_ = &bank_.getSnapshot (index);
+    triggerAsyncUpdate();
+}
+
+const juce::String ProgramSwitcher::getProgramName (int index) const
+{
+    if (! juce::isPositiveAndBelow (index, bank_.size()))
+        return {};
+
+    return bank_.getSnapshot (index).name;
+}
+
+void ProgramSwitcher::changeProgramName (int index, const juce::String& name)
+{
+    if (juce::isPositiveAndBelow (index, bank_.size()))
+        bank_.setName (index, name);
+}
+
+void ProgramSwitcher::prepare (double sample_rate)
+{
+    fade_length_ = static_cast<int> (sample_rate * CROSSFADE_SECONDS);
+}
+
+int ProgramSwitcher::readParameters (ParameterValues& values, int num_samples)
+{
+    const auto num_parameters = static_cast<size_t> (parameter_ids_.size());
+
+    for (size_t i = 0; i < num_parameters; ++i)
+        values[i] = raw_values_[i]->load();
+
+    if (auto* target = pending_.exchange (nullptr))
+    {
+        target_ = target;
+        source_ = current_;
+        fade_position_ = 0;
+    }
+
+    if (target_ != nullptr)
+    {
+        if (fade_position_ < fade_length_)
+            num_samples = juce::jmin (num_samples, FADE_STEP);
+
+        fade_position_ = juce::jmin (fade_position_ + num_samples, fade_length_);
+        float amount = fade_length_ > 0 ? static_cast<float> (fade_position_) / static_cast<float> (fade_length_) : 1.0f;
+
+        for (size_t i = 0; i < num_parameters; ++i)
+            values[i] = source_[i] + amount * (target_->values[i] - source_[i]);
+
+        // Keep overriding the parameters until the message thread has caught up, otherwise
+        // the old values would be heard for a moment after the crossfade.
+        if (fade_position_ >= fade_length_ && synced_.load() && pending_.load() == nullptr)
+            target_ = nullptr;
+    }
+
+    current_ = values;
+    return num_samples;
+}
+
+void ProgramSwitcher::readParametersForBlock (ParameterValues& values, int num_samples)
+{
+    int first_sample = readParameters (values, num_samples);
+    while (first_sample < num_samples)
+        first_sample += readParameters (values, num_samples - first_sample);
+}
+
+void ProgramSwitcher::handleAsyncUpdate()
+{
+    const auto& snapshot = bank_.getSnapshot (current_program_.load());
+
+    for (int i = 0; i < parameter_ids_.size(); ++i)
+    {
+        auto* parameter = apvts_.getParameter (parameter_ids_[i]);
+        parameter->setValueNotifyingHost (parameter->convertTo0to1 (snapshot.values[static_cast<size_t> (i)]));
+    }
+
+    synced_ = true;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <MicroBlocks.h>
+
+// Upper bound for the number of parameters a preset can hold. Snapshots are plain fixed
+// size arrays so they can be handed over to the audio thread without allocating.
+constexpr int MAX_SNAPSHOT_PARAMETERS = 32;
+
+typedef std::array<float, MAX_SNAPSHOT_PARAMETERS> ParameterValues;
+
+// A preset compiled against the parameter layout of one processor. Values are stored as
+// plain (denormalised) parameter values in the order of the processor's parameter id list.
+struct ParameterSnapshot
+{
+    juce::String name;
+    ParameterValues values {};
+};
+
+// A bank of presets, loaded from a compact binary bank file.
+//
+// Bank file layout (all integers and floats little endian):
+//   char[4]  magic "MHPB"
+//   uint32   version
+//   uint32   number of parameters (P)
+//   uint32   number of presets (N)
+//   P times  { uint8 id length, id characters }
+//   N times  { uint8 name length, name characters (UTF-8), float values[P] }
+//
+// The parameter ids in the file are matched against the processor's ids when the bank is
+// loaded, so a bank keeps working if parameters are added or reordered. Parameters missing
+// from the file get their default value and all values are clamped to the parameter range.
+class PresetBank
+{
+public:
+    PresetBank (juce::AudioProcessorValueTreeState& apvts, const juce::StringArray& parameter_ids);
+
+    bool loadFromFile (const juce::File& file);
+    bool saveToFile (const juce::File& file) const;
+
+    // Compiles a preset from (parameter id, plain value) pairs and appends it to the bank.
+    void addPreset (const juce::String& name, const juce::StringPairArray& values);
+
+    int size() const { return static_cast<int> (snapshots_.size()); }
+    const ParameterSnapshot& getSnapshot (int index) const { return snapshots_[static_cast<size_t> (index)]; }
+    void setName (int index, const juce::String& name) { snapshots_[static_cast<size_t> (index)].name = name; }
+
+    // Bank file looked for when a processor is created, one per plugin.
+    static juce::File getDefaultBankFile();
+
+private:
+    ParameterSnapshot makeDefaultSnapshot() const;
+
+    juce::AudioProcessorValueTreeState& apvts_;
+    juce::StringArray parameter_ids_;
+    std::vector<ParameterSnapshot> snapshots_;
+};
+
+// Switches between the presets of a bank from the audio thread.
+//
+// setCurrentProgram() only publishes a pointer to a precompiled snapshot. The audio thread
+// picks it up in readParameters() at the start of the next block and ramps every parameter
+// from the values it last read to the snapshot over CROSSFADE_SECONDS. While the crossfade
+// runs, readParameters() hands out the values for FADE_STEP samples at a time, so it takes
+// as long and moves in as small steps with any block size. The processor's parameters are
+// updated asynchronously on the message thread so the host and the editor follow along,
+// switching itself never blocks or allocates.
+class ProgramSwitcher : private juce::AsyncUpdater
+{
+public:
+    ProgramSwitcher (juce::AudioProcessorValueTreeState& apvts, const juce::StringArray& parameter_ids);
+    ~ProgramSwitcher() override;
+
+    PresetBank& getBank() { return bank_; }
+    int getNumPrograms() const { return juce::jmax (1, bank_.size()); }
+    int getCurrentProgram() const { return current_program_.load(); }
+    void setCurrentProgram (int index);
+    const juce::String getProgramName (int index) const;
+    void changeProgramName (int index, const juce::String& name);
+
+    static constexpr double CROSSFADE_SECONDS = 0.03;
+    static constexpr int FADE_STEP = MicroBlocks::SIZE;
+
+    void prepare (double sample_rate);
+    // Audio thread: reads the current parameter values, with any program crossfade applied,
+    // and returns for how many of the next num_samples samples they hold. That is all of them
+    // outside of a crossfade and at most FADE_STEP during one, process those samples and read
+    // again for the rest of the block.
+    int readParameters (ParameterValues& values, int num_samples);
+    // Audio thread: reads the values the parameters have at the end of the next num_samples
+    // samples, for a path that cannot split its block
+    void readParametersForBlock (ParameterValues& values, int num_samples);
+
+private:
+    void handleAsyncUpdate() override;
+
+    juce::AudioProcessorValueTreeState& apvts_;
+    juce::StringArray parameter_ids_;
+    std::array<std::atomic<float>*, MAX_SNAPSHOT_PARAMETERS> raw_values_ {};
+    PresetBank bank_;
+
+    // Set from whichever thread the host calls setCurrentProgram() on, read on others
+    std::atomic<int> current_program_ { 0 };
+    std::atomic<const ParameterSnapshot*> pending_ { nullptr };
+    std::atomic<bool> synced_ { true };
+
+    // Audio thread state
+    const ParameterSnapshot* target_ = nullptr;
+    ParameterValues source_ {};
+    ParameterValues current_ {};
+    int fade_position_ = 0;
+    int fade_length_ = 0;
+};
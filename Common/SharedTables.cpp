@@ -0,0 +1,59 @@
+#include "SharedTables.h"
+
+namespace
+{
+    typedef std::tuple<int, int, double> TableKey;
+
+    // Weak references, a table lives exactly as long as some instance holds on to it
+    std::map<TableKey, std::weak_ptr<const std::vector<float>>>& getRegistry()
+    {
+        static std::map<TableKey, std::weak_ptr<const std::vector<float>>> registry;
+        return registry;
+    }
+
+    juce::CriticalSection& getRegistryLock()
+    {
+        static juce::CriticalSection lock;
+        return lock;
+    }
+}
+
+SharedTables::Table SharedTables::get (Type type, int size, double sample_rate)
+{
+    jassert (size > 1);
+
+    const TableKey key { static_cast<int> (type), size, sample_rate };
+    const juce::ScopedLock lock (getRegistryLock());
+    auto& registry = getRegistry();
+
+    if (auto table = registry[key].lock())
+        return table;
+
+    Table table = std::make_shared<const std::vector<float>> (build (type, size, sample_rate));
+    registry[key] = table;
+
+    // Drop the entries of tables nobody uses anymore
+    for (auto it = registry.begin(); it != registry.end();)
+        it = it->second.expired() ? registry.erase (it) : std::next (it);
+
+    return table;
+}
+
+std::vector<float> SharedTables::build (Type type, int size, double /*sample_rate*/)
+{
+    std::vector<float> values (static_cast<size_t> (size) + 1);
+
+    switch (type)
+    {
+        case Type::sine:
+            for (int i = 0; i < size; ++i)
+            {
+                const auto x = juce::jmap (static_cast<float> (i), 0.0f, static_cast<float> (size - 1), -juce::MathConstants<float>::pi, juce::MathConstants<float>::pi);
+                values[static_cast<size_t> (i)] = std::sin (x);
+            }
+            break;
+    }
+
+    values.back() = values[static_cast<size_t> (size) - 1];
+    return values;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Process wide registry of read-only lookup tables.
+//
+// Plugin instances in the same process ask for a table by type, size and sample rate and get
+// a reference counted pointer to one shared copy. The table is built by the first instance
+// that needs it and freed when the last one lets go of it, so per instance memory and
+// prepareToPlay() time do not grow with the number of instances. Tables never change once
+// built and can be read from any thread without locking.
+class SharedTables
+{
+public:
+    typedef std::shared_ptr<const std::vector<float>> Table;
+
+    enum class Type
+    {
+        // sin (x) over [-pi, pi] in size points, plus a copy of the last point so linear
+        // interpolation can always read one point ahead
+        sine = 0
+    };
+
+    // Locks and may allocate, call from prepareToPlay() and keep the result. sample_rate is
+    // only part of the key for tables that depend on it.
+    static Table get (Type type, int size, double sample_rate = 0.0);
+
+private:
+    static std::vector<float> build (Type type, int size, double sample_rate);
+};
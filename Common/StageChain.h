@@ -0,0 +1,122 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <MicroBlocks.h>
+
+// A chain of DSP stages fixed at compile time, run one micro block at a time, see MicroBlocks.
+//
+// A stage is any type with void process (float* const* channels, int num_channels, int num_samples)
+// that processes the channels in place. The chain keeps its stages in a tuple and calls them with a
+// fold expression, so there is no virtual call or loop over a list of stages, and the compiler
+// can inline small stages into the micro block loop. Stages usually refer to state owned by the
+// processor, e.g. BiquadStage, so they are cheap to make for every block:
+//
+//     makeStageChain (BiquadStage { shelf_ }, BiquadStage { high_pass_ }, ReverbStage { reverb_ })
+//         .process (channels, num_channels, num_samples, micro_channels_);
+//
+// Stages that work sample by sample go into one SampleStages instead, which runs all of them in
+// a single loop over each channel.
+template <typename... Stages>
+class StageChain
+{
+public:
+    explicit StageChain (Stages... stages)
+        : stages_ (std::move (stages)...)
+    {
+    }
+
+    template <size_t Index>
+    auto& get() { return std::get<Index> (stages_); }
+
+    // Runs every stage on the channels, first to last
+    void processMicroBlock (float* const* channels, int num_channels, int num_samples)
+    {
+        std::apply ([&] (auto&... stages) { (stages.process (channels, num_channels, num_samples), ...); }, stages_);
+    }
+
+    // Runs all stages on one micro block before the next one starts. micro_channels holds
+    // the channel pointers of the micro block and needs room for num_channels, the owner
+    // sizes it in prepare. A juce::AudioBuffer referring to 32 or more channels allocates its
+    // pointer array, so it cannot stand in for it.
+    void process (float* const* channels, int num_channels, int num_samples, std::vector<float*>& micro_channels)
+    {
+        jassert (static_cast<int> (micro_channels.size()) >= num_channels);
+
+        MicroBlocks::forEach (num_samples, [&] (int first_sample, int micro_samples) {
+            for (int channel = 0; channel < num_channels; ++channel)
+                micro_channels[static_cast<size_t> (channel)] = channels[channel] + first_sample;
+            processMicroBlock (micro_channels.data(), num_channels, micro_samples);
+        });
+    }
+
+private:
+    std::tuple<Stages...> stages_;
+};
+
+template <typename... Stages>
+StageChain<Stages...> makeStageChain (Stages... stages)
+{
+    return StageChain<Stages...> (std::move (stages)...);
+}
+
+// Stages with float processSample (float sample) that do not depend on other channels, fused
+// into one loop per channel. The signal passes through all of them in a register, where one
+// stage after the other would store and load every sample once per stage.
+template <typename... Stages>
+class SampleStages
+{
+public:
+    explicit SampleStages (Stages... stages)
+        : stages_ (std::move (stages)...)
+    {
+    }
+
+    void process (float* const* channels, int num_channels, int num_samples)
+    {
+        for (int channel = 0; channel < num_channels; ++channel)
+            process (channels[channel], num_samples);
+    }
+
+    void process (float* samples, int num_samples)
+    {
+        for (int sample = 0; sample < num_samples; ++sample)
+        {
+            float value = samples[sample];
+            std::apply ([&value] (auto&... stages) { ((value = stages.processSample (value)), ...); }, stages_);
+            samples[sample] = value;
+        }
+    }
+
+private:
+    std::tuple<Stages...> stages_;
+};
+
+template <typename... Stages>
+SampleStages<Stages...> makeSampleStages (Stages... stages)
+{
+    return SampleStages<Stages...> (std::move (stages)...);
+}
+
+// Any callable taking the channels as a stage, e.g. a lambda calling a member function of the
+// processor that owns the state
+template <typename Function>
+struct FunctionStage
+{
+    Function function;
+
+    void process (float* const* channels, int num_channels, int num_samples) { function (channels, num_channels, num_samples); }
+};
+
+template <typename Function>
+FunctionStage<Function> makeFunctionStage (Function function)
+{
+    return { std::move (function) };
+}
+
+// A constant gain, as a sample stage
+struct GainStage
+{
+    float gain;
+
+    float processSample (float sample) const { return sample * gain; }
+};
@@ -0,0 +1,119 @@
+#include "WorkerPool.h"
+
+#if JUCE_INTEL
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Tells the CPU this is a spin loop, so it does not speculate ahead or starve a
+    // hyperthread sibling while waiting
+    inline void pause()
+    {
+#if JUCE_INTEL
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    constexpr int JOB_BITS = 16;
+    constexpr juce::uint64 JOB_MASK = (1u << JOB_BITS) - 1;
+
+    juce::uint64 makeClaim (juce::uint32 generation, int num_jobs, int next_job)
+    {
+        return (static_cast<juce::uint64> (generation) << 32) | (static_cast<juce::uint64> (num_jobs) << JOB_BITS) | static_cast<juce::uint64> (next_job);
+    }
+}
+
+class WorkerPool::Worker : public juce::Thread
+{
+public:
+    explicit Worker (WorkerPool& pool) : juce::Thread ("Worker"), pool_ (pool) {}
+
+    void run() override
+    {
+        // The flag is per thread, jobs must see the same denormal handling as the audio thread
+        juce::ScopedNoDenormals no_denormals;
+        auto last_job = juce::Time::getMillisecondCounter();
+
+        while (! threadShouldExit())
+        {
+            if (pool_.runNextJob())
+                last_job = juce::Time::getMillisecondCounter();
+            else if (juce::Time::getMillisecondCounter() - last_job < static_cast<juce::uint32> (IDLE_MILLISECONDS))
+                pause();
+            else
+                sleep (1);
+        }
+    }
+
+private:
+    WorkerPool& pool_;
+};
+
+WorkerPool::WorkerPool() = default;
+
+WorkerPool::~WorkerPool()
+{
+    setNumWorkers (0);
+}
+
+void WorkerPool::setNumWorkers (int num_workers)
+{
+    num_workers = juce::jmax (0, num_workers);
+
+    while (getNumWorkers() > num_workers)
+    {
+        workers_.back()->stopThread (1000);
+        workers_.pop_back();
+    }
+
+    while (getNumWorkers() < num_workers)
+    {
+        workers_.push_back (std::make_unique<Worker> (*this));
+        // 10 is the highest priority, realtime on the platforms that have one
+        workers_.back()->startThread (10);
+    }
+}
+
+void WorkerPool::runJobs (int num_jobs, void* job, Invoker invoker)
+{
+    jassert (num_jobs >= 0 && static_cast<juce::uint64> (num_jobs) <= JOB_MASK);
+
+    job_.store (job, std::memory_order_relaxed);
+    invoker_.store (invoker, std::memory_order_relaxed);
+    num_completed_.store (0, std::memory_order_relaxed);
+    claim_.store (makeClaim (++generation_, num_jobs, 0), std::memory_order_release);
+
+    while (runNextJob())
+    {
+    }
+
+    while (num_completed_.load (std::memory_order_acquire) < num_jobs)
+        pause();
+}
+
+bool WorkerPool::runNextJob()
+{
+    auto claim = claim_.load (std::memory_order_acquire);
+
+    for (;;)
+    {
+        const int num_jobs = static_cast<int> ((claim >> JOB_BITS) & JOB_MASK);
+        const int next_job = static_cast<int> (claim & JOB_MASK);
+        if (next_job >= num_jobs)
+            return false;
+
+        // Read before claiming, a successful claim proves they belong to this generation
+        auto* job = job_.load (std::memory_order_relaxed);
+        auto invoker = invoker_.load (std::memory_order_relaxed);
+
+        if (claim_.compare_exchange_weak (claim, claim + 1, std::memory_order_acquire))
+        {
+            invoker (job, next_job);
+            num_completed_.fetch_add (1, std::memory_order_release);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// A small pool of realtime priority threads that help the audio thread through a number of
+// independent jobs, such as groups of channels that share no state.
+//
+// run() publishes the jobs with one atomic store, works through them together with the
+// workers and spins until the last one has returned, so all work is done when it returns.
+// Nothing on that path locks, allocates or waits for the operating system. Jobs are claimed
+// through a single atomic word that also holds the generation and the job count, so a
+// worker that wakes up late can never run a job of an earlier call.
+//
+// Workers spin between calls, so they are ready within a block. After IDLE_MILLISECONDS
+// without work they fall back to sleeping, then the audio thread simply runs the jobs of
+// the first call on its own while they wake up.
+class WorkerPool
+{
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    // Starts or stops threads until num_workers are running. Not realtime safe, call it from
+    // prepareToPlay() or with processing suspended.
+    void setNumWorkers (int num_workers);
+    int getNumWorkers() const { return static_cast<int> (workers_.size()); }
+
+    // Audio thread: calls job (index) once for every index in [0, num_jobs), on the workers
+    // and on the calling thread, and returns once every call has returned.
+    template <typename Job>
+    void run (int num_jobs, Job& job);
+
+private:
+    class Worker;
+    typedef void (*Invoker) (void* job, int index);
+
+    static constexpr int IDLE_MILLISECONDS = 200;
+
+    void runJobs (int num_jobs, void* job, Invoker invoker);
+    // Claims and runs one job of the current call, false when there was none left
+    bool runNextJob();
+
+    // Generation in the upper 32 bits, job count in the next 16 and next job in the lowest 16
+    std::atomic<juce::uint64> claim_ { 0 };
+    std::atomic<void*> job_ { nullptr };
+    std::atomic<Invoker> invoker_ { nullptr };
+    std::atomic<int> num_completed_ { 0 };
+    juce::uint32 generation_ = 0;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    JUCE_DECLARE_NON_COPYABLE (WorkerPool)
+};
+
+template <typename Job>
+void WorkerPool::run (int num_jobs, Job& job)
+{
+    runJobs (num_jobs, &job, [] (void* context, int index) { (*static_cast<Job*> (context)) (index); });
+}
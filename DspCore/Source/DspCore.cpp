@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+    DspCore.cpp
+    Created: 19 Oct 2026 10:16:52pm
+
+  ==============================================================================
+*/
+
+#include "DspCore.h"
+#include <EasyverbCore.h>
+#include <GramophonyCore.h>
+#include <WaveFolderCore.h>
+
+// The instance behind the opaque handle, one implementation per processor
+struct DspCore
+{
+    virtual ~DspCore() = default;
+
+    virtual void prepare (double sample_rate, int max_block_size, int num_channels) = 0;
+    virtual void reset() = 0;
+    virtual int getNumParameters() const = 0;
+    virtual const CoreParameter& getParameterInfo (int index) const = 0;
+    virtual void setParameter (int index, float value) = 0;
+    virtual float getParameter (int index) const = 0;
+    virtual int getLatencySamples() const = 0;
+    virtual void process (float* const* channels, int num_channels, int num_samples) = 0;
+    virtual bool setCustomTable (const float* /*values*/) { return false; }
+    // Only processors that treat channels differently need the index
+    virtual void setFirstChannel (int /*first_channel*/) {}
+
+    int num_channels = 0;
+    int max_block_size = 0;
+    // Channel pointers of a part of the block between two events, one per prepared channel
+    std::vector<float*> sub_block;
+};
+
+namespace
+{
+    template <typename Core>
+    struct CoreInstance : public DspCore
+    {
+        void prepare (double sample_rate, int block_size, int channels) override { core.prepare (sample_rate, block_size, channels); }
+        void reset() override { core.reset(); }
+        int getNumParameters() const override { return Core::NUM_PARAMETERS; }
+        const CoreParameter& getParameterInfo (int index) const override { return Core::PARAMETERS[index]; }
+        void setParameter (int index, float value) override { core.setParameter (index, value); }
+        float getParameter (int index) const override { return core.getParameter (index); }
+        int getLatencySamples() const override { return core.getLatencySamples(); }
+        void process (float* const* channels, int channel_count, int num_samples) override { core.process (channels, channel_count, num_samples); }
+
+        Core core;
+    };
+
+    // The instance owns the custom curve table, laid out as FoldCurves::Lookup expects
+    struct WaveFolderInstance final : public CoreInstance<WaveFolderCore>
+    {
+        static_assert (DSPCORE_CUSTOM_TABLE_SIZE == FoldCurves::Lookup::TABLE_SIZE + 1, "The table of the C interface has to match the one of the core");
+
+        bool setCustomTable (const float* values) override
+        {
+            std::copy (values, values + DSPCORE_CUSTOM_TABLE_SIZE, table.begin());
+            table.back() = table[DSPCORE_CUSTOM_TABLE_SIZE - 1];
+            core.setCustomTable (table.data());
+            return true;
+        }
+
+        std::array<float, FoldCurves::Lookup::TABLE_SIZE + 2> table {};
+    };
+
+    struct GramophonyInstance final : public CoreInstance<GramophonyCore>
+    {
+        void setFirstChannel (int first_channel) override { core.setFirstChannel (first_channel); }
+    };
+
+    bool isParameterIndex (const DspCore* core, int index)
+    {
+        return core != nullptr && index >= 0 && index < core->getNumParameters();
+    }
+}
+
+int dspcore_get_api_version (void)
+{
+    return DSPCORE_API_VERSION;
+}
+
+DspCore* dspcore_create (DspCoreType type)
+{
+    // No exception may cross the C interface
+    try
+    {
+        switch (type)
+        {
+            case DSPCORE_EASYVERB:
+                return new CoreInstance<EasyverbCore>();
+            case DSPCORE_GRAMOPHONY:
+                return new GramophonyInstance();
+            case DSPCORE_WAVEFOLDER:
+                return new WaveFolderInstance();
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+    }
+    return nullptr;
+}
+
+void dspcore_destroy (DspCore* core)
+{
+    delete core;
+}
+
+int dspcore_prepare (DspCore* core, double sample_rate, int max_block_size, int num_channels)
+{
+    if (core == nullptr || sample_rate <= 0.0 || max_block_size <= 0 || num_channels <= 0)
+        return -1;
+
+    // A failed prepare leaves nothing to process with
+    core->num_channels = 0;
+    core->max_block_size = 0;
+
+    try
+    {
+        core->prepare (sample_rate, max_block_size, num_channels);
+        core->sub_block.resize (static_cast<size_t> (num_channels));
+    }
+    catch (const std::bad_alloc&)
+    {
+        return -1;
+    }
+
+    core->num_channels = num_channels;
+    core->max_block_size = max_block_size;
+    return 0;
+}
+
+void dspcore_reset (DspCore* core)
+{
+    if (core != nullptr && core->num_channels > 0)
+        core->reset();
+}
+
+int dspcore_get_num_parameters (const DspCore* core)
+{
+    return core != nullptr ? core->getNumParameters() : 0;
+}
+
+int dspcore_get_parameter_info (const DspCore* core, int index, DspCoreParameterInfo* info)
+{
+    if (! isParameterIndex (core, index) || info == nullptr)
+        return -1;
+
+    const auto& parameter = core->getParameterInfo (index);
+    info->id = parameter.id;
+    info->name = parameter.name;
+    info->min_value = parameter.min_value;
+    info->max_value = parameter.max_value;
+    info->default_value = parameter.default_value;
+    return 0;
+}
+
+int dspcore_find_parameter (const DspCore* core, const char* id)
+{
+    if (core == nullptr || id == nullptr)
+        return -1;
+
+    for (int index = 0; index < core->getNumParameters(); ++index)
+    {
+        if (std::strcmp (core->getParameterInfo (index).id, id) == 0)
+            return index;
+    }
+    return -1;
+}
+
+void dspcore_set_parameter (DspCore* core, int index, float value)
+{
+    if (isParameterIndex (core, index))
+        core->setParameter (index, value);
+}
+
+float dspcore_get_parameter (const DspCore* core, int index)
+{
+    return isParameterIndex (core, index) ? core->getParameter (index) : 0.0f;
+}
+
+int dspcore_get_parameter_flags (const DspCore* core, int index)
+{
+    if (! isParameterIndex (core, index))
+        return 0;
+
+    const auto& parameter = core->getParameterInfo (index);
+    return (parameter.is_stepped ? DSPCORE_PARAMETER_STEPPED : 0) | (parameter.needs_prepare ? DSPCORE_PARAMETER_NEEDS_PREPARE : 0);
+}
+
+int dspcore_get_latency_samples (const DspCore* core)
+{
+    return core != nullptr && core->num_channels > 0 ? core->getLatencySamples() : 0;
+}
+
+void dspcore_process (DspCore* core, float* const* channels, int num_channels, int num_samples)
+{
+    if (core == nullptr || channels == nullptr || num_channels <= 0 || num_samples <= 0)
+        return;
+
+    // Calls the caller got wrong are dropped instead of running past the prepared buffers
+    if (num_channels > core->num_channels || num_samples > core->max_block_size)
+    {
+        jassertfalse;
+        return;
+    }
+
+    core->process (channels, num_channels, num_samples);
+}
+
+void dspcore_process_events (DspCore* core, float* const* channels, int num_channels, int num_samples, const DspCoreParameterEvent* events, int num_events)
+{
+    if (core == nullptr || channels == nullptr || num_channels <= 0 || num_samples <= 0)
+        return;
+
+    if (num_channels > core->num_channels || num_samples > core->max_block_size || (events == nullptr && num_events > 0))
+    {
+        jassertfalse;
+        return;
+    }
+
+    // Sized for the prepared channels, which num_channels is checked against above
+    auto& sub_block = core->sub_block;
+    int position = 0;
+    int event = 0;
+
+    while (position < num_samples)
+    {
+        // Every event up to here applies before the samples that follow it
+        while (event < num_events && events[event].sample_offset <= position)
+        {
+            if (isParameterIndex (core, events[event].index))
+                core->setParameter (events[event].index, events[event].value);
+            ++event;
+        }
+
+        const int end = event < num_events ? juce::jmin (events[event].sample_offset, num_samples) : num_samples;
+
+        for (int channel = 0; channel < num_channels; ++channel)
+            sub_block[static_cast<size_t> (channel)] = channels[channel] + position;
+
+        core->process (sub_block.data(), num_channels, end - position);
+        position = end;
+    }
+
+    for (; event < num_events; ++event)
+    {
+        if (isParameterIndex (core, events[event].index))
+            core->setParameter (events[event].index, events[event].value);
+    }
+}
+
+int dspcore_set_custom_table (DspCore* core, const float* values, int num_values)
+{
+    if (core == nullptr || values == nullptr || num_values != DSPCORE_CUSTOM_TABLE_SIZE)
+        return -1;
+
+    return core->setCustomTable (values) ? 0 : -1;
+}
+
+int dspcore_set_first_channel (DspCore* core, int first_channel)
+{
+    if (core == nullptr || first_channel < 0)
+        return -1;
+
+    core->setFirstChannel (first_channel);
+    return 0;
+}
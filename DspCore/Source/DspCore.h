@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    DspCore.h
+    Created: 19 Oct 2026 10:16:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/* C interface to the DSP of Easyverb, Gramophony and WaveFolder, without plugin, editor or
+   GUI code. Only this header is needed to use the library, from C or any language that
+   can call C.
+
+   The interface is stable: functions are only ever added, and DSPCORE_API_VERSION goes up
+   when they are. Instances are independent and allocate nothing until they are prepared.
+
+   All functions on one instance must be called from one thread at a time. Parameters set
+   between two process calls apply from the next one, the quality settings of each
+   processor (eco, precision, oversampling) from the next prepare. */
+
+#include <stddef.h>
+
+#if defined(DSPCORE_STATIC)
+#define DSPCORE_API
+#elif defined(_WIN32)
+#if defined(DSPCORE_BUILD)
+#define DSPCORE_API __declspec (dllexport)
+#else
+#define DSPCORE_API __declspec (dllimport)
+#endif
+#else
+#define DSPCORE_API __attribute__ ((visibility ("default")))
+#endif
+
+#define DSPCORE_API_VERSION 4
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct DspCore DspCore;
+
+    typedef enum DspCoreType
+    {
+        DSPCORE_EASYVERB = 0,
+        DSPCORE_GRAMOPHONY = 1,
+        DSPCORE_WAVEFOLDER = 2
+    } DspCoreType;
+
+    /* Id, range and default of a parameter. Values are plain, not normalised, choices are
+       indexes from 0. The strings belong to the library and live as long as it is loaded. */
+    typedef struct DspCoreParameterInfo
+    {
+        const char* id;
+        const char* name;
+        float min_value;
+        float max_value;
+        float default_value;
+    } DspCoreParameterInfo;
+
+    /* Flags of a parameter, since version 2 */
+    enum
+    {
+        /* Choices and counts, only whole numbers are meaningful */
+        DSPCORE_PARAMETER_STEPPED = 1,
+        /* Quality settings that take effect at the next prepare */
+        DSPCORE_PARAMETER_NEEDS_PREPARE = 2
+    };
+
+    /* Values of a custom fold curve, see dspcore_set_custom_table, since version 3 */
+    enum
+    {
+        DSPCORE_CUSTOM_TABLE_SIZE = 513
+    };
+
+    /* A parameter change at a sample offset in a block, since version 2 */
+    typedef struct DspCoreParameterEvent
+    {
+        int sample_offset;
+        int index;
+        float value;
+    } DspCoreParameterEvent;
+
+    DSPCORE_API int dspcore_get_api_version (void);
+
+    /* NULL for an unknown type or when out of memory */
+    DSPCORE_API DspCore* dspcore_create (DspCoreType type);
+    DSPCORE_API void dspcore_destroy (DspCore* core);
+
+    /* Allocates everything processing needs. 0 on success, -1 for invalid arguments or when
+       out of memory, the instance then has to be prepared again before processing. */
+    DSPCORE_API int dspcore_prepare (DspCore* core, double sample_rate, int max_block_size, int num_channels);
+    /* Clears the filter and delay state, keeps the parameters */
+    DSPCORE_API void dspcore_reset (DspCore* core);
+
+    DSPCORE_API int dspcore_get_num_parameters (const DspCore* core);
+    /* 0 on success, -1 for an index out of range */
+    DSPCORE_API int dspcore_get_parameter_info (const DspCore* core, int index, DspCoreParameterInfo* info);
+    /* Index of the parameter with the id, -1 when there is none */
+    DSPCORE_API int dspcore_find_parameter (const DspCore* core, const char* id);
+    /* Values outside the range are clamped, unknown indexes ignored */
+    DSPCORE_API void dspcore_set_parameter (DspCore* core, int index, float value);
+    DSPCORE_API float dspcore_get_parameter (const DspCore* core, int index);
+    /* DSPCORE_PARAMETER_* flags of the parameter, 0 for an index out of range */
+    DSPCORE_API int dspcore_get_parameter_flags (const DspCore* core, int index);
+
+    /* Delay of the output in samples, valid after prepare */
+    DSPCORE_API int dspcore_get_latency_samples (const DspCore* core);
+
+    /* Processes num_channels planar channels in place. num_channels is at most the prepared
+       count and num_samples at most max_block_size. Never allocates or locks. */
+    DSPCORE_API void dspcore_process (DspCore* core, float* const* channels, int num_channels, int num_samples);
+    /* Like dspcore_process, but applies every event at its sample offset by splitting the
+       block there. Events are sorted by offset, offsets past the block apply at its end.
+       Changes of DSPCORE_PARAMETER_NEEDS_PREPARE parameters are stored but still wait for
+       the next prepare. */
+    DSPCORE_API void dspcore_process_events (DspCore* core, float* const* channels, int num_channels, int num_samples, const DspCoreParameterEvent* events, int num_events);
+
+    /* The curve WaveFolder folds with when CURVE is 4 ("Custom"), since version 3. values
+       holds the folded sample at DSPCORE_CUSTOM_TABLE_SIZE evenly spaced multiples of the
+       threshold from -4 to 4, the curve is flat beyond them. The values are copied. Until a
+       table is set the custom curve folds like the triangle (CURVE 0). 0 on success, -1 for
+       other processors or another num_values. */
+    DSPCORE_API int dspcore_set_custom_table (DspCore* core, const float* values, int num_values);
+
+    /* Index of the first channel of the instance in the host's layout, for hosts that split
+       a layout over several instances, since version 4. Gramophony detunes its channels by
+       their index in the whole layout, so the instances together sound like one. 0 by
+       default. 0 on success, -1 for a negative index. */
+    DSPCORE_API int dspcore_set_first_channel (DspCore* core, int first_channel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    DryWetMix.cpp
+    Created: 19 Oct 2026 4:38:20pm
+
+  ==============================================================================
+*/
+
+#include "DryWetMix.h"
+
+constexpr double RAMP_SECONDS = 0.05;
+
+size_t DryWetMix::getRequiredBytes (int num_channels, int max_block_size, int max_latency)
+{
+    const auto channels = static_cast<size_t> (num_channels);
+
+    return Arena::getRequiredBytes<float> (channels * static_cast<size_t> (max_block_size))
+           + Arena::getRequiredBytes<float> (channels * static_cast<size_t> (getDelaySize (max_latency)))
+           + Arena::getRequiredBytes<int> (channels)
+           + Arena::getRequiredBytes<float> (channels);
+}
+
+void DryWetMix::prepare (double sample_rate, int num_channels, int max_block_size, int max_latency, Arena& arena)
+{
+    const auto channels = static_cast<size_t> (num_channels);
+
+    num_channels_ = num_channels;
+    max_block_size_ = max_block_size;
+    delay_size_ = getDelaySize (max_latency);
+
+    dry_ = arena.allocate<float> (channels * static_cast<size_t> (max_block_size));
+    delay_lines_ = arena.allocate<float> (channels * static_cast<size_t> (delay_size_));
+    write_positions_ = arena.allocate<int> (channels);
+    allpass_memories_ = arena.allocate<float> (channels);
+
+    dry_volume_.reset (sample_rate, RAMP_SECONDS);
+    wet_volume_.reset (sample_rate, RAMP_SECONDS);
+    reset();
+}
+
+void DryWetMix::reset()
+{
+    dry_volume_.setCurrentAndTargetValue (dry_volume_.getTargetValue());
+    wet_volume_.setCurrentAndTargetValue (wet_volume_.getTargetValue());
+
+    const auto channels = static_cast<size_t> (num_channels_);
+    std::fill (delay_lines_, delay_lines_ + channels * static_cast<size_t> (delay_size_), 0.0f);
+    std::fill (write_positions_, write_positions_ + channels, 0);
+    std::fill (allpass_memories_, allpass_memories_ + channels, 0.0f);
+    num_dry_samples_ = 0;
+}
+
+void DryWetMix::setWetLatency (float latency)
+{
+    const float delay = juce::jlimit (0.0f, static_cast<float> (delay_size_ - 1), latency);
+
+    delay_int_ = static_cast<int> (std::floor (delay));
+    delay_fraction_ = delay - static_cast<float> (delay_int_);
+
+    // Keep the fraction of the Thiran allpass in its stable and flat range
+    if (delay_fraction_ < 0.618f && delay_int_ >= 1)
+    {
+        delay_fraction_++;
+        delay_int_--;
+    }
+    alpha_ = (1.0f - delay_fraction_) / (1.0f + delay_fraction_);
+}
+
+void DryWetMix::setWetMixProportion (float proportion)
+{
+    jassert (juce::isPositiveAndNotGreaterThan (proportion, 1.0f));
+
+    dry_volume_.setTargetValue (1.0f - proportion);
+    wet_volume_.setTargetValue (proportion);
+}
+
+void DryWetMix::pushDrySamples (const float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_samples <= max_block_size_);
+
+    num_dry_samples_ = num_samples;
+    num_channels = juce::jmin (num_channels, num_channels_);
+
+    for (int channel = 0; channel < num_channels; ++channel)
+    {
+        const auto* input = channels[channel];
+        auto* dry = dry_ + channel * max_block_size_;
+        auto* line = delay_lines_ + channel * delay_size_;
+        int position = write_positions_[channel];
+        float memory = allpass_memories_[channel];
+
+        // The line is written and read at the same position, both move backwards
+        for (int i = 0; i < num_dry_samples_; ++i)
+        {
+            line[position] = input[i];
+
+            int index_1 = position + delay_int_;
+            int index_2 = index_1 + 1;
+            if (index_2 >= delay_size_)
+            {
+                index_1 %= delay_size_;
+                index_2 %= delay_size_;
+            }
+
+            const float output = delay_fraction_ == 0.0f ? line[index_1] : line[index_2] + alpha_ * (line[index_1] - memory);
+            memory = output;
+            dry[i] = output;
+
+            position = (position + delay_size_ - 1) % delay_size_;
+        }
+
+        write_positions_[channel] = position;
+        allpass_memories_[channel] = memory;
+    }
+}
+
+void DryWetMix::mixWetSamples (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_samples == num_dry_samples_);
+
+    num_channels = juce::jmin (num_channels, num_channels_);
+
+    // One gain per sample for all channels, the same ramp as juce::dsp::DryWetMixer
+    for (int i = 0; i < num_samples; ++i)
+    {
+        const float dry_gain = dry_volume_.getNextValue();
+        const float wet_gain = wet_volume_.getNextValue();
+
+        for (int channel = 0; channel < num_channels; ++channel)
+            channels[channel][i] = channels[channel][i] * wet_gain + dry_[channel * max_block_size_ + i] * dry_gain;
+    }
+}
+
+void DryWetMix::applyWetVolume (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_samples == num_dry_samples_);
+
+    num_channels = juce::jmin (num_channels, num_channels_);
+
+    for (int i = 0; i < num_samples; ++i)
+    {
+        const float wet_gain = wet_volume_.getNextValue();
+
+        for (int channel = 0; channel < num_channels; ++channel)
+            channels[channel][i] *= wet_gain;
+    }
+}
+
+void DryWetMix::mixDrySamples (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_samples == num_dry_samples_);
+
+    num_channels = juce::jmin (num_channels, num_channels_);
+
+    for (int i = 0; i < num_samples; ++i)
+    {
+        const float dry_gain = dry_volume_.getNextValue();
+
+        for (int channel = 0; channel < num_channels; ++channel)
+            channels[channel][i] += dry_[channel * max_block_size_ + i] * dry_gain;
+    }
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    DryWetMix.h
+    Created: 19 Oct 2026 4:38:20pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <Arena.h>
+#include <JuceHeader.h>
+
+// Linear dry/wet crossfade with the dry signal delayed by the latency of the wet path.
+//
+// Behaves like juce::dsp::DryWetMixer with the linear mixing rule and a Thiran interpolated
+// delay, but keeps its dry buffer and delay lines in an arena.
+class DryWetMix
+{
+public:
+    static size_t getRequiredBytes (int num_channels, int max_block_size, int max_latency);
+
+    void prepare (double sample_rate, int num_channels, int max_block_size, int max_latency, Arena& arena);
+    void reset();
+
+    void setWetLatency (float latency);
+    void setWetMixProportion (float proportion);
+
+    void pushDrySamples (const float* const* channels, int num_channels, int num_samples);
+    void mixWetSamples (float* const* channels, int num_channels, int num_samples);
+
+    // mixWetSamples() in two halves, for a wet signal that is summed elsewhere: scales the
+    // wet input by the wet volume, then adds the dry signal at the dry volume to the channels
+    void applyWetVolume (float* const* channels, int num_channels, int num_samples);
+    void mixDrySamples (float* const* channels, int num_channels, int num_samples);
+
+private:
+    static int getDelaySize (int max_latency) { return juce::jmax (4, max_latency + 1); }
+
+    float* dry_ = nullptr;
+    float* delay_lines_ = nullptr;
+    // Per channel state of the delay lines
+    int* write_positions_ = nullptr;
+    float* allpass_memories_ = nullptr;
+    int num_channels_ = 0;
+    int max_block_size_ = 0;
+    int delay_size_ = 0;
+    int num_dry_samples_ = 0;
+
+    int delay_int_ = 0;
+    float delay_fraction_ = 0.0f;
+    float alpha_ = 0.0f;
+
+    juce::SmoothedValue<float> dry_volume_ { 0.0f };
+    juce::SmoothedValue<float> wet_volume_ { 1.0f };
+};
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    EasyverbCore.cpp
+    Created: 19 Oct 2026 9:22:40pm
+
+  ==============================================================================
+*/
+
+#include "EasyverbCore.h"
+
+const CoreParameter EasyverbCore::PARAMETERS[NUM_PARAMETERS] = {
+    { "REVERB", "Reverb", 0.0f, 1.0f, 0.5f },
+    { "MIX", "Mix", 0.0f, 1.0f, 0.2f },
+    // Runs the reverb at a lower rate at 88.2 kHz and above to save CPU and memory
+    { "ECO", "Eco", 0.0f, 2.0f, 0.0f, true, true, "Off|Half rate|Quarter rate" },
+    // Stores the reverb delay lines in 16 bit floats, half the memory for many instances. In
+    // the order of Freeverb::Precision.
+    { "PRECISION", "Delay precision", 0.0f, 2.0f, 0.0f, true, true, "32 bit|16 bit|16 bit bfloat" },
+};
+
+EasyverbCore::EasyverbCore()
+{
+    for (int parameter = 0; parameter < NUM_PARAMETERS; ++parameter)
+        values_[static_cast<size_t> (parameter)] = PARAMETERS[parameter].default_value;
+}
+
+void EasyverbCore::setFilterCoefficients (MultiChannelBiquad& shelf, MultiChannelBiquad& high_pass, double sample_rate)
+{
+    // Even channels get the filters of the left channel and odd channels the slightly
+    // detuned ones of the right channel, so any layout keeps the stereo character.
+    for (int channel = 0; channel < shelf.getNumChannels(); ++channel)
+    {
+        if (channel % 2 == 0)
+        {
+            shelf.setCoefficients (channel, MultiChannelBiquad::makeHighShelf (sample_rate, 1200.0f, 2.1f, 0.6f));
+            high_pass.setCoefficients (channel, MultiChannelBiquad::makeHighPass (sample_rate, 110.0f, 3.0f));
+        }
+        else
+        {
+            shelf.setCoefficients (channel, MultiChannelBiquad::makeHighShelf (sample_rate, 1194.0f, 2.0f, 0.6f));
+            high_pass.setCoefficients (channel, MultiChannelBiquad::makeHighPass (sample_rate, 110.0f, 3.1f));
+        }
+    }
+}
+
+juce::Reverb::Parameters EasyverbCore::getReverbParameters (float reverb)
+{
+    juce::Reverb::Parameters parameters;
+    parameters.roomSize = reverb;
+    parameters.damping = 0.6f - reverb / 2.0f;
+    parameters.width = 0.5f;
+    parameters.freezeMode = 0.0f;
+    parameters.dryLevel = 0.0f;
+    parameters.wetLevel = 1.0f;
+    return parameters;
+}
+
+void EasyverbCore::prepare (double sample_rate, int max_block_size, int num_channels)
+{
+    num_channels_ = num_channels;
+
+    // Eco mode halves the reverb rate once or twice, but never below 44.1 kHz
+    const int eco_steps = juce::roundToInt (values_[ECO]);
+    int rate_divider = 1;
+    for (int step = 0; step < eco_steps && sample_rate / (rate_divider * 2) >= 44100.0; ++step)
+        rate_divider *= 2;
+
+    const auto precision = static_cast<Freeverb::Precision> (juce::roundToInt (values_[PRECISION]));
+    // Every stage only ever sees one micro block
+    const int scratch_size = MicroBlocks::getScratchSize (max_block_size);
+
+    arena_.prepare (DryWetMix::getRequiredBytes (num_channels, scratch_size, MAX_WET_LATENCY)
+                    + ReverbEngine::getRequiredBytes (sample_rate, scratch_size, num_channels, rate_divider, precision));
+    mix_.prepare (sample_rate, num_channels, scratch_size, MAX_WET_LATENCY, arena_);
+    reverb_.prepare (sample_rate, scratch_size, num_channels, rate_divider, precision, arena_);
+    mix_.setWetLatency (reverb_.getLatencySamples());
+
+    shelf_.prepare (num_channels);
+    high_pass_.prepare (num_channels);
+    setFilterCoefficients (shelf_, high_pass_, sample_rate);
+    micro_channels_.resize (static_cast<size_t> (num_channels));
+}
+
+void EasyverbCore::reset()
+{
+    reverb_.reset();
+    shelf_.reset();
+    high_pass_.reset();
+    mix_.reset();
+}
+
+void EasyverbCore::setParameter (int index, float value)
+{
+    if (index >= 0 && index < NUM_PARAMETERS)
+        values_[static_cast<size_t> (index)] = juce::jlimit (PARAMETERS[index].min_value, PARAMETERS[index].max_value, value);
+}
+
+void EasyverbCore::process (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    juce::ScopedNoDenormals no_denormals;
+
+    reverb_.setParameters (getReverbParameters (values_[REVERB]));
+    mix_.setWetMixProportion (values_[MIX]);
+
+    // The dry copy and the signal stay in L1 from the filters to the mix, see MicroBlocks
+    makeEasyverbChain (mix_, shelf_, high_pass_, reverb_).process (channels, num_channels, num_samples, micro_channels_);
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    EasyverbCore.h
+    Created: 19 Oct 2026 9:22:40pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DryWetMix.h"
+#include "EasyverbStages.h"
+#include "ReverbEngine.h"
+#include <Arena.h>
+#include <CoreParameter.h>
+#include <JuceHeader.h>
+#include <MicroBlocks.h>
+#include <MultiChannelBiquad.h>
+
+// The sound of Easyverb without the plugin around it: filters, reverb and dry/wet mix, for
+// hosts that embed the DSP directly. Needs juce_audio_basics and juce_dsp only.
+//
+// Parameters are plain values in the ranges of PARAMETERS. The quality settings ECO and
+// PRECISION take effect at the next prepare(). No presets, tiers or CPU governor, those stay
+// in the plugin. Constructing one allocates nothing, prepare() carves all memory out of one
+// arena.
+class EasyverbCore
+{
+public:
+    enum Parameter
+    {
+        REVERB = 0,
+        MIX,
+        ECO,
+        PRECISION,
+        NUM_PARAMETERS
+    };
+
+    static const CoreParameter PARAMETERS[NUM_PARAMETERS];
+
+    EasyverbCore();
+
+    // Also used by the plugin, so both sound the same
+    static void setFilterCoefficients (MultiChannelBiquad& shelf, MultiChannelBiquad& high_pass, double sample_rate);
+    static juce::Reverb::Parameters getReverbParameters (float reverb);
+
+    void prepare (double sample_rate, int max_block_size, int num_channels);
+    void reset();
+
+    void setParameter (int index, float value);
+    float getParameter (int index) const { return values_[static_cast<size_t> (index)]; }
+    int getLatencySamples() const { return juce::roundToInt (reverb_.getLatencySamples()); }
+
+    // Processes num_channels planar channels in place, num_samples at most the max_block_size
+    // of prepare(). Runs through the stages of makeEasyverbChain() one micro block at a time.
+    void process (float* const* channels, int num_channels, int num_samples);
+
+private:
+    // Room for the latency of the quarter rate mode, the dry signal is delayed to match
+    static constexpr int MAX_WET_LATENCY = 64;
+
+    std::array<float, NUM_PARAMETERS> values_ {};
+    int num_channels_ = 0;
+
+    Arena arena_;
+    ReverbEngine reverb_;
+    MultiChannelBiquad shelf_;
+    MultiChannelBiquad high_pass_;
+    DryWetMix mix_;
+    // Channel pointers of the micro block the stages run on, see StageChain
+    std::vector<float*> micro_channels_;
+};
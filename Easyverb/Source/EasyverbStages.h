@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    EasyverbStages.h
+    Created: 19 Oct 2026 3:21:48pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DryWetMix.h"
+#include "ReverbEngine.h"
+#include <JuceHeader.h>
+#include <MultiChannelBiquad.h>
+#include <StageChain.h>
+
+// The stages of Easyverb for a StageChain, around state owned by the core or the plugin
+
+// Keeps the input for the mix at the end of the chain
+struct DryStage
+{
+    DryWetMix& mix;
+
+    void process (float* const* channels, int num_channels, int num_samples) { mix.pushDrySamples (channels, num_channels, num_samples); }
+};
+
+struct ReverbStage
+{
+    ReverbEngine& reverb;
+
+    void process (float* const* channels, int num_channels, int num_samples) { reverb.process (channels, num_channels, num_samples); }
+};
+
+struct WetStage
+{
+    DryWetMix& mix;
+
+    void process (float* const* channels, int num_channels, int num_samples) { mix.mixWetSamples (channels, num_channels, num_samples); }
+};
+
+// Dry copy, shelf, high-pass, reverb and mix, the same for the core and the plugin
+inline auto makeEasyverbChain (DryWetMix& mix, MultiChannelBiquad& shelf, MultiChannelBiquad& high_pass, ReverbEngine& reverb)
+{
+    return makeStageChain (DryStage { mix }, BiquadStage { shelf }, BiquadStage { high_pass }, ReverbStage { reverb }, WetStage { mix });
+}
@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+    Freeverb.cpp
+    Created: 19 Oct 2026 4:05:52pm
+
+  ==============================================================================
+*/
+
+#include "Freeverb.h"
+
+// Tunings in samples at 44.1 kHz, the right channel is spread a little further
+constexpr int COMB_TUNINGS[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+constexpr int ALLPASS_TUNINGS[] = { 556, 441, 341, 225 };
+constexpr int STEREO_SPREAD = 23;
+
+constexpr float WET_SCALE = 3.0f;
+constexpr float DRY_SCALE = 2.0f;
+constexpr float ROOM_SCALE = 0.28f;
+constexpr float ROOM_OFFSET = 0.7f;
+constexpr float DAMP_SCALE = 0.4f;
+constexpr float INPUT_GAIN = 0.015f;
+
+// Float16 only has full precision down to 6e-5, so the lines store their values scaled up by
+// a power of two, which costs no rounding. Without it the quiet end of a tail gets stuck in
+// a limit cycle around -108 dBFS instead of decaying. The lines stay far below the 65504
+// limit even with a hot input.
+template <typename Sample>
+constexpr float STORAGE_SCALE = 1.0f;
+template <>
+constexpr float STORAGE_SCALE<Float16> = 256.0f;
+
+Freeverb::Freeverb()
+{
+    // Start from the juce::Reverb defaults, the first parameters glide from there
+    setParameters (juce::Reverb::Parameters());
+}
+
+int Freeverb::getCombSize (double sample_rate, int comb, int channel)
+{
+    return (static_cast<int> (sample_rate) * (COMB_TUNINGS[comb] + channel * STEREO_SPREAD)) / 44100;
+}
+
+int Freeverb::getAllpassSize (double sample_rate, int allpass, int channel)
+{
+    return (static_cast<int> (sample_rate) * (ALLPASS_TUNINGS[allpass] + channel * STEREO_SPREAD)) / 44100;
+}
+
+size_t Freeverb::getLineBytes (int size, Precision precision)
+{
+    const auto bytes = static_cast<size_t> (size) * (precision == Precision::float32 ? sizeof (float) : sizeof (std::uint16_t));
+    return Arena::getRequiredBytes<char> (bytes);
+}
+
+size_t Freeverb::getRequiredBytes (double sample_rate, Precision precision)
+{
+    size_t bytes = 0;
+    for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        for (int comb = 0; comb < NUM_COMBS; ++comb)
+            bytes += getLineBytes (getCombSize (sample_rate, comb, channel), precision);
+        for (int allpass = 0; allpass < NUM_ALLPASSES; ++allpass)
+            bytes += getLineBytes (getAllpassSize (sample_rate, allpass, channel), precision);
+    }
+    return bytes;
+}
+
+void Freeverb::prepare (double sample_rate, Precision precision, Arena& arena)
+{
+    precision_ = precision;
+    num_combs_ = NUM_COMBS;
+    comb_gain_ = 1.0f;
+
+    for (int comb = 0; comb < NUM_COMBS; ++comb)
+    {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+        {
+            auto& line = combs_[comb][channel];
+            line.size = getCombSize (sample_rate, comb, channel);
+            line.buffer = arena.allocate<char> (getLineBytes (line.size, precision));
+        }
+    }
+
+    for (int allpass = 0; allpass < NUM_ALLPASSES; ++allpass)
+    {
+        for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+        {
+            auto& line = allpasses_[allpass][channel];
+            line.size = getAllpassSize (sample_rate, allpass, channel);
+            line.buffer = arena.allocate<char> (getLineBytes (line.size, precision));
+        }
+    }
+
+    damping_.reset (sample_rate, SMOOTHING_SECONDS);
+    feedback_.reset (sample_rate, SMOOTHING_SECONDS);
+    dry_gain_.reset (sample_rate, SMOOTHING_SECONDS);
+    wet_gain_1_.reset (sample_rate, SMOOTHING_SECONDS);
+    wet_gain_2_.reset (sample_rate, SMOOTHING_SECONDS);
+
+    reset();
+}
+
+void Freeverb::clearLine (DelayLine& line, Precision precision)
+{
+    // All bits zero is zero in every precision
+    if (line.buffer != nullptr)
+        std::memset (line.buffer, 0, getLineBytes (line.size, precision));
+    line.index = 0;
+    line.last = 0.0f;
+}
+
+void Freeverb::reset()
+{
+    for (auto& channels : combs_)
+    {
+        for (auto& line : channels)
+            clearLine (line, precision_);
+    }
+
+    for (auto& channels : allpasses_)
+    {
+        for (auto& line : channels)
+            clearLine (line, precision_);
+    }
+}
+
+void Freeverb::setNumCombs (int num_combs)
+{
+    num_combs = juce::jlimit (1, NUM_COMBS, num_combs);
+
+    for (int comb = num_combs_; comb < num_combs; ++comb)
+    {
+        for (auto& line : combs_[comb])
+            clearLine (line, precision_);
+    }
+
+    num_combs_ = num_combs;
+    comb_gain_ = static_cast<float> (NUM_COMBS) / static_cast<float> (num_combs);
+}
+
+Freeverb::Gains Freeverb::getGains (const juce::Reverb::Parameters& parameters)
+{
+    const bool frozen = parameters.freezeMode >= 0.5f;
+    const float wet = parameters.wetLevel * WET_SCALE;
+
+    Gains gains;
+    gains.dry = parameters.dryLevel * DRY_SCALE;
+    gains.wet_1 = 0.5f * wet * (1.0f + parameters.width);
+    gains.wet_2 = 0.5f * wet * (1.0f - parameters.width);
+    gains.input = frozen ? 0.0f : INPUT_GAIN;
+    gains.damping = frozen ? 0.0f : parameters.damping * DAMP_SCALE;
+    gains.feedback = frozen ? 1.0f : parameters.roomSize * ROOM_SCALE + ROOM_OFFSET;
+    return gains;
+}
+
+void Freeverb::setParameters (const juce::Reverb::Parameters& parameters)
+{
+    const auto gains = getGains (parameters);
+
+    dry_gain_.setTargetValue (gains.dry);
+    wet_gain_1_.setTargetValue (gains.wet_1);
+    wet_gain_2_.setTargetValue (gains.wet_2);
+    gain_ = gains.input;
+
+    damping_.setTargetValue (gains.damping);
+    feedback_.setTargetValue (gains.feedback);
+}
+
+template <typename Sample>
+float Freeverb::processComb (DelayLine& comb, float input, float damp, float feedback)
+{
+    auto* buffer = static_cast<Sample*> (comb.buffer);
+    const float output = buffer[comb.index] * (1.0f / STORAGE_SCALE<Sample>);
+    comb.last = (output * (1.0f - damp)) + (comb.last * damp);
+    JUCE_UNDENORMALISE (comb.last);
+
+    float temp = input + (comb.last * feedback);
+    JUCE_UNDENORMALISE (temp);
+    buffer[comb.index] = Sample (temp * STORAGE_SCALE<Sample>);
+    comb.index = (comb.index + 1) % comb.size;
+    return output;
+}
+
+template <typename Sample>
+float Freeverb::processAllpass (DelayLine& allpass, float input)
+{
+    auto* buffer = static_cast<Sample*> (allpass.buffer);
+    const float buffered = buffer[allpass.index] * (1.0f / STORAGE_SCALE<Sample>);
+    float temp = input + (buffered * ALLPASS_FEEDBACK);
+    JUCE_UNDENORMALISE (temp);
+    buffer[allpass.index] = Sample (temp * STORAGE_SCALE<Sample>);
+    allpass.index = (allpass.index + 1) % allpass.size;
+    return buffered - input;
+}
+
+void Freeverb::processStereo (float* left, float* right, int num_samples)
+{
+    switch (precision_)
+    {
+        case Precision::float32:
+            processStereoWith<float> (left, right, num_samples);
+            break;
+        case Precision::float16:
+            processStereoWith<Float16> (left, right, num_samples);
+            break;
+        case Precision::bfloat16:
+            processStereoWith<BFloat16> (left, right, num_samples);
+            break;
+    }
+}
+
+void Freeverb::processMono (float* samples, int num_samples)
+{
+    switch (precision_)
+    {
+        case Precision::float32:
+            processMonoWith<float> (samples, num_samples);
+            break;
+        case Precision::float16:
+            processMonoWith<Float16> (samples, num_samples);
+            break;
+        case Precision::bfloat16:
+            processMonoWith<BFloat16> (samples, num_samples);
+            break;
+    }
+}
+
+template <typename Sample>
+void Freeverb::processStereoWith (float* left, float* right, int num_samples)
+{
+    for (int i = 0; i < num_samples; ++i)
+    {
+        const float input = (left[i] + right[i]) * gain_ * comb_gain_;
+        const float damp = damping_.getNextValue();
+        const float feedback = feedback_.getNextValue();
+        float out_left = 0.0f;
+        float out_right = 0.0f;
+
+        // Comb filters in parallel, then the allpasses in series
+        for (int comb = 0; comb < num_combs_; ++comb)
+        {
+            out_left += processComb<Sample> (combs_[comb][0], input, damp, feedback);
+            out_right += processComb<Sample> (combs_[comb][1], input, damp, feedback);
+        }
+
+        for (auto& allpass : allpasses_)
+        {
+            out_left = processAllpass<Sample> (allpass[0], out_left);
+            out_right = processAllpass<Sample> (allpass[1], out_right);
+        }
+
+        const float dry = dry_gain_.getNextValue();
+        const float wet_1 = wet_gain_1_.getNextValue();
+        const float wet_2 = wet_gain_2_.getNextValue();
+        left[i] = out_left * wet_1 + out_right * wet_2 + left[i] * dry;
+        right[i] = out_right * wet_1 + out_left * wet_2 + right[i] * dry;
+    }
+}
+
+template <typename Sample>
+void Freeverb::processMonoWith (float* samples, int num_samples)
+{
+    for (int i = 0; i < num_samples; ++i)
+    {
+        const float input = samples[i] * gain_ * comb_gain_;
+        const float damp = damping_.getNextValue();
+        const float feedback = feedback_.getNextValue();
+        float output = 0.0f;
+
+        for (int comb = 0; comb < num_combs_; ++comb)
+            output += processComb<Sample> (combs_[comb][0], input, damp, feedback);
+
+        for (auto& allpass : allpasses_)
+            output = processAllpass<Sample> (allpass[0], output);
+
+        const float dry = dry_gain_.getNextValue();
+        const float wet_1 = wet_gain_1_.getNextValue();
+        samples[i] = output * wet_1 + samples[i] * dry;
+    }
+}
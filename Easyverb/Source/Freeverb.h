@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    Freeverb.h
+    Created: 19 Oct 2026 4:05:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <Arena.h>
+#include <HalfFloat.h>
+#include <JuceHeader.h>
+
+// Stereo Freeverb, the same algorithm and tuning as juce::Reverb, with its delay lines
+// carved out of an arena instead of allocated one by one.
+//
+// The lines are laid out in the order the per-sample loop visits them, left and right comb
+// of each tuning next to each other followed by the allpasses, and the read positions and
+// filter memories of all lines sit together in the object itself.
+//
+// The lines can store 16 bit floats instead of floats, which halves their memory and the
+// bandwidth the reverb needs. The filters still compute in float.
+class Freeverb
+{
+public:
+    enum class Precision
+    {
+        float32 = 0,
+        float16,
+        bfloat16
+    };
+
+    static constexpr int NUM_COMBS = 8;
+    static constexpr int NUM_ALLPASSES = 4;
+    static constexpr float ALLPASS_FEEDBACK = 0.5f;
+    static constexpr double SMOOTHING_SECONDS = 0.01;
+
+    // Targets of the smoothed values for a set of parameters
+    struct Gains
+    {
+        float input = 0.0f;
+        float dry = 0.0f;
+        float wet_1 = 0.0f;
+        float wet_2 = 0.0f;
+        float damping = 0.0f;
+        float feedback = 0.0f;
+    };
+
+    Freeverb();
+
+    // The tuning, also used by FreeverbBatch
+    static int getCombSize (double sample_rate, int comb, int channel);
+    static int getAllpassSize (double sample_rate, int allpass, int channel);
+    static Gains getGains (const juce::Reverb::Parameters& parameters);
+
+    static size_t getRequiredBytes (double sample_rate, Precision precision);
+
+    // Carves the delay lines out of arena and clears them
+    void prepare (double sample_rate, Precision precision, Arena& arena);
+    void reset();
+
+    Precision getPrecision() const { return precision_; }
+
+    void setParameters (const juce::Reverb::Parameters& parameters);
+
+    // Runs only the first num_combs comb filters, a sparser tail for less CPU. The input gain
+    // keeps the level. Realtime safe, combs that come back are cleared first.
+    void setNumCombs (int num_combs);
+    int getNumCombs() const { return num_combs_; }
+
+    void processStereo (float* left, float* right, int num_samples);
+    void processMono (float* samples, int num_samples);
+
+private:
+    static constexpr int NUM_CHANNELS = 2;
+
+    struct DelayLine
+    {
+        // Samples of the type chosen by the precision
+        void* buffer = nullptr;
+        int size = 0;
+        int index = 0;
+        float last = 0.0f;
+    };
+
+    static size_t getLineBytes (int size, Precision precision);
+    static void clearLine (DelayLine& line, Precision precision);
+
+    template <typename Sample>
+    static float processComb (DelayLine& comb, float input, float damp, float feedback);
+    template <typename Sample>
+    static float processAllpass (DelayLine& allpass, float input);
+    template <typename Sample>
+    void processStereoWith (float* left, float* right, int num_samples);
+    template <typename Sample>
+    void processMonoWith (float* samples, int num_samples);
+
+    DelayLine combs_[NUM_COMBS][NUM_CHANNELS];
+    DelayLine allpasses_[NUM_ALLPASSES][NUM_CHANNELS];
+    Precision precision_ = Precision::float32;
+    int num_combs_ = NUM_COMBS;
+    float comb_gain_ = 1.0f;
+
+    float gain_ = 0.015f;
+    juce::SmoothedValue<float> damping_;
+    juce::SmoothedValue<float> feedback_;
+    juce::SmoothedValue<float> dry_gain_;
+    juce::SmoothedValue<float> wet_gain_1_;
+    juce::SmoothedValue<float> wet_gain_2_;
+};
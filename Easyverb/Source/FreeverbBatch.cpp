@@ -0,0 +1,376 @@
+/*
+  ==============================================================================
+
+    FreeverbBatch.cpp
+    Created: 19 Oct 2026 8:14:26pm
+
+  ==============================================================================
+*/
+
+#include "FreeverbBatch.h"
+
+FreeverbBatch::FreeverbBatch()
+{
+    // Start from the juce::Reverb defaults like Freeverb does
+    gains_ = Freeverb::getGains (juce::Reverb::Parameters());
+}
+
+size_t FreeverbBatch::getRequiredBytes (double sample_rate, int num_streams, int num_channels, int max_block_size)
+{
+    const auto streams = static_cast<size_t> (num_streams);
+
+    size_t bytes = Arena::getRequiredBytes<float> (streams);
+    bytes += Arena::getRequiredBytes<float> (streams);
+    bytes += static_cast<size_t> (NUM_SMOOTHED) * (3 * Arena::getRequiredBytes<float> (streams) + Arena::getRequiredBytes<int> (streams));
+    for (int channel = 0; channel < num_channels; ++channel)
+    {
+        bytes += Arena::getRequiredBytes<float> (static_cast<size_t> (max_block_size) * streams);
+        bytes += Arena::getRequiredBytes<float> (streams);
+
+        for (int comb = 0; comb < Freeverb::NUM_COMBS; ++comb)
+        {
+            bytes += Arena::getRequiredBytes<float> (static_cast<size_t> (Freeverb::getCombSize (sample_rate, comb, channel)) * streams);
+            bytes += Arena::getRequiredBytes<float> (streams);
+        }
+        for (int allpass = 0; allpass < Freeverb::NUM_ALLPASSES; ++allpass)
+            bytes += Arena::getRequiredBytes<float> (static_cast<size_t> (Freeverb::getAllpassSize (sample_rate, allpass, channel)) * streams);
+    }
+    return bytes;
+}
+
+void FreeverbBatch::prepare (double sample_rate, int num_streams, int num_channels, int max_block_size, Arena& arena)
+{
+    jassert (num_streams > 0);
+    jassert (num_channels == 1 || num_channels == 2);
+
+    num_streams_ = num_streams;
+    num_active_streams_ = num_streams;
+    num_channels_ = num_channels;
+    const auto streams = static_cast<size_t> (num_streams);
+
+    for (int channel = 0; channel < num_channels; ++channel)
+        block_[channel] = arena.allocate<float> (static_cast<size_t> (max_block_size) * streams);
+
+    input_ = arena.allocate<float> (streams);
+    for (int channel = 0; channel < num_channels; ++channel)
+        output_[channel] = arena.allocate<float> (streams);
+
+    // Read every sample, next to the block
+    input_gains_ = arena.allocate<float> (streams);
+    for (auto& smoothed : smoothed_)
+    {
+        smoothed.current = arena.allocate<float> (streams);
+        smoothed.target = arena.allocate<float> (streams);
+        smoothed.step = arena.allocate<float> (streams);
+        smoothed.countdown = arena.allocate<int> (streams);
+    }
+
+    // Same order as Freeverb, the lines of a tuning next to each other
+    for (int comb = 0; comb < Freeverb::NUM_COMBS; ++comb)
+    {
+        for (int channel = 0; channel < num_channels; ++channel)
+        {
+            auto& line = combs_[comb][channel];
+            line.size = Freeverb::getCombSize (sample_rate, comb, channel);
+            line.buffer = arena.allocate<float> (static_cast<size_t> (line.size) * streams);
+            line.last = arena.allocate<float> (streams);
+        }
+    }
+
+    for (int allpass = 0; allpass < Freeverb::NUM_ALLPASSES; ++allpass)
+    {
+        for (int channel = 0; channel < num_channels; ++channel)
+        {
+            auto& line = allpasses_[allpass][channel];
+            line.size = Freeverb::getAllpassSize (sample_rate, allpass, channel);
+            line.buffer = arena.allocate<float> (static_cast<size_t> (line.size) * streams);
+        }
+    }
+
+    // What juce::SmoothedValue::reset() does for Freeverb
+    steps_to_target_ = static_cast<int> (std::floor (Freeverb::SMOOTHING_SECONDS * sample_rate));
+    for (int stream = 0; stream < num_streams; ++stream)
+        resetStreamParameters (stream);
+
+    reset();
+}
+
+void FreeverbBatch::resetStreamParameters (int stream)
+{
+    input_gains_[stream] = gains_.input;
+    setCurrentAndTargetValue (DAMPING, stream, gains_.damping);
+    setCurrentAndTargetValue (FEEDBACK, stream, gains_.feedback);
+    setCurrentAndTargetValue (DRY_GAIN, stream, gains_.dry);
+    setCurrentAndTargetValue (WET_GAIN_1, stream, gains_.wet_1);
+    setCurrentAndTargetValue (WET_GAIN_2, stream, gains_.wet_2);
+}
+
+void FreeverbBatch::reset()
+{
+    const auto streams = static_cast<size_t> (num_streams_);
+
+    for (int channel = 0; channel < num_channels_; ++channel)
+    {
+        for (auto& comb : combs_)
+        {
+            std::fill (comb[channel].buffer, comb[channel].buffer + static_cast<size_t> (comb[channel].size) * streams, 0.0f);
+            std::fill (comb[channel].last, comb[channel].last + streams, 0.0f);
+            comb[channel].index = 0;
+        }
+
+        for (auto& allpass : allpasses_)
+        {
+            std::fill (allpass[channel].buffer, allpass[channel].buffer + static_cast<size_t> (allpass[channel].size) * streams, 0.0f);
+            allpass[channel].index = 0;
+        }
+    }
+}
+
+void FreeverbBatch::clearStream (int stream)
+{
+    jassert (stream >= 0 && stream < num_streams_);
+
+    const auto streams = static_cast<size_t> (num_streams_);
+
+    for (int channel = 0; channel < num_channels_; ++channel)
+    {
+        for (auto& comb : combs_)
+        {
+            for (size_t row = static_cast<size_t> (stream); row < static_cast<size_t> (comb[channel].size) * streams; row += streams)
+                comb[channel].buffer[row] = 0.0f;
+            comb[channel].last[stream] = 0.0f;
+        }
+
+        for (auto& allpass : allpasses_)
+        {
+            for (size_t row = static_cast<size_t> (stream); row < static_cast<size_t> (allpass[channel].size) * streams; row += streams)
+                allpass[channel].buffer[row] = 0.0f;
+        }
+    }
+
+    resetStreamParameters (stream);
+}
+
+void FreeverbBatch::setParameters (const juce::Reverb::Parameters& parameters)
+{
+    gains_ = Freeverb::getGains (parameters);
+
+    for (int stream = 0; stream < num_streams_; ++stream)
+        setStreamParameters (stream, parameters);
+}
+
+void FreeverbBatch::setStreamParameters (int stream, const juce::Reverb::Parameters& parameters)
+{
+    jassert (stream >= 0 && stream < num_streams_);
+
+    const auto gains = Freeverb::getGains (parameters);
+
+    setTargetValue (DRY_GAIN, stream, gains.dry);
+    setTargetValue (WET_GAIN_1, stream, gains.wet_1);
+    setTargetValue (WET_GAIN_2, stream, gains.wet_2);
+    input_gains_[stream] = gains.input;
+
+    setTargetValue (DAMPING, stream, gains.damping);
+    setTargetValue (FEEDBACK, stream, gains.feedback);
+}
+
+void FreeverbBatch::setNumActiveStreams (int num_streams)
+{
+    jassert (num_streams >= 0 && num_streams <= num_streams_);
+    num_active_streams_ = num_streams;
+}
+
+void FreeverbBatch::setTargetValue (Smoothed smoothed, int stream, float target)
+{
+    auto& values = smoothed_[smoothed];
+
+    if (target == values.target[stream])
+        return;
+
+    if (steps_to_target_ <= 0)
+    {
+        setCurrentAndTargetValue (smoothed, stream, target);
+        return;
+    }
+
+    values.target[stream] = target;
+    values.countdown[stream] = steps_to_target_;
+    values.step[stream] = (target - values.current[stream]) / static_cast<float> (steps_to_target_);
+}
+
+void FreeverbBatch::setCurrentAndTargetValue (Smoothed smoothed, int stream, float value)
+{
+    auto& values = smoothed_[smoothed];
+
+    values.current[stream] = value;
+    values.target[stream] = value;
+    values.countdown[stream] = 0;
+}
+
+void FreeverbBatch::advance (Smoothed smoothed)
+{
+    float* __restrict current = smoothed_[smoothed].current;
+    const float* __restrict target = smoothed_[smoothed].target;
+    const float* __restrict step = smoothed_[smoothed].step;
+    int* __restrict countdown = smoothed_[smoothed].countdown;
+
+    // The current value is the target whenever the countdown is zero, so no stream branches
+    for (int stream = 0; stream < num_active_streams_; ++stream)
+    {
+        const bool smoothing = countdown[stream] > 1;
+        current[stream] = smoothing ? current[stream] + step[stream] : target[stream];
+        countdown[stream] = smoothing ? countdown[stream] - 1 : 0;
+    }
+}
+
+void FreeverbBatch::processComb (DelayLine& comb, const float* __restrict input, float* __restrict output, const float* __restrict damp, const float* __restrict feedback)
+{
+    float* __restrict buffer = comb.buffer + static_cast<size_t> (comb.index) * static_cast<size_t> (num_streams_);
+    float* __restrict last = comb.last;
+
+    // The steps of Freeverb::processComb(), one stream per lane
+    for (int stream = 0; stream < num_active_streams_; ++stream)
+    {
+        const float buffered = buffer[stream];
+        float filtered = (buffered * (1.0f - damp[stream])) + (last[stream] * damp[stream]);
+        JUCE_UNDENORMALISE (filtered);
+        last[stream] = filtered;
+
+        float temp = input[stream] + (filtered * feedback[stream]);
+        JUCE_UNDENORMALISE (temp);
+        buffer[stream] = temp;
+        output[stream] += buffered;
+    }
+
+    comb.index = (comb.index + 1) % comb.size;
+}
+
+void FreeverbBatch::processAllpass (DelayLine& allpass, float* __restrict samples)
+{
+    float* __restrict buffer = allpass.buffer + static_cast<size_t> (allpass.index) * static_cast<size_t> (num_streams_);
+
+    for (int stream = 0; stream < num_active_streams_; ++stream)
+    {
+        const float buffered = buffer[stream];
+        float temp = samples[stream] + (buffered * Freeverb::ALLPASS_FEEDBACK);
+        JUCE_UNDENORMALISE (temp);
+        buffer[stream] = temp;
+        samples[stream] = buffered - samples[stream];
+    }
+
+    allpass.index = (allpass.index + 1) % allpass.size;
+}
+
+void FreeverbBatch::process (float* const* channels, int num_samples)
+{
+    // Interleave the streams of every channel, so each sample is one contiguous row
+    for (int channel = 0; channel < num_channels_; ++channel)
+    {
+        for (int stream = 0; stream < num_active_streams_; ++stream)
+        {
+            const float* source = channels[stream * num_channels_ + channel];
+            float* destination = block_[channel] + stream;
+            for (int i = 0; i < num_samples; ++i)
+                destination[i * num_streams_] = source[i];
+        }
+    }
+
+    if (num_channels_ == 2)
+        processStereo (num_samples);
+    else
+        processMono (num_samples);
+
+    for (int channel = 0; channel < num_channels_; ++channel)
+    {
+        for (int stream = 0; stream < num_active_streams_; ++stream)
+        {
+            const float* source = block_[channel] + stream;
+            float* destination = channels[stream * num_channels_ + channel];
+            for (int i = 0; i < num_samples; ++i)
+                destination[i] = source[i * num_streams_];
+        }
+    }
+}
+
+void FreeverbBatch::processStereo (int num_samples)
+{
+    float* __restrict input = input_;
+    float* __restrict out_left = output_[0];
+    float* __restrict out_right = output_[1];
+
+    for (int i = 0; i < num_samples; ++i)
+    {
+        float* __restrict left = block_[0] + i * num_streams_;
+        float* __restrict right = block_[1] + i * num_streams_;
+        advance (DAMPING);
+        advance (FEEDBACK);
+        const float* __restrict damp = smoothed_[DAMPING].current;
+        const float* __restrict feedback = smoothed_[FEEDBACK].current;
+
+        for (int stream = 0; stream < num_active_streams_; ++stream)
+        {
+            input[stream] = (left[stream] + right[stream]) * input_gains_[stream];
+            out_left[stream] = 0.0f;
+            out_right[stream] = 0.0f;
+        }
+
+        // Comb filters in parallel, then the allpasses in series
+        for (auto& comb : combs_)
+        {
+            processComb (comb[0], input, out_left, damp, feedback);
+            processComb (comb[1], input, out_right, damp, feedback);
+        }
+
+        for (auto& allpass : allpasses_)
+        {
+            processAllpass (allpass[0], out_left);
+            processAllpass (allpass[1], out_right);
+        }
+
+        advance (DRY_GAIN);
+        advance (WET_GAIN_1);
+        advance (WET_GAIN_2);
+        const float* __restrict dry = smoothed_[DRY_GAIN].current;
+        const float* __restrict wet_1 = smoothed_[WET_GAIN_1].current;
+        const float* __restrict wet_2 = smoothed_[WET_GAIN_2].current;
+        for (int stream = 0; stream < num_active_streams_; ++stream)
+        {
+            left[stream] = out_left[stream] * wet_1[stream] + out_right[stream] * wet_2[stream] + left[stream] * dry[stream];
+            right[stream] = out_right[stream] * wet_1[stream] + out_left[stream] * wet_2[stream] + right[stream] * dry[stream];
+        }
+    }
+}
+
+void FreeverbBatch::processMono (int num_samples)
+{
+    float* __restrict input = input_;
+    float* __restrict output = output_[0];
+
+    for (int i = 0; i < num_samples; ++i)
+    {
+        float* __restrict samples = block_[0] + i * num_streams_;
+        advance (DAMPING);
+        advance (FEEDBACK);
+        const float* __restrict damp = smoothed_[DAMPING].current;
+        const float* __restrict feedback = smoothed_[FEEDBACK].current;
+
+        for (int stream = 0; stream < num_active_streams_; ++stream)
+        {
+            input[stream] = samples[stream] * input_gains_[stream];
+            output[stream] = 0.0f;
+        }
+
+        for (auto& comb : combs_)
+            processComb (comb[0], input, output, damp, feedback);
+
+        for (auto& allpass : allpasses_)
+            processAllpass (allpass[0], output);
+
+        advance (DRY_GAIN);
+        advance (WET_GAIN_1);
+        const float* __restrict dry = smoothed_[DRY_GAIN].current;
+        const float* __restrict wet_1 = smoothed_[WET_GAIN_1].current;
+        for (int stream = 0; stream < num_active_streams_; ++stream)
+            samples[stream] = output[stream] * wet_1[stream] + samples[stream] * dry[stream];
+    }
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    FreeverbBatch.h
+    Created: 19 Oct 2026 8:14:26pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Freeverb.h"
+#include <Arena.h>
+#include <JuceHeader.h>
+
+// Many independent mono or stereo streams through one Freeverb, for rendering a large number
+// of stems offline and for the instances on a ReverbBus.
+//
+// Every delay line holds the same line of all streams side by side, the sample of stream s at
+// position n sits at n * num_streams + s. All streams share the read position and the tuning,
+// and every stream has its own smoothed parameters in arrays next to each other, so a step of
+// a filter is a straight loop over the streams that the compiler turns into SIMD, with one
+// stream per lane. Each stream comes out bit-identical to a Freeverb with 32 bit lines and the
+// same parameters.
+//
+// The lines and the scratch buffers are carved out of an arena that the caller prepares with
+// getRequiredBytes().
+class FreeverbBatch
+{
+public:
+    FreeverbBatch();
+
+    static size_t getRequiredBytes (double sample_rate, int num_streams, int num_channels, int max_block_size);
+
+    // num_channels is 1 for mono streams or 2 for stereo streams
+    void prepare (double sample_rate, int num_streams, int num_channels, int max_block_size, Arena& arena);
+    void reset();
+    // Clears the lines and filter memories of one stream only, the others keep their tails.
+    // Its parameters start over from the ones of setParameters like after prepare.
+    void clearStream (int stream);
+
+    int getNumStreams() const { return num_streams_; }
+    int getNumChannels() const { return num_channels_; }
+
+    // The parameters of every stream. prepare() starts all streams from the last ones set here.
+    void setParameters (const juce::Reverb::Parameters& parameters);
+    // The parameters of one stream, it glides to them like a Freeverb of its own
+    void setStreamParameters (int stream, const juce::Reverb::Parameters& parameters);
+
+    // Only the first num_streams streams run, the others keep their state until they run again.
+    // All of them run after prepare().
+    void setNumActiveStreams (int num_streams);
+    int getNumActiveStreams() const { return num_active_streams_; }
+
+    // Processes the active streams in place. Channel c of stream s is
+    // channels[s * num_channels + c], num_samples is at most the max_block_size of prepare().
+    void process (float* const* channels, int num_samples);
+
+private:
+    static constexpr int MAX_CHANNELS = 2;
+
+    enum Smoothed
+    {
+        DAMPING = 0,
+        FEEDBACK,
+        DRY_GAIN,
+        WET_GAIN_1,
+        WET_GAIN_2,
+        NUM_SMOOTHED
+    };
+
+    // A juce::SmoothedValue with linear steps for every stream, the current values are what
+    // the filters read
+    struct SmoothedStreams
+    {
+        float* current = nullptr;
+        float* target = nullptr;
+        float* step = nullptr;
+        int* countdown = nullptr;
+    };
+
+    struct DelayLine
+    {
+        // size rows of one sample per stream
+        float* buffer = nullptr;
+        // Filter memory of each stream, combs only
+        float* last = nullptr;
+        int size = 0;
+        int index = 0;
+    };
+
+    void setTargetValue (Smoothed smoothed, int stream, float target);
+    void setCurrentAndTargetValue (Smoothed smoothed, int stream, float value);
+    void resetStreamParameters (int stream);
+    // One step of every active stream, the same steps as juce::SmoothedValue::getNextValue()
+    void advance (Smoothed smoothed);
+
+    void processComb (DelayLine& comb, const float* input, float* output, const float* damp, const float* feedback);
+    void processAllpass (DelayLine& allpass, float* samples);
+    void processStereo (int num_samples);
+    void processMono (int num_samples);
+
+    DelayLine combs_[Freeverb::NUM_COMBS][MAX_CHANNELS];
+    DelayLine allpasses_[Freeverb::NUM_ALLPASSES][MAX_CHANNELS];
+    int num_streams_ = 0;
+    int num_active_streams_ = 0;
+    int num_channels_ = 0;
+
+    // Every channel of the block with the streams interleaved, and the comb input and the
+    // output of one sample
+    float* block_[MAX_CHANNELS] = {};
+    float* input_ = nullptr;
+    float* output_[MAX_CHANNELS] = {};
+
+    // Parameters of the last setParameters(), and the input gain and smoothed values of
+    // every stream
+    Freeverb::Gains gains_;
+    float* input_gains_ = nullptr;
+    SmoothedStreams smoothed_[NUM_SMOOTHED];
+    int steps_to_target_ = 0;
+};
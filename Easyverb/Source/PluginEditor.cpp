@@ -15,16 +15,17 @@ constexpr int WINDOW_HEIGHT = 400 + TOP_SECTION_HEIGHT;
 
 //==============================================================================
 EasyverbAudioProcessorEditor::EasyverbAudioProcessorEditor (EasyverbAudioProcessor& p)
-    : AudioProcessorEditor (&p), info_button_ (juce::Colours::darkgrey), audioProcessor (p)
+    : AudioProcessorEditor (&p), info_button_ (juce::Colours::darkgrey), governor_display_ (p.getGovernor(), juce::Colours::chocolate), audioProcessor (p)
 {
     constexpr int TEXT_BOX_SIZE = 25;
 
-    SetupTrianglePattern();
-
-    for (const auto& component : triangle_pattern_)
-    {
-        addAndMakeVisible (*component);
-    }
+    // The 56 triangles are most of the cost of opening the editor, so they come once the
+    // host has the window up and the knobs work without them
+    juce::MessageManager::callAsync ([editor = juce::Component::SafePointer<EasyverbAudioProcessorEditor> (this)]
+                                     {
+                                         if (editor != nullptr)
+                                             editor->addTrianglePattern();
+                                     });
 
     reverb_slider_.setColour (juce::Slider::thumbColourId, juce::Colours::chocolate);
     reverb_slider_.setSliderStyle (juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag);
@@ -42,6 +43,8 @@ EasyverbAudioProcessorEditor::EasyverbAudioProcessorEditor (EasyverbAudioProcess
 
     mix_slider_attachment_ = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (audioProcessor.apvts, "MIX", mix_slider_);
 
+    addAndMakeVisible (governor_display_);
+
     info_button_.addToEditor (this);
     setSize (WINDOW_WIDTH, WINDOW_HEIGHT);
 }
@@ -73,6 +76,7 @@ void EasyverbAudioProcessorEditor::resized()
 {
     info_button_.button.setBounds (getWidth() - 35, 10, 20, 20);
     info_button_.info_text.setBounds (30, 50, getWidth() - 60, getHeight() - 100);
+    governor_display_.setBounds (10, getHeight() - 25, 200, 20);
     SetupSections();
     reverb_slider_.setBounds (reverb_section_);
     mix_slider_.setBounds (mix_section_);
@@ -83,6 +87,19 @@ void EasyverbAudioProcessorEditor::resized()
     }
 }
 
+void EasyverbAudioProcessorEditor::addTrianglePattern()
+{
+    SetupTrianglePattern();
+
+    // Behind the knobs, which are already there, in the order of the pattern
+    int z_order = 0;
+    for (const auto& component : triangle_pattern_)
+    {
+        addAndMakeVisible (*component, z_order++);
+        component->setBounds (getLocalBounds().withSizeKeepingCentre (WINDOW_WIDTH, WINDOW_HEIGHT));
+    }
+}
+
 void EasyverbAudioProcessorEditor::SetupTrianglePattern()
 {
     const int component_width = 50;
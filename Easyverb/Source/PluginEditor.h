@@ -10,6 +10,7 @@
 
 #include "AnimatedTriangle.h"
 #include "PluginProcessor.h"
+#include <CpuGovernorDisplay.h>
 #include <InfoButton.h>
 #include <JuceHeader.h>
 
@@ -31,10 +32,12 @@ public:
     void resized() override;
 
 private:
+    void addTrianglePattern();
     void SetupTrianglePattern();
     void SetupSections();
     void sliderValueChanged (juce::Slider* slider) override;
     InfoButton info_button_;
+    CpuGovernorDisplay governor_display_;
 
     std::vector<std::shared_ptr<AnimatedTriangle>> triangle_pattern_;
 
@@ -9,6 +9,21 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+// Parameters stored in presets, in the order of the Parameter enum.
+const juce::StringArray PARAMETER_IDS { "REVERB", "MIX" };
+
+// Comb filters per reverb at each level of the CPU governor, the tail gets sparser but keeps
+// its length
+constexpr int GOVERNOR_COMBS[] = { 8, 6, 4 };
+
+// One thread builds the DSP of every instance, a session that loads hundreds of them does not
+// start hundreds of threads
+static juce::ThreadPool& getDspBuildPool()
+{
+    static juce::ThreadPool pool (1);
+    return pool;
+}
+
 //==============================================================================
 EasyverbAudioProcessor::EasyverbAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -20,19 +35,31 @@ EasyverbAudioProcessor::EasyverbAudioProcessor()
                           .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
 #endif
                           ),
-      apvts (*this, nullptr, "Parameters", createParameters())
+      apvts (*this, nullptr, "Parameters", createParameters()),
+      program_switcher_ (apvts, PARAMETER_IDS)
 #endif
 {
-    params_.roomSize = 0.5f;
-    params_.damping = 0.8f;
-    params_.width = 0.5f;
-    params_.freezeMode = 0.0f;
-    params_.dryLevel = 0.0f;
-    params_.wetLevel = 1.0f;
+    // A bank file next to the other plugin data replaces the factory presets.
+    if (! program_switcher_.getBank().loadFromFile (PresetBank::getDefaultBankFile()))
+    {
+        addFactoryPresets();
+    }
+
+    apvts.addParameterListener ("ECO", this);
+    apvts.addParameterListener ("PRECISION", this);
+    apvts.addParameterListener ("OFFLINE_QUALITY", this);
+    apvts.addParameterListener ("SHARED_BUS", this);
 }
 
 EasyverbAudioProcessor::~EasyverbAudioProcessor()
 {
+    apvts.removeParameterListener ("ECO", this);
+    apvts.removeParameterListener ("PRECISION", this);
+    apvts.removeParameterListener ("OFFLINE_QUALITY", this);
+    apvts.removeParameterListener ("SHARED_BUS", this);
+    cancelPendingUpdate();
+    waitForDspBuild();
+    leaveBus();
 }
 
 //==============================================================================
@@ -75,26 +102,28 @@ double EasyverbAudioProcessor::getTailLengthSeconds() const
 
 int EasyverbAudioProcessor::getNumPrograms()
 {
-    return 1; // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    return program_switcher_.getNumPrograms(); // NB: some hosts don't cope very well if you tell them there are 0 programs,
         // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int EasyverbAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return program_switcher_.getCurrentProgram();
 }
 
-void EasyverbAudioProcessor::setCurrentProgram (int /*index*/)
+void EasyverbAudioProcessor::setCurrentProgram (int index)
 {
+    program_switcher_.setCurrentProgram (index);
 }
 
-const juce::String EasyverbAudioProcessor::getProgramName (int /*index*/)
+const juce::String EasyverbAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return program_switcher_.getProgramName (index);
 }
 
-void EasyverbAudioProcessor::changeProgramName (int /*index*/, const juce::String& /*newName*/)
+void EasyverbAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    program_switcher_.changeProgramName (index, newName);
 }
 
 //==============================================================================
@@ -102,25 +131,229 @@ void EasyverbAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
 {
     juce::dsp::ProcessSpec spec = { sampleRate, static_cast<juce::uint32> (samplesPerBlock), static_cast<juce::uint32> (getMainBusNumOutputChannels()) };
 
-    reverb_.prepare (spec);
+    program_switcher_.prepare (sampleRate);
+
+    offline_ = isNonRealtime();
+    prepareReverb (sampleRate, samplesPerBlock);
+    governor_.prepare (sampleRate, samplesPerBlock, static_cast<int> (std::size (GOVERNOR_COMBS)));
+
+    const int num_channels = static_cast<int> (spec.numChannels);
+    shelf_.prepare (num_channels);
+    high_pass_.prepare (num_channels);
+    EasyverbCore::setFilterCoefficients (shelf_, high_pass_, sampleRate);
+    micro_channels_.resize (static_cast<size_t> (num_channels));
+    segment_channels_.resize (static_cast<size_t> (num_channels));
+}
+
+int EasyverbAudioProcessor::getRateDivider (double sample_rate) const
+{
+    // Eco mode halves the reverb rate once or twice, but never below 44.1 kHz
+    const auto eco_steps = static_cast<int> (apvts.getRawParameterValue ("ECO")->load());
+    int divider = 1;
+
+    for (int step = 0; step < eco_steps && sample_rate / (divider * 2) >= 44100.0; ++step)
+    {
+        divider *= 2;
+    }
+    return divider;
+}
+
+Freeverb::Precision EasyverbAudioProcessor::getDelayPrecision() const
+{
+    return static_cast<Freeverb::Precision> (static_cast<int> (apvts.getRawParameterValue ("PRECISION")->load()));
+}
+
+EasyverbAudioProcessor::ReverbSettings EasyverbAudioProcessor::getReverbSettings (Tier tier, double sample_rate) const
+{
+    // The best offline quality is the reverb at the host rate with 32 bit delay lines
+    if (tier == OFFLINE && apvts.getRawParameterValue ("OFFLINE_QUALITY")->load() > 0.5f)
+        return {};
+
+    return { getRateDivider (sample_rate), getDelayPrecision() };
+}
+
+void EasyverbAudioProcessor::prepareReverb (double sample_rate, int samples_per_block)
+{
+    // The audio thread is held here, it lets go of the old DSP and plays the delayed dry
+    // signal until the new one is built
+    waitForDspBuild();
+    ready_dsp_ = nullptr;
+    dsp_ = std::make_unique<Dsp>();
+
+    // The shared bus delays the wet signal by a block, the dry signal has to wait as long
+    const bool shared = wantsBus();
+
+    dsp_settings_.sample_rate = sample_rate;
+    dsp_settings_.samples_per_block = samples_per_block;
+    dsp_settings_.num_channels = getMainBusNumOutputChannels();
+    dsp_settings_.max_wet_latency = MAX_WET_LATENCY + (shared ? samples_per_block : 0);
+    for (auto tier : { REALTIME, OFFLINE })
+    {
+        const auto settings = getReverbSettings (tier, sample_rate);
+        dsp_settings_.tiers[static_cast<size_t> (tier)] = settings;
+        dsp_settings_.wet_latencies[static_cast<size_t> (tier)] = ReverbEngine::computeLatencySamples (settings.rate_divider);
+    }
+    has_offline_engine_ = ! (dsp_settings_.tiers[OFFLINE] == dsp_settings_.tiers[REALTIME]);
+
+    // Members of a bus always have identical settings, so any change means another bus. The
+    // member starts on its own engine until the transport plays.
+    leaveBus();
+    if (shared)
+        bus_ = ReverbBus::join (getBusSettings (sample_rate, samples_per_block), bus_member_);
+
+    setLatencySamples (juce::roundToInt (getWetLatencySamples()));
+
+    // Small enough to prepare here. The audio thread mixes with it from its next block on, at
+    // the latency above until it switches tier or path on the new DSP.
+    mix_arena_.prepare (DryWetMix::getRequiredBytes (dsp_settings_.num_channels, samples_per_block, dsp_settings_.max_wet_latency));
+    mix_.prepare (sample_rate, dsp_settings_.num_channels, samples_per_block, dsp_settings_.max_wet_latency, mix_arena_);
+    mix_.setWetLatency (getWetLatencySamples());
+
+    // The reverbs come back with all combs, the next block applies the governor level again
+    governor_level_ = 0;
+
+    // Carving clears megabytes of delay lines, which is no work for the audio thread while it
+    // plays. Before the first block and for a bounce nothing waits for this thread, so the
+    // reverb is there from the first sample on.
+    if (isNonRealtime() || ! processing_.load())
+        buildDsp();
+    else
+        getDspBuildPool().addJob (&dsp_build_, false);
+}
+
+void EasyverbAudioProcessor::buildDsp()
+{
+    auto& dsp = *dsp_;
+    const auto& settings = dsp_settings_;
+    const auto& realtime = settings.tiers[REALTIME];
+    const auto& offline = settings.tiers[OFFLINE];
+
+    // The reverbs only ever see one micro block, the dry signal of a whole block is kept for
+    // the shared bus
+    const int scratch_size = MicroBlocks::getScratchSize (settings.samples_per_block);
+
+    // Everything is carved from the start of the arena, the scratch buffers and delay lines
+    // of the realtime reverb first.
+    dsp.arena.prepare (ReverbEngine::getRequiredBytes (settings.sample_rate, scratch_size, settings.num_channels, realtime.rate_divider, realtime.precision)
+                       + (has_offline_engine_ ? ReverbEngine::getRequiredBytes (settings.sample_rate, scratch_size, settings.num_channels, offline.rate_divider, offline.precision) : 0));
+    dsp.reverbs[REALTIME].prepare (settings.sample_rate, scratch_size, settings.num_channels, realtime.rate_divider, realtime.precision, dsp.arena);
+    if (has_offline_engine_)
+        dsp.reverbs[OFFLINE].prepare (settings.sample_rate, scratch_size, settings.num_channels, offline.rate_divider, offline.precision, dsp.arena);
+
+    ready_dsp_.store (&dsp, std::memory_order_release);
+}
+
+juce::ThreadPoolJob::JobStatus EasyverbAudioProcessor::DspBuild::runJob()
+{
+    processor.buildDsp();
+    return jobHasFinished;
+}
 
-    mix_.prepare (spec);
+void EasyverbAudioProcessor::waitForDspBuild()
+{
+    // Takes the job off the queue when it has not started yet and waits for it otherwise
+    getDspBuildPool().removeJob (&dsp_build_, false, -1);
+}
 
-    filter_ch1_.prepare (spec);
-    filter_ch1_.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf (sampleRate, 1200.0f, 2.1f, 0.6f);
-    hp_ch1_.prepare (spec);
-    hp_ch1_.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass (sampleRate, 110.0f, 3.0f);
+ReverbBus::Settings EasyverbAudioProcessor::getBusSettings (double sample_rate, int samples_per_block) const
+{
+    return { sample_rate, samples_per_block, getMainBusNumOutputChannels() };
+}
 
-    filter_ch2_.prepare (spec);
-    filter_ch2_.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf (sampleRate, 1194.0f, 2.0f, 0.6f);
-    hp_ch2_.prepare (spec);
-    hp_ch2_.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass (sampleRate, 110.0, 3.1f);
+void EasyverbAudioProcessor::leaveBus()
+{
+    if (bus_ != nullptr)
+        bus_->leave (bus_member_);
+    bus_.reset();
+    bus_member_ = {};
+    on_bus_ = false;
+}
+
+void EasyverbAudioProcessor::switchBus (Dsp& dsp, bool on_bus)
+{
+    on_bus_ = on_bus;
+
+    // The own engine may still hold the tail from before the bus took over
+    if (! on_bus)
+        getReverb (dsp).reset();
+    mix_.setWetLatency (getWetLatencySamples());
+
+    // The host is told about the new latency from the message thread
+    triggerAsyncUpdate();
+}
+
+void EasyverbAudioProcessor::switchTier (Dsp& dsp, bool offline)
+{
+    offline_ = offline;
+
+    // The engine may still hold the tail of its last use
+    auto& reverb = getReverb (dsp);
+    reverb.reset();
+    mix_.setWetLatency (getWetLatencySamples());
+
+    // The host is told about the new latency from the message thread
+    triggerAsyncUpdate();
+}
+
+void EasyverbAudioProcessor::applyGovernorLevel (Dsp& dsp, int level)
+{
+    governor_level_ = level;
+
+    // Both engines, so a tier switch does not bring the load back
+    for (auto& reverb : dsp.reverbs)
+        reverb.setNumCombs (GOVERNOR_COMBS[level]);
+}
+
+size_t EasyverbAudioProcessor::getDspMemoryBytes() const
+{
+    size_t bytes = shelf_.getMemoryBytes() + high_pass_.getMemoryBytes() + mix_arena_.getCapacity();
+
+    // Nothing else to count while the DSP is being built
+    if (const auto* dsp = ready_dsp_.load())
+    {
+        bytes += dsp->arena.getCapacity() + dsp->reverbs[REALTIME].getFilterMemoryBytes();
+        if (has_offline_engine_)
+            bytes += dsp->reverbs[OFFLINE].getFilterMemoryBytes();
+    }
+    return bytes;
+}
+
+void EasyverbAudioProcessor::parameterChanged (const juce::String& /*parameter_id*/, float /*new_value*/)
+{
+    // Can be called from any thread, the reverb is prepared again on the message thread
+    triggerAsyncUpdate();
+}
+
+void EasyverbAudioProcessor::handleAsyncUpdate()
+{
+    if (getSampleRate() <= 0.0)
+        return;
+
+    const bool bus_prepared = wantsBus() ? bus_ != nullptr && bus_->getSettings() == getBusSettings (getSampleRate(), getBlockSize()) : bus_ == nullptr;
+
+    if (getReverbSettings (REALTIME, getSampleRate()) == getPreparedSettings (REALTIME)
+        && getReverbSettings (OFFLINE, getSampleRate()) == getPreparedSettings (OFFLINE)
+        && bus_prepared)
+    {
+        // Only the tier or the path through the bus changed, the audio thread has already
+        // switched engines
+        setLatencySamples (juce::roundToInt (getWetLatencySamples()));
+        return;
+    }
+
+    // A new rate or precision carves the arena again and a new rate changes the latency, so
+    // hold the audio callback while the reverb is prepared again. The same goes for joining
+    // or leaving a shared bus.
+    suspendProcessing (true);
+    prepareReverb (getSampleRate(), getBlockSize());
+    suspendProcessing (false);
 }
 
 void EasyverbAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    processing_ = false;
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -130,10 +363,9 @@ bool EasyverbAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
 #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout is supported, every channel gets its own filter state and channel
+    // pairs share a stereo reverb.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
         // This checks if the input layout matches the output layout
@@ -150,6 +382,7 @@ bool EasyverbAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 void EasyverbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& /*midiMessages*/)
 {
     juce::ScopedNoDenormals noDenormals;
+    juce::AudioProcessLoadMeasurer::ScopedTimer timer (governor_.getLoadMeasurer(), buffer.getNumSamples());
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -162,37 +395,91 @@ void EasyverbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    mix_.pushDrySamples (buffer);
+    ParameterValues values;
+    processing_.store (true, std::memory_order_relaxed);
 
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    // Until the DSP is built off the audio thread only the dry signal plays, at the latency
+    // and the level it has in the mix
+    auto* dsp = ready_dsp_.load (std::memory_order_acquire);
+    if (dsp == nullptr)
     {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
-        {
-            if (channel == 0)
-            {
-                *buffer.getWritePointer (channel, sample) = filter_ch1_.processSample (*buffer.getReadPointer (channel, sample));
-                *buffer.getWritePointer (channel, sample) = hp_ch1_.processSample (*buffer.getReadPointer (channel, sample));
-            }
-            else if (channel == 1)
-            {
-                *buffer.getWritePointer (channel, sample) = filter_ch2_.processSample (*buffer.getReadPointer (channel, sample));
-                *buffer.getWritePointer (channel, sample) = hp_ch2_.processSample (*buffer.getReadPointer (channel, sample));
-            }
-        }
+        program_switcher_.readParametersForBlock (values, buffer.getNumSamples());
+        mix_.setWetMixProportion (values[MIX]);
+        mix_.pushDrySamples (buffer.getArrayOfReadPointers(), totalNumOutputChannels, buffer.getNumSamples());
+        for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+            buffer.clear (channel, 0, buffer.getNumSamples());
+        mix_.mixDrySamples (buffer.getArrayOfWritePointers(), totalNumOutputChannels, buffer.getNumSamples());
+        return;
     }
 
-    auto block = juce::dsp::AudioBlock<float> (buffer);
-    auto contextToUse = juce::dsp::ProcessContextReplacing<float> (block);
+    // Hosts may start or stop rendering offline without preparing again
+    if (isNonRealtime() != offline_.load())
+        switchTier (*dsp, isNonRealtime());
+
+    // Bounces have no deadline to keep
+    governor_.setEnabled (apvts.getRawParameterValue ("GOVERNOR")->load() > 0.5f && ! isNonRealtime());
+    const int governor_level = governor_.update (buffer.getNumSamples());
+    if (governor_level != governor_level_)
+        applyGovernorLevel (*dsp, governor_level);
+
+    auto& mix = mix_;
 
-    float reverb_amount = apvts.getRawParameterValue ("REVERB")->load();
-    params_.roomSize = reverb_amount;
-    params_.damping = 0.6f - reverb_amount / 2.0f;
+    if (bus_ != nullptr)
+        bus_member_.advance (getPlayHead(), buffer.getNumSamples());
 
-    reverb_.setParameters (params_);
-    reverb_.process (contextToUse);
+    // Bounces and freezes render at their own pace, they cannot keep in step with the bus
+    const bool on_bus = bus_ != nullptr && bus_member_.synced && ! isNonRealtime();
+    if (on_bus != on_bus_.load())
+        switchBus (*dsp, on_bus);
 
-    mix_.setWetMixProportion (apvts.getRawParameterValue ("MIX")->load());
-    mix_.mixWetSamples (block);
+    if (on_bus)
+    {
+        // The bus takes the inputs of its members by host block, so this path runs on whole
+        // blocks. The mix and the reverb of the bus glide to new values on their own.
+        program_switcher_.readParametersForBlock (values, buffer.getNumSamples());
+        mix.setWetMixProportion (values[MIX]);
+        mix.pushDrySamples (buffer.getArrayOfReadPointers(), totalNumOutputChannels, buffer.getNumSamples());
+
+        shelf_.process (buffer.getArrayOfWritePointers(), totalNumInputChannels, buffer.getNumSamples());
+        high_pass_.process (buffer.getArrayOfWritePointers(), totalNumInputChannels, buffer.getNumSamples());
+
+        mix.applyWetVolume (buffer.getArrayOfWritePointers(), totalNumInputChannels, buffer.getNumSamples());
+        bus_->setReverb (bus_member_, values[REVERB]);
+        if (! bus_->addInput (buffer, totalNumInputChannels, bus_member_)
+            || ! bus_->readOutput (buffer, totalNumInputChannels, bus_member_))
+        {
+            // Out of step with the bus, the own engine takes over from this block on
+            switchBus (*dsp, false);
+            auto& reverb = getReverb (*dsp);
+            reverb.setParameters (EasyverbCore::getReverbParameters (values[REVERB]));
+
+            MicroBlocks::forEach (buffer.getNumSamples(), [&] (int first_sample, int num_samples) {
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                    micro_channels_[static_cast<size_t> (channel)] = buffer.getWritePointer (channel, first_sample);
+                reverb.process (micro_channels_.data(), totalNumInputChannels, num_samples);
+            });
+        }
+
+        mix.mixDrySamples (buffer.getArrayOfWritePointers(), totalNumOutputChannels, buffer.getNumSamples());
+        return;
+    }
+
+    auto& reverb = getReverb (*dsp);
+
+    // A program crossfade hands out its values in short steps, see ProgramSwitcher
+    for (int first_sample = 0; first_sample < buffer.getNumSamples();)
+    {
+        const int num_samples = program_switcher_.readParameters (values, buffer.getNumSamples() - first_sample);
+        mix.setWetMixProportion (values[MIX]);
+        reverb.setParameters (EasyverbCore::getReverbParameters (values[REVERB]));
+
+        // The dry copy and the signal stay in L1 from the filters to the mix, see MicroBlocks
+        // Input and output layouts always match, see isBusesLayoutSupported()
+        for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+            segment_channels_[static_cast<size_t> (channel)] = buffer.getWritePointer (channel, first_sample);
+        makeEasyverbChain (mix, shelf_, high_pass_, reverb).process (segment_channels_.data(), totalNumOutputChannels, num_samples, micro_channels_);
+        first_sample += num_samples;
+    }
 }
 
 //==============================================================================
@@ -232,11 +519,44 @@ juce::AudioProcessorValueTreeState::ParameterLayout EasyverbAudioProcessor::crea
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
 
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("REVERB", "Reverb", 0.0f, 1.0f, 0.5f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("MIX", "Mix", 0.0f, 1.0f, 0.2f));
+    // The parameters of the core first, then the ones only the plugin has
+    CoreParameterLayout::addParameters (parameters, EasyverbCore::PARAMETERS);
+    // Bounces run the reverb at the host rate with 32 bit delay lines, whatever eco and delay
+    // precision say
+    parameters.push_back (std::make_unique<juce::AudioParameterChoice> ("OFFLINE_QUALITY", "Offline quality", juce::StringArray { "Same as realtime", "Best" }, 1));
+    // Thins out the reverb when processing gets close to the buffer deadline
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("GOVERNOR", "CPU governor", false));
+    // Instances with the same sample rate, block size and channels run their reverbs together,
+    // see ReverbBus
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("SHARED_BUS", "Shared bus", false));
     return { parameters.begin(), parameters.end() };
 }
 
+void EasyverbAudioProcessor::addFactoryPresets()
+{
+    auto& bank = program_switcher_.getBank();
+
+    juce::StringPairArray small_room;
+    small_room.set ("REVERB", "0.25");
+    small_room.set ("MIX", "0.15");
+    bank.addPreset ("Small Room", small_room);
+
+    juce::StringPairArray hall;
+    hall.set ("REVERB", "0.7");
+    hall.set ("MIX", "0.3");
+    bank.addPreset ("Hall", hall);
+
+    juce::StringPairArray cathedral;
+    cathedral.set ("REVERB", "0.95");
+    cathedral.set ("MIX", "0.5");
+    bank.addPreset ("Cathedral", cathedral);
+
+    juce::StringPairArray wash;
+    wash.set ("REVERB", "1.0");
+    wash.set ("MIX", "1.0");
+    bank.addPreset ("Wash", wash);
+}
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -8,12 +8,25 @@
 
 #pragma once
 
+#include "DryWetMix.h"
+#include "EasyverbCore.h"
+#include "EasyverbStages.h"
+#include "ReverbBus.h"
+#include "ReverbEngine.h"
+#include <Arena.h>
+#include <CoreParameterLayout.h>
+#include <CpuGovernor.h>
 #include <JuceHeader.h>
+#include <MicroBlocks.h>
+#include <MultiChannelBiquad.h>
+#include <PresetBank.h>
 
 //==============================================================================
 /**
 */
-class EasyverbAudioProcessor : public juce::AudioProcessor
+class EasyverbAudioProcessor : public juce::AudioProcessor,
+                               private juce::AudioProcessorValueTreeState::Listener,
+                               private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -53,18 +66,133 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    // Bytes of DSP memory this instance holds: the arena with the delay lines and scratch
+    // buffers plus the filter state. Changes when the processor is prepared again.
+    size_t getDspMemoryBytes() const;
+    // Load and quality level of the opt-in CPU governor, level n runs the reverbs with
+    // GOVERNOR_COMBS[n] comb filters
+    const CpuGovernor& getGovernor() const { return governor_; }
+
     juce::AudioProcessorValueTreeState apvts;
 
 private:
-    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+    // Parameters that make up a preset, in the order of the ids in PARAMETER_IDS
+    enum Parameter
+    {
+        REVERB = 0,
+        MIX,
+        NUM_PARAMETERS
+    };
 
-    juce::dsp::Reverb reverb_;
-    juce::Reverb::Parameters params_;
-    juce::dsp::IIR::Filter<float> filter_ch1_;
-    juce::dsp::IIR::Filter<float> hp_ch1_;
-    juce::dsp::IIR::Filter<float> filter_ch2_;
-    juce::dsp::IIR::Filter<float> hp_ch2_;
-    juce::dsp::DryWetMixer<float> mix_;
+    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+    void addFactoryPresets();
+
+    // Playback runs the reverb with the quality parameters, bounces may run a better one.
+    // Both are prepared up front, so switching when the host starts or stops rendering
+    // offline never allocates.
+    enum Tier
+    {
+        REALTIME = 0,
+        OFFLINE,
+        NUM_TIERS
+    };
+
+    struct ReverbSettings
+    {
+        int rate_divider = 1;
+        Freeverb::Precision precision = Freeverb::Precision::float32;
+
+        bool operator== (const ReverbSettings& other) const { return rate_divider == other.rate_divider && precision == other.precision; }
+    };
+
+    int getRateDivider (double sample_rate) const;
+    Freeverb::Precision getDelayPrecision() const;
+    ReverbSettings getReverbSettings (Tier tier, double sample_rate) const;
+    ReverbSettings getPreparedSettings (Tier tier) const { return dsp_settings_.tiers[static_cast<size_t> (tier)]; }
+
+    // Everything carved out of the arena. Built off the audio thread, see prepareReverb().
+    struct Dsp
+    {
+        Arena arena;
+        std::array<ReverbEngine, NUM_TIERS> reverbs;
+    };
+
+    // What the next build of the DSP is for, the latencies are known before it is done
+    struct DspSettings
+    {
+        double sample_rate = 44100.0;
+        int samples_per_block = 0;
+        int num_channels = 0;
+        int max_wet_latency = 0;
+        std::array<ReverbSettings, NUM_TIERS> tiers;
+        std::array<float, NUM_TIERS> wet_latencies {};
+    };
+
+    // Runs buildDsp() on the build thread all instances share
+    struct DspBuild : public juce::ThreadPoolJob
+    {
+        explicit DspBuild (EasyverbAudioProcessor& owner) : juce::ThreadPoolJob ("Easyverb DSP"), processor (owner) {}
+        JobStatus runJob() override;
+
+        EasyverbAudioProcessor& processor;
+    };
+
+    // The offline tier runs on the realtime engine when both have the same settings
+    int getEngineIndex (Tier tier) const { return tier == OFFLINE && has_offline_engine_ ? OFFLINE : REALTIME; }
+    Tier getTier() const { return offline_.load() ? OFFLINE : REALTIME; }
+    ReverbEngine& getReverb (Dsp& dsp) { return dsp.reverbs[static_cast<size_t> (getEngineIndex (getTier()))]; }
+    void prepareReverb (double sample_rate, int samples_per_block);
+    // Carves the arena of dsp_ for dsp_settings_ and hands it to the audio thread
+    void buildDsp();
+    // Message thread: returns once no build of this instance is running or waiting
+    void waitForDspBuild();
+    bool wantsBus() const { return apvts.getRawParameterValue ("SHARED_BUS")->load() > 0.5f && ReverbBus::canShare (getMainBusNumOutputChannels()); }
+    ReverbBus::Settings getBusSettings (double sample_rate, int samples_per_block) const;
+    void leaveBus();
+    // Audio thread: moves the wet path onto the bus or back to the own engine
+    void switchBus (Dsp& dsp, bool on_bus);
+    // Latency of the path the wet signal currently takes
+    float getWetLatencySamples() const { return bus_ != nullptr && on_bus_.load() ? bus_->getLatencySamples() : dsp_settings_.wet_latencies[static_cast<size_t> (getTier())]; }
+    void switchTier (Dsp& dsp, bool offline);
+    void applyGovernorLevel (Dsp& dsp, int level);
+    void parameterChanged (const juce::String& parameter_id, float new_value) override;
+    void handleAsyncUpdate() override;
+
+    ProgramSwitcher program_switcher_;
+
+    // Room for the latency of the quarter rate mode, the dry signal is delayed to match
+    static constexpr int MAX_WET_LATENCY = 64;
+
+    // Owned here and changed on the message thread with the audio thread held, which only
+    // sees it through ready_dsp_ once the build is done
+    std::unique_ptr<Dsp> dsp_;
+    std::atomic<Dsp*> ready_dsp_ { nullptr };
+    // Prepared with the audio thread held, so the delayed dry signal plays while the DSP is
+    // being built
+    Arena mix_arena_;
+    DryWetMix mix_;
+    // Set by the first block after prepareToPlay(), until then the DSP is built right away
+    std::atomic<bool> processing_ { false };
+    DspSettings dsp_settings_;
+    DspBuild dsp_build_ { *this };
+    bool has_offline_engine_ = false;
+    // Set while "Shared bus" is on. Changes only with processing suspended.
+    std::shared_ptr<ReverbBus> bus_;
+    ReverbBus::Member bus_member_;
+    // Set on the audio thread while the wet signal comes from the bus, read when reporting
+    // the latency
+    std::atomic<bool> on_bus_ { false };
+    // Set on the audio thread from isNonRealtime(), read when reporting the latency
+    std::atomic<bool> offline_ { false };
+
+    CpuGovernor governor_;
+    int governor_level_ = 0;
+    MultiChannelBiquad shelf_;
+    MultiChannelBiquad high_pass_;
+    // Channel pointers of the micro block the stages run on, see StageChain
+    std::vector<float*> micro_channels_;
+    // The host buffer's channels from the start of the current program segment
+    std::vector<float*> segment_channels_;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EasyverbAudioProcessor)
@@ -0,0 +1,414 @@
+/*
+  ==============================================================================
+
+    ReverbBus.cpp
+    Created: 19 Oct 2026 2:17:45pm
+
+  ==============================================================================
+*/
+
+#include "ReverbBus.h"
+#include "EasyverbCore.h"
+
+namespace
+{
+    // Weak references, a bus lives exactly as long as some member holds on to it. Settings
+    // with more than MAX_MEMBERS instances have more than one bus.
+    std::map<ReverbBus::Settings, std::vector<std::weak_ptr<ReverbBus>>>& getRegistry()
+    {
+        static std::map<ReverbBus::Settings, std::vector<std::weak_ptr<ReverbBus>>> registry;
+        return registry;
+    }
+
+    juce::CriticalSection& getRegistryLock()
+    {
+        static juce::CriticalSection lock;
+        return lock;
+    }
+
+    // A stream of the batch is a mono channel or a stereo pair
+    int getStreamChannels (int num_channels) { return num_channels == 1 ? 1 : 2; }
+    int getStreamsPerMember (int num_channels) { return num_channels == 1 ? 1 : num_channels / 2; }
+}
+
+bool ReverbBus::Settings::operator< (const Settings& other) const
+{
+    return std::tie (sample_rate, max_block_size, num_channels) < std::tie (other.sample_rate, other.max_block_size, other.num_channels);
+}
+
+void ReverbBus::Member::advance (juce::AudioPlayHead* play_head, int num_samples)
+{
+    juce::AudioPlayHead::CurrentPositionInfo info;
+
+    if (play_head != nullptr && play_head->getCurrentPosition (info) && info.isPlaying)
+    {
+        // Every start of the transport brings the member back onto the bus
+        if (! playing)
+            synced = true;
+
+        jumped = info.timeInSamples != next_position;
+        position = info.timeInSamples;
+        playing = true;
+    }
+    else
+    {
+        position = next_position;
+        jumped = false;
+        playing = false;
+    }
+    next_position = position + num_samples;
+}
+
+std::shared_ptr<ReverbBus> ReverbBus::join (const Settings& settings, Member& member)
+{
+    jassert (settings.max_block_size > 0 && canShare (settings.num_channels));
+
+    const juce::ScopedLock lock (getRegistryLock());
+    auto& registry = getRegistry();
+
+    std::shared_ptr<ReverbBus> bus;
+    int slot = -1;
+
+    for (auto& weak_bus : registry[settings])
+    {
+        bus = weak_bus.lock();
+        if (bus == nullptr)
+            continue;
+
+        const auto free_slot = std::find (bus->members_.begin(), bus->members_.end(), nullptr);
+        if (free_slot != bus->members_.end())
+        {
+            slot = static_cast<int> (std::distance (bus->members_.begin(), free_slot));
+            break;
+        }
+    }
+
+    if (slot < 0)
+    {
+        bus.reset (new ReverbBus (settings));
+        registry[settings].push_back (bus);
+        slot = 0;
+    }
+
+    bus->members_[static_cast<size_t> (slot)] = &member;
+    member = {};
+    member.slot = slot;
+
+    {
+        const juce::SpinLock::ScopedLockType ring_lock (bus->ring_lock_);
+
+        // The slot may still ring with the tail of the member that had it before. The batch
+        // clears its streams the next time it runs and the inputs it is not running on are
+        // cleared here, the new member reads silence until then.
+        const int first_channel = slot * settings.num_channels;
+        const auto num_free = static_cast<int> (bus->processed_to_ + bus->ring_size_ - bus->claimed_to_);
+        bus->forEachRun (bus->claimed_to_, num_free, [&] (int ring_offset, int /*buffer_offset*/, int run_samples) {
+            for (int channel = 0; channel < settings.num_channels; ++channel)
+                juce::FloatVectorOperations::clear (bus->inputs_[first_channel + channel] + ring_offset, run_samples);
+        });
+
+        bus->added_to_[static_cast<size_t> (slot)] = JOINED;
+        bus->clean_from_[static_cast<size_t> (slot)] = bus->claimed_to_;
+        bus->cleared_[static_cast<size_t> (slot)] = true;
+        bus->num_slots_ = bus->countSlots();
+    }
+
+    // Drop the entries of buses nobody uses anymore
+    for (auto it = registry.begin(); it != registry.end();)
+    {
+        auto& buses = it->second;
+        buses.erase (std::remove_if (buses.begin(), buses.end(), [] (const auto& weak_bus) { return weak_bus.expired(); }), buses.end());
+        it = buses.empty() ? registry.erase (it) : std::next (it);
+    }
+
+    return bus;
+}
+
+void ReverbBus::leave (Member& member)
+{
+    const juce::ScopedLock lock (getRegistryLock());
+
+    jassert (member.slot >= 0 && members_[static_cast<size_t> (member.slot)] == &member);
+    members_[static_cast<size_t> (member.slot)] = nullptr;
+
+    {
+        const juce::SpinLock::ScopedLockType ring_lock (ring_lock_);
+        added_to_[static_cast<size_t> (member.slot)] = NOT_ADDED;
+        num_slots_ = countSlots();
+    }
+    member.slot = -1;
+}
+
+ReverbBus::ReverbBus (const Settings& settings)
+    : settings_ (settings),
+      streams_per_member_ (getStreamsPerMember (settings.num_channels))
+{
+    const int ring_size = settings.max_block_size * 2;
+    const int num_streams = MAX_MEMBERS * streams_per_member_;
+    const int num_ring_channels = MAX_MEMBERS * settings.num_channels;
+
+    arena_.prepare (FreeverbBatch::getRequiredBytes (settings.sample_rate, num_streams, getStreamChannels (settings.num_channels), settings.max_block_size));
+    engine_.prepare (settings.sample_rate, num_streams, getStreamChannels (settings.num_channels), settings.max_block_size, arena_);
+
+    input_.setSize (num_ring_channels, ring_size);
+    input_.clear();
+    output_.setSize (num_ring_channels, ring_size);
+    output_.clear();
+    inputs_ = input_.getArrayOfWritePointers();
+    outputs_ = output_.getArrayOfWritePointers();
+    ring_size_ = ring_size;
+    run_channels_.resize (static_cast<size_t> (num_ring_channels));
+
+    for (auto& reverb : reverbs_)
+        reverb = 0.0f;
+    applied_reverbs_.fill (-1.0f);
+    added_to_.fill (NOT_ADDED);
+}
+
+ReverbBus::~ReverbBus()
+{
+    jassert (std::all_of (members_.begin(), members_.end(), [] (const Member* member) { return member == nullptr; }));
+}
+
+template <typename Function>
+void ReverbBus::forEachRun (juce::int64 position, int num_samples, Function&& function) const
+{
+    const auto ring_size = static_cast<juce::int64> (ring_size_);
+    // Positions before the start of the timeline are negative
+    const int start = static_cast<int> (((position % ring_size) + ring_size) % ring_size);
+    const int first_run = juce::jmin (num_samples, ring_size_ - start);
+
+    function (start, 0, first_run);
+    if (first_run < num_samples)
+        function (0, first_run, num_samples - first_run);
+}
+
+int ReverbBus::countSlots() const
+{
+    int num_slots = 0;
+    for (int slot = 0; slot < MAX_MEMBERS; ++slot)
+        if (members_[static_cast<size_t> (slot)] != nullptr)
+            num_slots = slot + 1;
+    return num_slots;
+}
+
+void ReverbBus::setReverb (Member& member, float reverb)
+{
+    if (reverb != member.reverb)
+    {
+        reverbs_[static_cast<size_t> (member.slot)] = reverb;
+        member.reverb = reverb;
+    }
+}
+
+bool ReverbBus::addInput (const juce::AudioBuffer<float>& buffer, int num_channels, Member& member)
+{
+    jassert (member.slot >= 0 && buffer.getNumSamples() <= settings_.max_block_size);
+
+    const int num_samples = buffer.getNumSamples();
+    const int first_channel = member.slot * settings_.num_channels;
+    const auto slot = static_cast<size_t> (member.slot);
+    const auto end = member.position + num_samples;
+    num_channels = juce::jmin (num_channels, settings_.num_channels);
+
+    // The wet signal of this block is read a block later, the batch has to have got there
+    const auto needed_to = end - settings_.max_block_size;
+    Batch batch;
+
+    {
+        const juce::SpinLock::ScopedLockType lock (ring_lock_);
+
+        // A member that starts adding catches up with the batch, when the others have run it
+        // past the start of the block the input before it is lost
+        const bool entering = added_to_[slot] == NOT_ADDED || added_to_[slot] == JOINED;
+        auto start = member.position;
+        if (entering && ! member.jumped)
+            start = juce::jlimit (start, end, claimed_to_);
+
+        // The ring takes inputs from where the batch has got to up to two blocks later
+        if (start < claimed_to_ || end > processed_to_ + ring_size_)
+        {
+            if (! member.jumped || claimed_to_ != processed_to_)
+            {
+                // Too far behind or ahead of the other members, their wet signal would miss
+                // the block or have to wait for it
+                dropOut (member);
+                return false;
+            }
+
+            // The first member to arrive after a jump takes the bus along, the inputs in the
+            // ring belong to another part of the timeline. The members in step owe their
+            // inputs from here on.
+            for (int channel = 0; channel < input_.getNumChannels(); ++channel)
+                juce::FloatVectorOperations::clear (inputs_[channel], ring_size_);
+            for (size_t other = 0; other < MAX_MEMBERS; ++other)
+            {
+                if (added_to_[other] >= claimed_to_ || added_to_[other] == JOINED)
+                    added_to_[other] = member.position;
+                else
+                    added_to_[other] = NOT_ADDED;
+                clean_from_[other] = juce::jmin (clean_from_[other], member.position - settings_.max_block_size);
+            }
+            processed_to_ = member.position - settings_.max_block_size;
+            claimed_to_ = processed_to_;
+        }
+
+        const auto offset = static_cast<int> (start - member.position);
+        forEachRun (start, num_samples - offset, [&] (int ring_offset, int buffer_offset, int run_samples) {
+            for (int channel = 0; channel < num_channels; ++channel)
+                juce::FloatVectorOperations::copy (inputs_[first_channel + channel] + ring_offset, buffer.getReadPointer (channel, offset + buffer_offset), run_samples);
+        });
+        added_to_[slot] = end;
+
+        // Members that joined and have not added anything yet are about to, the batch waits
+        // for their first block like for the block of any member in step
+        for (auto& other : added_to_)
+            if (other == JOINED)
+                other = member.position;
+
+        if (! claimBatch (getInputEnd (needed_to), batch))
+            return true;
+    }
+
+    // Members may have added more while the batch ran
+    for (;;)
+    {
+        runBatch (batch);
+
+        const juce::SpinLock::ScopedLockType lock (ring_lock_);
+        processed_to_ = batch.end;
+        if (! claimBatch (getInputEnd (needed_to), batch))
+            return true;
+    }
+}
+
+bool ReverbBus::readOutput (juce::AudioBuffer<float>& buffer, int num_channels, Member& member)
+{
+    jassert (member.slot >= 0 && buffer.getNumSamples() <= settings_.max_block_size);
+
+    // The wet signal trails the input by a block, the other members have added theirs by then
+    const auto start = member.position - settings_.max_block_size;
+    const auto end = start + buffer.getNumSamples();
+    const int first_channel = member.slot * settings_.num_channels;
+    num_channels = juce::jmin (num_channels, settings_.num_channels);
+
+    for (;;)
+    {
+        Batch batch;
+        bool claimed = false;
+
+        {
+            const juce::SpinLock::ScopedLockType lock (ring_lock_);
+
+            // A running batch writes the wet signal from a ring length before claimed_to_ on
+            const bool overwritten = start < claimed_to_ - ring_size_;
+            if (end <= processed_to_ && ! overwritten)
+            {
+                const auto clean_from = clean_from_[static_cast<size_t> (member.slot)];
+                forEachRun (start, buffer.getNumSamples(), [&] (int ring_offset, int buffer_offset, int run_samples) {
+                    for (int channel = 0; channel < num_channels; ++channel)
+                        juce::FloatVectorOperations::copy (buffer.getWritePointer (channel, buffer_offset), outputs_[first_channel + channel] + ring_offset, run_samples);
+                });
+
+                // Before the member joined, the slot rang with the member before it
+                const auto num_silent = static_cast<int> (juce::jlimit<juce::int64> (0, buffer.getNumSamples(), clean_from - start));
+                for (int channel = 0; channel < num_channels; ++channel)
+                    buffer.clear (channel, 0, num_silent);
+                return true;
+            }
+
+            // Far behind the batch
+            if (overwritten)
+            {
+                dropOut (member);
+                return false;
+            }
+
+            // Nobody has run the batch this far, some member in step has stopped adding its
+            // input and the batch goes on without it. That member is not waited for from the
+            // next block on, so a member only ever waits for the batch of another one here,
+            // in the block after some member stopped.
+            claimed = claimBatch (end, batch);
+        }
+
+        if (claimed)
+        {
+            runBatch (batch);
+
+            const juce::SpinLock::ScopedLockType lock (ring_lock_);
+            processed_to_ = batch.end;
+        }
+        else
+        {
+            juce::Thread::yield();
+        }
+    }
+}
+
+void ReverbBus::dropOut (Member& member)
+{
+    member.synced = false;
+    added_to_[static_cast<size_t> (member.slot)] = NOT_ADDED;
+}
+
+juce::int64 ReverbBus::getInputEnd (juce::int64 needed_to) const
+{
+    auto end = std::numeric_limits<juce::int64>::max();
+    for (size_t slot = 0; slot < static_cast<size_t> (num_slots_); ++slot)
+        if (added_to_[slot] >= needed_to)
+            end = juce::jmin (end, added_to_[slot]);
+    return end;
+}
+
+bool ReverbBus::claimBatch (juce::int64 end, Batch& batch)
+{
+    if (claimed_to_ != processed_to_ || end <= processed_to_)
+        return false;
+
+    batch.start = processed_to_;
+    batch.end = juce::jmin (end, processed_to_ + settings_.max_block_size);
+    batch.num_slots = num_slots_;
+    batch.cleared = cleared_;
+    cleared_.fill (false);
+
+    claimed_to_ = batch.end;
+    return true;
+}
+
+void ReverbBus::runBatch (const Batch& batch)
+{
+    for (int slot = 0; slot < batch.num_slots; ++slot)
+    {
+        // A new member starts from silence and its own reverb
+        if (batch.cleared[static_cast<size_t> (slot)])
+        {
+            for (int stream = 0; stream < streams_per_member_; ++stream)
+                engine_.clearStream (slot * streams_per_member_ + stream);
+            applied_reverbs_[static_cast<size_t> (slot)] = -1.0f;
+        }
+
+        const float reverb = reverbs_[static_cast<size_t> (slot)].load();
+        if (reverb != applied_reverbs_[static_cast<size_t> (slot)])
+        {
+            const auto parameters = EasyverbCore::getReverbParameters (reverb);
+            for (int stream = 0; stream < streams_per_member_; ++stream)
+                engine_.setStreamParameters (slot * streams_per_member_ + stream, parameters);
+            applied_reverbs_[static_cast<size_t> (slot)] = reverb;
+        }
+    }
+    engine_.setNumActiveStreams (batch.num_slots * streams_per_member_);
+
+    const int num_channels = batch.num_slots * settings_.num_channels;
+    forEachRun (batch.start, static_cast<int> (batch.end - batch.start), [&] (int ring_offset, int /*buffer_offset*/, int run_samples) {
+        // The batch processes in place, so the inputs move over to the wet ring first and
+        // make room for the block two blocks on
+        for (int channel = 0; channel < num_channels; ++channel)
+        {
+            juce::FloatVectorOperations::copy (outputs_[channel] + ring_offset, inputs_[channel] + ring_offset, run_samples);
+            juce::FloatVectorOperations::clear (inputs_[channel] + ring_offset, run_samples);
+            run_channels_[static_cast<size_t> (channel)] = outputs_[channel] + ring_offset;
+        }
+
+        engine_.process (run_channels_.data(), run_samples);
+    });
+}
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    ReverbBus.h
+    Created: 19 Oct 2026 2:17:45pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FreeverbBatch.h"
+#include <Arena.h>
+#include <JuceHeader.h>
+
+// One reverb engine shared by up to MAX_MEMBERS Easyverb instances in the process that have
+// the same configuration.
+//
+// The engine is a FreeverbBatch with a stream for every channel pair of every member. Each
+// member adds its filtered input, already scaled by its wet volume, to its own channels and
+// reads back its own wet signal, so faders, pans, mutes and sends of the tracks keep working.
+// The batch runs the streams of all members in one pass with one stream per SIMD lane, which
+// is where the CPU goes down. It only runs the streams of the slots up to the highest one in
+// use, and always at the host rate with 32 bit lines, eco mode and delay precision only apply
+// to instances processing on their own.
+//
+// Every member has its own "Reverb": its streams have their own parameters in the batch and
+// glide to a new value like the engine of an instance on its own.
+//
+// Members process in any order and on any thread. The inputs sit in a ring by timeline
+// position. The member that completes a range, adding the last input the members in step
+// owe for it, runs the batch on it, and the others read their wet signal max_block_size
+// samples after they added the input. Members report that delay as latency and the host
+// lines the tracks up again. The ring lock only guards positions and copies of a block, the
+// batch runs without it. A member only waits for the batch of another one in the block after
+// some member stopped adding its input, when the batch has to go on without it.
+//
+// A member that falls more than a block behind the others, for example on a host that
+// renders some tracks ahead, is out of step. Its own engine takes over from that block on,
+// see Member, and the others go on without waiting for its input.
+class ReverbBus
+{
+public:
+    static constexpr int MAX_MEMBERS = 8;
+
+    // Everything that has to match to share an engine
+    struct Settings
+    {
+        double sample_rate = 44100.0;
+        int max_block_size = 0;
+        int num_channels = 0;
+
+        bool operator== (const Settings& other) const { return ! (*this < other) && ! (other < *this); }
+        bool operator< (const Settings& other) const;
+    };
+
+    // The batch takes mono streams or stereo pairs
+    static bool canShare (int num_channels) { return num_channels == 1 || (num_channels > 0 && num_channels % 2 == 0); }
+
+    // One member of a bus and its position on the timeline. Synced from the host when the
+    // transport starts and while it plays, counted on from there while it is stopped, so
+    // members that have played together stay in step. A member that has not seen the
+    // transport start since it joined or fell out of step processes on its own.
+    struct Member
+    {
+        // Audio thread, before every block
+        void advance (juce::AudioPlayHead* play_head, int num_samples);
+
+        // Start of the block being processed
+        juce::int64 position = 0;
+        juce::int64 next_position = 0;
+        bool playing = false;
+        // The host moved the member somewhere else than where its last block ended
+        bool jumped = false;
+        bool synced = false;
+
+        // Slot on the bus, set by join()
+        int slot = -1;
+        // Reverb last sent to the bus, below zero until the first block
+        float reverb = -1.0f;
+    };
+
+    // Message thread: joins a bus with these settings and a free slot, creating one when
+    // there is none. Locks and may allocate.
+    static std::shared_ptr<ReverbBus> join (const Settings& settings, Member& member);
+    // Message thread, with the member not processing. The bus lives on as long as some
+    // member holds on to it.
+    void leave (Member& member);
+
+    ~ReverbBus();
+
+    const Settings& getSettings() const { return settings_; }
+    // Delay of the wet signal of a member
+    float getLatencySamples() const { return static_cast<float> (settings_.max_block_size); }
+
+    // Audio thread: the reverb of the member, applied the next time the batch runs
+    void setReverb (Member& member, float reverb);
+    // Audio thread: adds the input of a member at its position on the timeline, and runs the
+    // batch when that completes a range. False when the member is out of step with the bus,
+    // it is then no longer synced.
+    bool addInput (const juce::AudioBuffer<float>& buffer, int num_channels, Member& member);
+    // Audio thread, after addInput(): replaces buffer with the wet signal of the member. False
+    // and buffer left alone when the member is out of step with the bus, see addInput().
+    bool readOutput (juce::AudioBuffer<float>& buffer, int num_channels, Member& member);
+
+private:
+    explicit ReverbBus (const Settings& settings);
+
+    // A range of the timeline the batch runs on, claimed with the ring lock held
+    struct Batch
+    {
+        juce::int64 start = 0;
+        juce::int64 end = 0;
+        int num_slots = 0;
+        // Slots that changed members since the last batch
+        std::array<bool, MAX_MEMBERS> cleared {};
+    };
+
+    // added_to_ of a slot without a member in step
+    static constexpr juce::int64 NOT_ADDED = std::numeric_limits<juce::int64>::min();
+    // added_to_ of a slot whose member joined and has not added anything yet
+    static constexpr juce::int64 JOINED = NOT_ADDED + 1;
+
+    // Calls function (ring_offset, buffer_offset, num_samples) for the one or two runs of the
+    // ring that num_samples samples from position fill
+    template <typename Function>
+    void forEachRun (juce::int64 position, int num_samples, Function&& function) const;
+    // The slots up to the highest one with a member, with the registry lock held
+    int countSlots() const;
+
+    // With the ring lock held: where the inputs of the members in step end. Members whose
+    // inputs end before needed_to have fallen a block behind and are not waited for.
+    juce::int64 getInputEnd (juce::int64 needed_to) const;
+    // With the ring lock held: claims the batch for the range from processed_to_ towards end,
+    // at most a block. False when there is nothing to do or another member is running it.
+    bool claimBatch (juce::int64 end, Batch& batch);
+    // Without the ring lock: runs a claimed batch and hands the range to the readers
+    void runBatch (const Batch& batch);
+    // With the ring lock held
+    void dropOut (Member& member);
+
+    Settings settings_;
+    int streams_per_member_ = 0;
+    Arena arena_;
+    FreeverbBatch engine_;
+    // Reverb of every slot, and the one the batch last applied to its streams
+    std::array<std::atomic<float>, MAX_MEMBERS> reverbs_;
+    std::array<float, MAX_MEMBERS> applied_reverbs_;
+
+    // Inputs and wet signals of all slots, channel c of slot s at s * num_channels + c. Both
+    // are two blocks long, inputs are cleared once the batch has taken them. Only touched
+    // through the channel pointers after construction, the buffers keep flags that several
+    // threads would write.
+    juce::AudioBuffer<float> input_;
+    juce::AudioBuffer<float> output_;
+    float* const* inputs_ = nullptr;
+    float* const* outputs_ = nullptr;
+    int ring_size_ = 0;
+    std::vector<float*> run_channels_;
+
+    // Guards everything below. The batch owns the range from processed_to_ to claimed_to_ of
+    // both rings and the engine while it runs.
+    juce::SpinLock ring_lock_;
+    // Everything before this position has been through the batch
+    juce::int64 processed_to_ = 0;
+    // The end of the range the batch is running on, processed_to_ while it is not running
+    juce::int64 claimed_to_ = 0;
+    // End of the last input of every slot
+    std::array<juce::int64, MAX_MEMBERS> added_to_;
+    // Wet signal of the member of each slot starts here, before it belongs to the one before
+    std::array<juce::int64, MAX_MEMBERS> clean_from_ {};
+    std::array<bool, MAX_MEMBERS> cleared_ {};
+    int num_slots_ = 0;
+
+    // Guarded by the registry lock
+    std::array<const Member*, MAX_MEMBERS> members_ {};
+
+    JUCE_DECLARE_NON_COPYABLE (ReverbBus)
+};
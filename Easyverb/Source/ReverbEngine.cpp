@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    ReverbEngine.cpp
+    Created: 19 Oct 2026 10:41:12am
+
+  ==============================================================================
+*/
+
+#include "ReverbEngine.h"
+
+// The reverb tail has hardly any energy close to the Nyquist frequency, so a moderately
+// steep half-band filter is enough to keep images and aliasing far below the tail.
+constexpr int HALF_BAND_COEFFICIENTS = 8;
+constexpr double HALF_BAND_TRANSITION = 0.05;
+
+size_t ReverbEngine::getRequiredBytes (double sample_rate, int max_block_size, int num_channels, int rate_divider, Freeverb::Precision precision)
+{
+    const auto channels = static_cast<size_t> (num_channels);
+    const int num_stages = getNumStages (rate_divider);
+    size_t bytes = 0;
+
+    if (num_stages > 0)
+    {
+        bytes += Arena::getRequiredBytes<float> (channels * static_cast<size_t> (getStagingSize (max_block_size, rate_divider)));
+        for (int stage = 0; stage < num_stages; ++stage)
+            bytes += Arena::getRequiredBytes<float> (channels * static_cast<size_t> (getLowRateSize (max_block_size, rate_divider, stage)));
+        bytes += Arena::getRequiredBytes<float> (channels * static_cast<size_t> (getQueueSize (max_block_size, rate_divider)));
+    }
+
+    return bytes + static_cast<size_t> ((num_channels + 1) / 2) * Freeverb::getRequiredBytes (sample_rate / rate_divider, precision);
+}
+
+float ReverbEngine::computeLatencySamples (int rate_divider)
+{
+    const int num_stages = getNumStages (rate_divider);
+    if (num_stages == 0)
+        return 0.0f;
+
+    HalfBandIir filter;
+    filter.setCoefficients (HalfBandIir::designCoefficients (HALF_BAND_COEFFICIENTS, HALF_BAND_TRANSITION));
+
+    // Each stage runs at half the rate of the previous one, so its delay counts double
+    double latency = 0.0;
+    for (int stage = 0; stage < num_stages; ++stage)
+        latency += (filter.getDownsamplingDelay() + filter.getUpsamplingDelay()) * (1 << stage);
+
+    latency += rate_divider - 1;
+    return static_cast<float> (latency);
+}
+
+void ReverbEngine::referToArena (juce::AudioBuffer<float>& buffer, int num_channels, int num_samples, Arena& arena)
+{
+    auto* data = arena.allocate<float> (static_cast<size_t> (num_channels * num_samples));
+
+    std::vector<float*> channels;
+    for (int channel = 0; channel < num_channels; ++channel)
+        channels.push_back (data + channel * num_samples);
+
+    buffer.setDataToReferTo (channels.data(), num_channels, num_samples);
+}
+
+void ReverbEngine::prepare (double sample_rate, int max_block_size, int num_channels, int rate_divider, Freeverb::Precision precision, Arena& arena)
+{
+    jassert (rate_divider == 1 || rate_divider == 2 || rate_divider == 4);
+
+    rate_divider_ = rate_divider;
+    precision_ = precision;
+    num_stages_ = getNumStages (rate_divider);
+
+    const auto coefficients = HalfBandIir::designCoefficients (HALF_BAND_COEFFICIENTS, HALF_BAND_TRANSITION);
+
+    // Scratch buffers first, in the order a block passes through them
+    if (num_stages_ > 0)
+        referToArena (staging_, num_channels, getStagingSize (max_block_size, rate_divider_), arena);
+
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        decimators_[stage].setCoefficients (coefficients);
+        decimators_[stage].prepare (num_channels);
+        interpolators_[stage].setCoefficients (coefficients);
+        interpolators_[stage].prepare (num_channels);
+
+        referToArena (low_rate_[stage], num_channels, getLowRateSize (max_block_size, rate_divider_, stage), arena);
+    }
+
+    if (num_stages_ > 0)
+    {
+        referToArena (queue_, num_channels, getQueueSize (max_block_size, rate_divider_), arena);
+        queue_pointers_.resize (static_cast<size_t> (num_channels));
+    }
+
+    reverbs_.resize (static_cast<size_t> ((num_channels + 1) / 2));
+    for (auto& reverb : reverbs_)
+    {
+        reverb.prepare (sample_rate / rate_divider_, precision_, arena);
+    }
+
+    latency_ = computeLatencySamples (rate_divider_);
+    reset();
+}
+
+void ReverbEngine::reset()
+{
+    for (auto& reverb : reverbs_)
+    {
+        reverb.reset();
+    }
+
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        decimators_[stage].reset();
+        interpolators_[stage].reset();
+    }
+
+    // Start with rate_divider - 1 samples of silence queued, that is exactly enough to
+    // always have a full host block of output while input is being staged. At the host rate
+    // the scratch buffers still point at memory the arena has handed to the reverbs.
+    if (num_stages_ > 0)
+    {
+        staging_.clear();
+        queue_.clear();
+    }
+    num_staged_ = 0;
+    num_queued_ = rate_divider_ - 1;
+}
+
+size_t ReverbEngine::getFilterMemoryBytes() const
+{
+    size_t bytes = 0;
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        bytes += decimators_[stage].getMemoryBytes() + interpolators_[stage].getMemoryBytes();
+    }
+    return bytes;
+}
+
+void ReverbEngine::setParameters (const juce::Reverb::Parameters& parameters)
+{
+    for (auto& reverb : reverbs_)
+    {
+        reverb.setParameters (parameters);
+    }
+}
+
+void ReverbEngine::setNumCombs (int num_combs)
+{
+    for (auto& reverb : reverbs_)
+    {
+        reverb.setNumCombs (num_combs);
+    }
+}
+
+void ReverbEngine::process (float* const* channels, int num_channels, int num_samples)
+{
+    if (num_stages_ == 0)
+    {
+        processReverbs (channels, num_channels, num_samples);
+    }
+    else
+    {
+        processMultiRate (channels, num_channels, num_samples);
+    }
+}
+
+void ReverbEngine::processReverbs (float* const* channels, int num_channels, int num_samples)
+{
+    for (size_t pair = 0; pair < reverbs_.size(); ++pair)
+    {
+        const int first_channel = static_cast<int> (pair) * 2;
+
+        if (first_channel + 1 < num_channels)
+        {
+            reverbs_[pair].processStereo (channels[first_channel], channels[first_channel + 1], num_samples);
+        }
+        else if (first_channel < num_channels)
+        {
+            reverbs_[pair].processMono (channels[first_channel], num_samples);
+        }
+    }
+}
+
+void ReverbEngine::processMultiRate (float* const* channels, int num_channels, int num_samples)
+{
+    const int num_available = num_staged_ + num_samples;
+    const int num_low_rate = num_available / rate_divider_;
+    const int num_consumed = num_low_rate * rate_divider_;
+
+    for (int channel = 0; channel < num_channels; ++channel)
+        juce::FloatVectorOperations::copy (staging_.getWritePointer (channel) + num_staged_, channels[channel], num_samples);
+
+    // Decimate down through the stages, every stage halves the number of samples
+    const float* const* stage_input = staging_.getArrayOfReadPointers();
+    int stage_samples = num_consumed;
+    for (int stage = 0; stage < num_stages_; ++stage)
+    {
+        stage_samples /= 2;
+        decimators_[stage].downsample (stage_input, low_rate_[stage].getArrayOfWritePointers(), num_channels, stage_samples);
+        stage_input = low_rate_[stage].getArrayOfReadPointers();
+    }
+
+    // Keep the samples that did not make up a whole group for the next block
+    for (int channel = 0; channel < num_channels; ++channel)
+    {
+        auto* staged = staging_.getWritePointer (channel);
+        std::memmove (staged, staged + num_consumed, static_cast<size_t> (num_available - num_consumed) * sizeof (float));
+    }
+    num_staged_ = num_available - num_consumed;
+
+    processReverbs (low_rate_[num_stages_ - 1].getArrayOfWritePointers(), num_channels, num_low_rate);
+
+    // Interpolate back up, the last stage writes straight into the output queue
+    for (int channel = 0; channel < num_channels; ++channel)
+        queue_pointers_[static_cast<size_t> (channel)] = queue_.getWritePointer (channel) + num_queued_;
+
+    stage_samples = num_low_rate;
+    for (int stage = num_stages_ - 1; stage >= 0; --stage)
+    {
+        auto* const* stage_output = stage == 0 ? queue_pointers_.data() : low_rate_[stage - 1].getArrayOfWritePointers();
+        interpolators_[stage].upsample (low_rate_[stage].getArrayOfReadPointers(), stage_output, num_channels, stage_samples);
+        stage_samples *= 2;
+    }
+
+    for (int channel = 0; channel < num_channels; ++channel)
+    {
+        auto* queued = queue_.getWritePointer (channel);
+        juce::FloatVectorOperations::copy (channels[channel], queued, num_samples);
+        std::memmove (queued, queued + num_samples, static_cast<size_t> (num_queued_ + num_consumed - num_samples) * sizeof (float));
+    }
+    num_queued_ += num_consumed - num_samples;
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    ReverbEngine.h
+    Created: 19 Oct 2026 10:41:12am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Freeverb.h"
+#include <Arena.h>
+#include <HalfBandFilter.h>
+#include <JuceHeader.h>
+
+// The wet path of Easyverb: one stereo reverb per channel pair, optionally running at a
+// half or a quarter of the host sample rate.
+//
+// In the multi-rate ("eco") mode the input is decimated with polyphase half-band filters,
+// the reverb runs at the lower rate and the result is interpolated back. Reverb CPU and
+// delay line memory drop with the rate divider. Host blocks of any size are handled by
+// staging input until whole groups of samples are available, which adds rate_divider - 1
+// samples to the latency of the half-band filters.
+//
+// The delay lines of the reverbs and all scratch buffers are carved out of one arena that the
+// caller prepares with getRequiredBytes().
+class ReverbEngine
+{
+public:
+    static size_t getRequiredBytes (double sample_rate, int max_block_size, int num_channels, int rate_divider, Freeverb::Precision precision);
+    // The latency an engine with this rate divider will have, before it is prepared
+    static float computeLatencySamples (int rate_divider);
+
+    // rate_divider is 1, 2 or 4, precision is the storage format of the reverb delay lines
+    void prepare (double sample_rate, int max_block_size, int num_channels, int rate_divider, Freeverb::Precision precision, Arena& arena);
+    void reset();
+
+    void setParameters (const juce::Reverb::Parameters& parameters);
+    // Comb filters every reverb runs, see Freeverb::setNumCombs()
+    void setNumCombs (int num_combs);
+    void process (float* const* channels, int num_channels, int num_samples);
+
+    int getRateDivider() const { return rate_divider_; }
+    Freeverb::Precision getPrecision() const { return precision_; }
+    // Delay of the wet signal in host samples, zero when running at the host rate
+    float getLatencySamples() const { return latency_; }
+    // Bytes held by the half-band filters, everything else lives in the arena
+    size_t getFilterMemoryBytes() const;
+
+private:
+    void processReverbs (float* const* channels, int num_channels, int num_samples);
+    void processMultiRate (float* const* channels, int num_channels, int num_samples);
+
+    static constexpr int MAX_STAGES = 2;
+
+    static int getNumStages (int rate_divider) { return rate_divider == 4 ? 2 : (rate_divider == 2 ? 1 : 0); }
+    static int getStagingSize (int max_block_size, int rate_divider) { return max_block_size + rate_divider; }
+    static int getQueueSize (int max_block_size, int rate_divider) { return max_block_size + rate_divider * 2; }
+    static int getLowRateSize (int max_block_size, int rate_divider, int stage) { return ((max_block_size + rate_divider) >> (stage + 1)) + 1; }
+    static void referToArena (juce::AudioBuffer<float>& buffer, int num_channels, int num_samples, Arena& arena);
+
+    std::vector<Freeverb> reverbs_;
+    int rate_divider_ = 1;
+    Freeverb::Precision precision_ = Freeverb::Precision::float32;
+    int num_stages_ = 0;
+    float latency_ = 0.0f;
+
+    std::array<HalfBandIir, MAX_STAGES> decimators_;
+    std::array<HalfBandIir, MAX_STAGES> interpolators_;
+
+    // Input waiting for a whole group of rate_divider_ samples
+    juce::AudioBuffer<float> staging_;
+    int num_staged_ = 0;
+    // Output of the interpolators that has not been handed to the host yet
+    juce::AudioBuffer<float> queue_;
+    int num_queued_ = 0;
+    std::vector<float*> queue_pointers_;
+    // Signal at half and quarter rate
+    std::array<juce::AudioBuffer<float>, MAX_STAGES> low_rate_;
+};
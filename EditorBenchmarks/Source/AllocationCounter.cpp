@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.cpp
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<juce::int64> num_allocations { 0 };
+
+    void* allocate (std::size_t size)
+    {
+        num_allocations.fetch_add (1, std::memory_order_relaxed);
+        return std::malloc (size > 0 ? size : 1);
+    }
+}
+
+juce::int64 getNumAllocations()
+{
+    return num_allocations.load (std::memory_order_relaxed);
+}
+
+// Aligned allocations keep the default operators, juce::HeapBlock and the containers the
+// editors use all come through these
+void* operator new (std::size_t size)
+{
+    if (auto* pointer = allocate (size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    if (auto* pointer = allocate (size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate (size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate (size);
+}
+
+void operator delete (void* pointer) noexcept
+{
+    std::free (pointer);
+}
+
+void operator delete[] (void* pointer) noexcept
+{
+    std::free (pointer);
+}
+
+void operator delete (void* pointer, std::size_t) noexcept
+{
+    std::free (pointer);
+}
+
+void operator delete[] (void* pointer, std::size_t) noexcept
+{
+    std::free (pointer);
+}
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.h
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Calls to the global operator new of this program so far, from any thread. The counting
+// replaces operator new and delete for the whole program, see AllocationCounter.cpp.
+juce::int64 getNumAllocations();
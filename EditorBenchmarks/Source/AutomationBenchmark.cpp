@@ -0,0 +1,273 @@
+/*
+  ==============================================================================
+
+    AutomationBenchmark.cpp
+    Created: 19 Oct 2026 11:03:18pm
+
+  ==============================================================================
+*/
+
+#include "AutomationBenchmark.h"
+#include <ClapPlugin.h>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int NUM_CHANNELS = 2;
+    constexpr int NUM_FRAMES = 512;
+
+    // The plugins in both formats, the VST3 ones from PLUGINS
+    struct Format
+    {
+        const Plugin& plugin;
+        DspCoreType type;
+    };
+
+    const Format FORMATS[] = {
+        { PLUGINS[0], DSPCORE_EASYVERB },
+        { PLUGINS[1], DSPCORE_GRAMOPHONY },
+        { PLUGINS[2], DSPCORE_WAVEFOLDER },
+    };
+
+    // Noise copied back before every block, processed in place
+    struct Signal
+    {
+        Signal()
+            : input (NUM_CHANNELS, NUM_FRAMES),
+              buffer (NUM_CHANNELS, NUM_FRAMES)
+        {
+            juce::Random random (0x5eed);
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+            {
+                auto* samples = input.getWritePointer (channel);
+                for (int sample = 0; sample < NUM_FRAMES; ++sample)
+                    samples[sample] = random.nextFloat() * 2.0f - 1.0f;
+            }
+        }
+
+        void refill()
+        {
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+                buffer.copyFrom (channel, 0, input, channel, 0, NUM_FRAMES);
+        }
+
+        juce::AudioBuffer<float> input;
+        juce::AudioBuffer<float> buffer;
+    };
+
+    // The first continuous parameter of a core and its ramps, up and down, as (sample, value)
+    struct Automation
+    {
+        Automation (DspCoreType type, int num_events)
+        {
+            auto* core = dspcore_create (type);
+
+            index = 0;
+            while (index < dspcore_get_num_parameters (core) && dspcore_get_parameter_flags (core, index) != 0)
+                ++index;
+
+            DspCoreParameterInfo info;
+            dspcore_get_parameter_info (core, index, &info);
+            id = info.id;
+
+            for (int event = 0; event < num_events; ++event)
+            {
+                const float position = static_cast<float> (event + 1) / static_cast<float> (num_events);
+                const int sample = event * NUM_FRAMES / num_events;
+                ramps[0].push_back ({ sample, info.min_value + position * (info.max_value - info.min_value) });
+                ramps[1].push_back ({ sample, info.max_value - position * (info.max_value - info.min_value) });
+            }
+
+            dspcore_destroy (core);
+        }
+
+        int index = 0;
+        juce::String id;
+        std::array<std::vector<std::pair<int, float>>, 2> ramps;
+    };
+
+    // A host without extensions, ClapPlugin then processes its channel groups itself
+    const clap_host HOST {
+        CLAP_VERSION_INIT, nullptr, "EditorBenchmarks", "Martinheterjag", "", "1.0.0",
+        [] (const clap_host*, const char*) -> const void* { return nullptr; },
+        [] (const clap_host*) {},
+        [] (const clap_host*) {},
+        [] (const clap_host*) {},
+    };
+
+    const char* const FEATURES[] = { CLAP_PLUGIN_FEATURE_AUDIO_EFFECT, nullptr };
+    const clap_plugin_descriptor DESCRIPTOR { CLAP_VERSION_INIT, "com.martinheterjag.benchmark", "Benchmark", "Martinheterjag", "", "", "", "1.0.0", "", FEATURES };
+
+    struct ClapRun
+    {
+        ClapRun (DspCoreType type, int num_events)
+            : automation (type, num_events),
+              plugin ((new ClapPlugin (&DESCRIPTOR, &HOST, type))->getPlugin())
+        {
+            const bool started = plugin->init (plugin) && plugin->activate (plugin, SAMPLE_RATE, 1, NUM_FRAMES) && plugin->start_processing (plugin);
+            jassert (started);
+            juce::ignoreUnused (started);
+
+            for (int ramp = 0; ramp < 2; ++ramp)
+            {
+                for (const auto& point : automation.ramps[static_cast<size_t> (ramp)])
+                {
+                    clap_event_param_value event {};
+                    event.header = { sizeof (clap_event_param_value), static_cast<uint32_t> (point.first), CLAP_CORE_EVENT_SPACE_ID, CLAP_EVENT_PARAM_VALUE, 0 };
+                    event.param_id = static_cast<clap_id> (automation.index);
+                    event.note_id = -1;
+                    event.port_index = -1;
+                    event.channel = -1;
+                    event.key = -1;
+                    event.value = point.second;
+                    events[static_cast<size_t> (ramp)].push_back (event);
+                }
+            }
+
+            in_events.ctx = this;
+            in_events.size = [] (const clap_input_events* list)
+            {
+                const auto& run = *static_cast<const ClapRun*> (list->ctx);
+                return static_cast<uint32_t> (run.events[run.ramp].size());
+            };
+            in_events.get = [] (const clap_input_events* list, uint32_t index)
+            {
+                const auto& run = *static_cast<const ClapRun*> (list->ctx);
+                return &run.events[run.ramp][index].header;
+            };
+            out_events.ctx = nullptr;
+            out_events.try_push = [] (const clap_output_events*, const clap_event_header*) { return true; };
+
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+                channels.push_back (signal.buffer.getWritePointer (channel));
+
+            audio.data32 = channels.data();
+            audio.data64 = nullptr;
+            audio.channel_count = NUM_CHANNELS;
+            audio.latency = 0;
+            audio.constant_mask = 0;
+
+            process.steady_time = -1;
+            process.frames_count = NUM_FRAMES;
+            process.transport = nullptr;
+            process.audio_inputs = &audio;
+            process.audio_outputs = &audio;
+            process.audio_inputs_count = 1;
+            process.audio_outputs_count = 1;
+            process.in_events = &in_events;
+            process.out_events = &out_events;
+        }
+
+        ~ClapRun()
+        {
+            plugin->stop_processing (plugin);
+            plugin->deactivate (plugin);
+            plugin->destroy (plugin);
+        }
+
+        void run()
+        {
+            signal.refill();
+            plugin->process (plugin, &process);
+            ramp = 1 - ramp;
+        }
+
+        Automation automation;
+        const clap_plugin* plugin;
+        Signal signal;
+        std::vector<float*> channels;
+        std::array<std::vector<clap_event_param_value>, 2> events;
+        size_t ramp = 0;
+        clap_input_events in_events;
+        clap_output_events out_events;
+        clap_audio_buffer audio;
+        clap_process process;
+
+        JUCE_DECLARE_NON_COPYABLE (ClapRun)
+    };
+
+    struct Vst3Run
+    {
+        Vst3Run (const Plugin& plugin, DspCoreType type, int num_events)
+            : automation (type, num_events),
+              processor (plugin.create())
+        {
+            for (auto* candidate : processor->getParameters())
+            {
+                auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (candidate);
+                if (ranged != nullptr && ranged->paramID == automation.id)
+                    parameter = ranged;
+            }
+            jassert (parameter != nullptr);
+
+            processor->setRateAndBufferSizeDetails (SAMPLE_RATE, NUM_FRAMES);
+            processor->prepareToPlay (SAMPLE_RATE, NUM_FRAMES);
+
+            // Settings changed before preparing are applied asynchronously, the DSP is built
+            // right away as nothing has been processed yet
+            dispatchPendingMessages();
+        }
+
+        ~Vst3Run()
+        {
+            processor->releaseResources();
+        }
+
+        void run()
+        {
+            signal.refill();
+
+            // The wrapper sets the last point of the parameter's queue and notifies the
+            // listeners, which is how the plugins' parameter attachments see it
+            const auto& points = automation.ramps[ramp];
+            if (! points.empty())
+            {
+                const float value = parameter->convertTo0to1 (points.back().second);
+                if (value != parameter->getValue())
+                {
+                    parameter->setValue (value);
+                    parameter->sendValueChangedMessageToListeners (value);
+                }
+            }
+
+            processor->processBlock (signal.buffer, midi);
+            ramp = 1 - ramp;
+        }
+
+        Automation automation;
+        std::unique_ptr<juce::AudioProcessor> processor;
+        juce::RangedAudioParameter* parameter = nullptr;
+        Signal signal;
+        juce::MidiBuffer midi;
+        size_t ramp = 0;
+
+        JUCE_DECLARE_NON_COPYABLE (Vst3Run)
+    };
+}
+
+std::vector<ProcessTiming> measureAutomation (const juce::String& filter, double min_seconds)
+{
+    std::vector<ProcessTiming> results;
+
+    for (const auto& format : FORMATS)
+    {
+        for (int num_events : { 0, 8, 64 })
+        {
+            const juce::String name = "automation/" + juce::String (format.plugin.name) + "/" + juce::String (num_events) + " events/";
+
+            if ((name + "clap process").contains (filter))
+            {
+                ClapRun clap (format.type, num_events);
+                results.push_back ({ name + "clap process", measureNsPerSample ([&clap] { clap.run(); }, NUM_FRAMES, min_seconds) });
+            }
+
+            if ((name + "vst3 processBlock").contains (filter))
+            {
+                Vst3Run vst3 (format.plugin, format.type, num_events);
+                results.push_back ({ name + "vst3 processBlock", measureNsPerSample ([&vst3] { vst3.run(); }, NUM_FRAMES, min_seconds) });
+            }
+        }
+    }
+
+    return results;
+}
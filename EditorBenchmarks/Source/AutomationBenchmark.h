@@ -0,0 +1,26 @@
+/*
+  ==============================================================================
+
+    AutomationBenchmark.h
+    Created: 19 Oct 2026 11:03:18pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Plugins.h"
+#include "ProcessTiming.h"
+
+// The same automation through both plugin formats: the CLAP plugin gets it as parameter
+// events in ClapPlugin::process, which applies each at its sample, and the VST3 plugin gets
+// the last value of the block before processBlock, the way JUCE's VST3 wrapper applies the
+// parameter queues of the host. The automation is a ramp of the first continuous parameter
+// of each plugin over 0, 8 or 64 events per block, up in one block and down in the next, so
+// both formats see a new value in every block. Both plugins run stereo in place at their
+// defaults, the wrapper's own bus and buffer handling is not part of the VST3 time.
+//
+// Unlike the automation/ benchmarks of Benchmarks, which only compare two ways of calling
+// the same DspCore, this times the real entry points of both plugins.
+// Runs each benchmark whose name contains filter for at least min_seconds.
+std::vector<ProcessTiming> measureAutomation (const juce::String& filter, double min_seconds);
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    EasyverbPlugin.cpp
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+// The processor and editor of Easyverb as the plugin build compiles them, see Plugins.h
+#define JucePlugin_Name "Easyverb"
+#define createPluginFilter createEasyverbFilter
+
+#include "Plugins.h"
+#include "../../Easyverb/Source/PluginEditor.cpp"
+#include "../../Easyverb/Source/PluginProcessor.cpp"
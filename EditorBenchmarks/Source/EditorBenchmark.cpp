@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    EditorBenchmark.cpp
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+#include "EditorBenchmark.h"
+#include "AllocationCounter.h"
+#include "Plugins.h"
+
+namespace
+{
+    // Frames a slider is dragged before the next one is picked up
+    constexpr int DRAG_FRAMES = 30;
+    constexpr int WARM_UP_FRAMES = 2 * DRAG_FRAMES;
+
+    void collectComponents (juce::Component& component, std::vector<juce::Component*>& components)
+    {
+        components.push_back (&component);
+        for (auto* child : component.getChildren())
+            collectComponents (*child, components);
+    }
+
+    juce::MouseEvent makeMouseEvent (juce::Component& component, juce::Point<float> position, juce::Point<float> mouse_down_position, bool button_down, bool dragged)
+    {
+        const auto now = juce::Time::getCurrentTime();
+        const auto modifiers = button_down ? juce::ModifierKeys (juce::ModifierKeys::leftButtonModifier) : juce::ModifierKeys();
+
+        return juce::MouseEvent (juce::Desktop::getInstance().getMainMouseSource(), position, modifiers,
+                                 juce::MouseInputSource::invalidPressure, juce::MouseInputSource::invalidOrientation,
+                                 juce::MouseInputSource::invalidRotation, juce::MouseInputSource::invalidTiltX,
+                                 juce::MouseInputSource::invalidTiltY, &component, &component, now,
+                                 mouse_down_position, now, 1, dragged);
+    }
+
+    // The editor of a new instance of the plugin and what the frames drive in it
+    class OpenEditor
+    {
+    public:
+        explicit OpenEditor (const EditorBenchmark& benchmark)
+            : processor_ (benchmark.create_processor()),
+              editor_ (processor_->createEditorIfNeeded()),
+              image_ (juce::Image::ARGB,
+                      juce::roundToInt (static_cast<float> (editor_->getWidth()) * benchmark.scale),
+                      juce::roundToInt (static_cast<float> (editor_->getHeight()) * benchmark.scale),
+                      true),
+              graphics_ (image_)
+        {
+            graphics_.addTransform (juce::AffineTransform::scale (benchmark.scale));
+
+            // Frames start after the editor has built what it defers
+            dispatchPendingMessages();
+            collectComponents (*editor_, components_);
+            for (auto* component : components_)
+            {
+                if (auto* slider = dynamic_cast<juce::Slider*> (component))
+                    sliders_.push_back (slider);
+                if (auto* timer = dynamic_cast<juce::Timer*> (component))
+                    timers_.push_back (timer);
+            }
+        }
+
+        ~OpenEditor()
+        {
+            // Editors tell their processor when they go, so they must go first
+            editor_.reset();
+        }
+
+        void sendEvents (int frame)
+        {
+            moveMouse (frame);
+            if (! sliders_.empty())
+                dragSlider (frame);
+
+            for (auto* timer : timers_)
+            {
+                if (timer->isTimerRunning())
+                    timer->timerCallback();
+            }
+        }
+
+        void paint()
+        {
+            editor_->paintEntireComponent (graphics_, false);
+        }
+
+    private:
+        // Every component sees the move, like the global mouse listeners of Easyverb's triangles
+        void moveMouse (int frame)
+        {
+            const auto phase = static_cast<float> (frame) * 0.05f;
+            const auto position = juce::Point<float> (static_cast<float> (editor_->getWidth()) * (0.5f + 0.45f * std::sin (phase)),
+                                                      static_cast<float> (editor_->getHeight()) * (0.5f + 0.45f * std::sin (phase * 1.3f)));
+            const auto event = makeMouseEvent (*editor_, position, position, false, false);
+
+            for (auto* component : components_)
+                component->mouseMove (event.getEventRelativeTo (component));
+        }
+
+        // Up and back down through the slider's range, then on to the next slider
+        void dragSlider (int frame)
+        {
+            // The callbacks are called on the Component, as the mouse input of a window would
+            juce::Component& slider = *sliders_[static_cast<size_t> (frame / DRAG_FRAMES) % sliders_.size()];
+            const int step = frame % DRAG_FRAMES;
+            const auto centre = slider.getLocalBounds().getCentre().toFloat();
+            const float offset = static_cast<float> (step < DRAG_FRAMES / 2 ? -step : step - DRAG_FRAMES) * 4.0f;
+
+            if (step == 0)
+                slider.mouseDown (makeMouseEvent (slider, centre, centre, true, false));
+
+            const auto event = makeMouseEvent (slider, centre.translated (0.0f, offset), centre, true, true);
+            slider.mouseDrag (event);
+
+            if (step == DRAG_FRAMES - 1)
+                slider.mouseUp (event);
+        }
+
+        std::unique_ptr<juce::AudioProcessor> processor_;
+        std::unique_ptr<juce::AudioProcessorEditor> editor_;
+        juce::Image image_;
+        juce::Graphics graphics_;
+
+        std::vector<juce::Component*> components_;
+        std::vector<juce::Slider*> sliders_;
+        std::vector<juce::Timer*> timers_;
+    };
+}
+
+juce::String EditorBenchmarkResult::toString() const
+{
+    return name.paddedRight (' ', 32)
+           + juce::String (paint_us_per_frame, 1).paddedLeft (' ', 10) + " us/frame paint"
+           + juce::String (event_us_per_frame, 1).paddedLeft (' ', 10) + " us/frame events"
+           + juce::String (allocations_per_frame, 1).paddedLeft (' ', 10) + " allocations/frame";
+}
+
+EditorBenchmarkResult measure (const EditorBenchmark& benchmark, int num_frames)
+{
+    jassert (num_frames > 0);
+
+    OpenEditor editor (benchmark);
+
+    // Fills the glyph and path caches and starts the animations
+    for (int frame = 0; frame < WARM_UP_FRAMES; ++frame)
+    {
+        editor.sendEvents (frame);
+        editor.paint();
+    }
+
+    juce::int64 event_ticks = 0;
+    juce::int64 paint_ticks = 0;
+    const auto start_allocations = getNumAllocations();
+
+    for (int frame = WARM_UP_FRAMES; frame < WARM_UP_FRAMES + num_frames; ++frame)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        editor.sendEvents (frame);
+        const auto painting = juce::Time::getHighResolutionTicks();
+        editor.paint();
+        const auto end = juce::Time::getHighResolutionTicks();
+
+        event_ticks += painting - start;
+        paint_ticks += end - painting;
+    }
+
+    EditorBenchmarkResult result;
+    result.name = benchmark.name;
+    result.event_us_per_frame = juce::Time::highResolutionTicksToSeconds (event_ticks) * 1.0e6 / num_frames;
+    result.paint_us_per_frame = juce::Time::highResolutionTicksToSeconds (paint_ticks) * 1.0e6 / num_frames;
+    result.allocations_per_frame = static_cast<double> (getNumAllocations() - start_allocations) / num_frames;
+    return result;
+}
+
+std::vector<EditorBenchmark> createEditorBenchmarks()
+{
+    std::vector<EditorBenchmark> benchmarks;
+
+    for (const auto& plugin : PLUGINS)
+    {
+        // Standard, the common Windows 150 % and retina displays
+        for (float scale : { 1.0f, 1.5f, 2.0f })
+        {
+            EditorBenchmark benchmark;
+            benchmark.name = "editor/" + juce::String (plugin.name) + "/" + juce::String (scale, 1) + "x";
+            benchmark.create_processor = plugin.create;
+            benchmark.scale = scale;
+            benchmarks.push_back (std::move (benchmark));
+        }
+    }
+
+    return benchmarks;
+}
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    EditorBenchmark.h
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The editor of a plugin, opened offscreen and painted into an image at scale frame after
+// frame. Before every frame the mouse moves over the editor and one of its sliders is dragged,
+// and the running timers of the components get their callback, the way a user and the message
+// thread would drive the editor at 60 frames per second.
+struct EditorBenchmark
+{
+    juce::String name;
+    std::function<juce::AudioProcessor*()> create_processor;
+    float scale = 1.0f;
+};
+
+struct EditorBenchmarkResult
+{
+    juce::String name;
+    // Mouse events and timer callbacks, without painting
+    double event_us_per_frame = 0.0;
+    double paint_us_per_frame = 0.0;
+    double allocations_per_frame = 0.0;
+
+    juce::String toString() const;
+};
+
+// Runs a warm up and then num_frames frames
+EditorBenchmarkResult measure (const EditorBenchmark& benchmark, int num_frames);
+
+// The editors of all plugins, each at a few scale factors
+std::vector<EditorBenchmark> createEditorBenchmarks();
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    GramophonyPlugin.cpp
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+// The processor and editor of Gramophony as the plugin build compiles them, see Plugins.h
+#define JucePlugin_Name "Gramophony"
+#define createPluginFilter createGramophonyFilter
+
+#include "Plugins.h"
+#include "../../Gramophony/Source/PluginEditor.cpp"
+#include "../../Gramophony/Source/PluginProcessor.cpp"
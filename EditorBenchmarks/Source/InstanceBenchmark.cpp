@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    InstanceBenchmark.cpp
+    Created: 19 Oct 2026 4:41:07pm
+
+  ==============================================================================
+*/
+
+#include "InstanceBenchmark.h"
+#include "AllocationCounter.h"
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int BLOCK_SIZE = 512;
+
+    // Times function over all instances and divides by their number
+    template <typename Function>
+    InstanceBenchmarkResult::Step measureStep (int num_instances, Function&& function)
+    {
+        const auto start_allocations = getNumAllocations();
+        const auto start = juce::Time::getHighResolutionTicks();
+
+        for (int instance = 0; instance < num_instances; ++instance)
+            function (static_cast<size_t> (instance));
+
+        InstanceBenchmarkResult::Step step;
+        step.us_per_instance = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start) * 1.0e6 / num_instances;
+        step.allocations_per_instance = static_cast<double> (getNumAllocations() - start_allocations) / num_instances;
+        return step;
+    }
+
+    juce::String formatStep (const InstanceBenchmarkResult::Step& step)
+    {
+        return juce::String (step.us_per_instance, 1).paddedLeft (' ', 10) + " us"
+               + juce::String (step.allocations_per_instance, 1).paddedLeft (' ', 8) + " allocs";
+    }
+}
+
+juce::String InstanceBenchmarkResult::toString() const
+{
+    return name.paddedRight (' ', 24)
+           + "construct" + formatStep (construct)
+           + "   prepare" + formatStep (prepare)
+           + "   first block" + formatStep (first_block)
+           + "   editor" + formatStep (open_editor);
+}
+
+InstanceBenchmarkResult measureInstances (const Plugin& plugin, int num_instances)
+{
+    jassert (num_instances > 0);
+
+    std::vector<std::unique_ptr<juce::AudioProcessor>> processors (static_cast<size_t> (num_instances));
+    std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors (static_cast<size_t> (num_instances));
+    juce::MidiBuffer midi;
+
+    InstanceBenchmarkResult result;
+    result.name = "instances/" + juce::String (plugin.name);
+
+    result.construct = measureStep (num_instances, [&] (size_t instance) { processors[instance].reset (plugin.create()); });
+
+    // Includes building the DSP, plugins do that right away before their first block
+    result.prepare = measureStep (num_instances, [&] (size_t instance)
+                                  {
+                                      processors[instance]->setRateAndBufferSizeDetails (SAMPLE_RATE, BLOCK_SIZE);
+                                      processors[instance]->prepareToPlay (SAMPLE_RATE, BLOCK_SIZE);
+                                  });
+
+    // Outside the timing, like the buffers of the host
+    juce::AudioBuffer<float> buffer (processors.front()->getTotalNumOutputChannels(), BLOCK_SIZE);
+    result.first_block = measureStep (num_instances, [&] (size_t instance)
+                                      {
+                                          buffer.clear();
+                                          processors[instance]->processBlock (buffer, midi);
+                                      });
+
+    result.open_editor = measureStep (num_instances, [&] (size_t instance) { editors[instance].reset (processors[instance]->createEditorIfNeeded()); });
+
+    // Editors tell their processor when they go, so they must go first
+    editors.clear();
+    processors.clear();
+    return result;
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    InstanceBenchmark.h
+    Created: 19 Oct 2026 4:41:07pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Plugins.h"
+
+// Loading a session with many instances of a plugin, step by step the way a host does it:
+// every instance is constructed, then prepared, then processes its first block, and at last
+// every instance opens its editor. Each step is timed over all instances on its own.
+struct InstanceBenchmarkResult
+{
+    struct Step
+    {
+        double us_per_instance = 0.0;
+        double allocations_per_instance = 0.0;
+    };
+
+    juce::String name;
+    Step construct;
+    // prepareToPlay at 48 kHz with blocks of 512 samples, without what a plugin builds in
+    // the background from there
+    Step prepare;
+    // Silence, once the background work of prepareToPlay is done
+    Step first_block;
+    // createEditor, without what the editor builds once it is open
+    Step open_editor;
+
+    juce::String toString() const;
+};
+
+InstanceBenchmarkResult measureInstances (const Plugin& plugin, int num_instances);
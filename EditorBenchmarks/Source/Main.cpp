@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include "AutomationBenchmark.h"
+#include "EditorBenchmark.h"
+#include "InstanceBenchmark.h"
+#include "RackBenchmark.h"
+#include <JuceHeader.h>
+#include <iostream>
+
+namespace
+{
+    // Benchmarks whose name contains the --filter text, all of them without a filter
+    std::vector<EditorBenchmark> selectBenchmarks (const juce::ArgumentList& args)
+    {
+        const auto filter = args.getValueForOption ("--filter");
+        auto benchmarks = createEditorBenchmarks();
+
+        benchmarks.erase (std::remove_if (benchmarks.begin(), benchmarks.end(), [&filter] (const EditorBenchmark& benchmark)
+                                          { return ! benchmark.name.contains (filter); }),
+                          benchmarks.end());
+
+        if (benchmarks.empty())
+            juce::ConsoleApplication::fail ("No benchmark matches " + filter);
+
+        return benchmarks;
+    }
+
+    void runBenchmarks (const juce::ArgumentList& args)
+    {
+        // Ten seconds at 60 frames per second
+        int num_frames = 600;
+        if (args.containsOption ("--frames"))
+            num_frames = args.getValueForOption ("--frames").getIntValue();
+
+        if (num_frames <= 0)
+            juce::ConsoleApplication::fail ("The number of frames must be positive");
+
+        // Editors need the message manager and the desktop, but never a window
+        juce::ScopedJuceInitialiser_GUI gui;
+
+        for (const auto& benchmark : selectBenchmarks (args))
+            std::cout << measure (benchmark, num_frames).toString() << std::endl;
+    }
+
+    void runInstanceBenchmarks (const juce::ArgumentList& args)
+    {
+        // A large session
+        int num_instances = 100;
+        if (args.containsOption ("--instances"))
+            num_instances = args.getValueForOption ("--instances").getIntValue();
+
+        if (num_instances <= 0)
+            juce::ConsoleApplication::fail ("The number of instances must be positive");
+
+        const auto filter = args.getValueForOption ("--filter");
+        juce::ScopedJuceInitialiser_GUI gui;
+
+        for (const auto& plugin : PLUGINS)
+        {
+            if (juce::String (plugin.name).contains (filter))
+                std::cout << measureInstances (plugin, num_instances).toString() << std::endl;
+        }
+    }
+
+    void runRackBenchmarks (const juce::ArgumentList& args)
+    {
+        double seconds = 2.0;
+        if (args.containsOption ("--seconds"))
+            seconds = args.getValueForOption ("--seconds").getDoubleValue();
+
+        if (seconds <= 0.0)
+            juce::ConsoleApplication::fail ("The time per benchmark must be positive");
+
+        // The plugins apply their quality settings on the message thread
+        juce::ScopedJuceInitialiser_GUI gui;
+
+        for (const auto& result : measureRack (seconds))
+            std::cout << result.toString() << std::endl;
+    }
+
+    void runAutomationBenchmarks (const juce::ArgumentList& args)
+    {
+        double seconds = 1.0;
+        if (args.containsOption ("--seconds"))
+            seconds = args.getValueForOption ("--seconds").getDoubleValue();
+
+        if (seconds <= 0.0)
+            juce::ConsoleApplication::fail ("The time per benchmark must be positive");
+
+        juce::ScopedJuceInitialiser_GUI gui;
+
+        for (const auto& result : measureAutomation (args.getValueForOption ("--filter"), seconds))
+            std::cout << result.toString() << std::endl;
+    }
+
+    void listBenchmarks (const juce::ArgumentList& args)
+    {
+        for (const auto& benchmark : selectBenchmarks (args))
+            std::cout << benchmark.name << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    app.addHelpCommand ("--help|-h", "Times the editors of the plugins painting offscreen, loading many instances, the Rack plugin against the three plugins and automation in CLAP against VST3.", true);
+
+    app.addCommand ({ "run",
+                      "run [--filter=<text>] [--frames=<frames per benchmark>]",
+                      "Opens each editor offscreen, drives it with mouse moves and slider drags and prints the\n"
+                      "time and the allocations per frame.",
+                      "Only benchmarks whose name contains the --filter text are run. Build in Release, a Debug build\n"
+                      "times unoptimised code.",
+                      runBenchmarks });
+
+    app.addCommand ({ "instances",
+                      "instances [--filter=<text>] [--instances=<instances per plugin>]",
+                      "Loads many instances of each plugin and prints the time and the allocations per instance of\n"
+                      "the constructor, prepareToPlay, the first block and createEditor.",
+                      "Only plugins whose name contains the --filter text are loaded.",
+                      runInstanceBenchmarks });
+
+    app.addCommand ({ "rack",
+                      "rack [--seconds=<time per benchmark>]",
+                      "Runs noise through Gramophony, WaveFolder and Easyverb as three plugins in a row and through\n"
+                      "the Rack plugin, and prints the time per sample of both at a few block sizes.",
+                      "Both run at 4x oversampling with the other parameters at their defaults.",
+                      runRackBenchmarks });
+
+    app.addCommand ({ "automation",
+                      "automation [--filter=<text>] [--seconds=<time per benchmark>]",
+                      "Automates the first continuous parameter of each plugin with 0, 8 and 64 events per block and\n"
+                      "prints the time per sample of the CLAP plugin's process and the VST3 plugin's processBlock.",
+                      "The CLAP plugin applies every event at its sample, the VST3 plugin gets the last value of each\n"
+                      "block the way JUCE's VST3 wrapper sets it. Only benchmarks whose name contains the --filter\n"
+                      "text are run.",
+                      runAutomationBenchmarks });
+
+    app.addCommand ({ "list",
+                      "list [--filter=<text>]",
+                      "Lists the names of the benchmarks.",
+                      "",
+                      listBenchmarks });
+
+    return app.findAndRunCommand (argc, argv);
+}
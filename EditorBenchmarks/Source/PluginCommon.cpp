@@ -0,0 +1,17 @@
+/*
+  ==============================================================================
+
+    PluginCommon.cpp
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+// The Common sources that use the macros of a plugin build, with the values of the plugins.
+// The preset bank file is one no plugin uses, so every run starts with the factory presets.
+#define JucePlugin_Manufacturer "Martinheterjag"
+#define JucePlugin_ManufacturerWebsite "martinheterjag.com"
+#define JucePlugin_Name "EditorBenchmarks"
+
+#include "../../Common/InfoButton.cpp"
+#include "../../Common/PresetBank.cpp"
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    Plugins.h
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// The plugins built into this program. Every plugin defines createPluginFilter() and expects
+// the macros of a plugin build, so each is compiled in a file of its own that renames it, see
+// EasyverbPlugin.cpp.
+juce::AudioProcessor* JUCE_CALLTYPE createEasyverbFilter();
+juce::AudioProcessor* JUCE_CALLTYPE createGramophonyFilter();
+juce::AudioProcessor* JUCE_CALLTYPE createWaveFolderFilter();
+// Only timed by RackBenchmark, its editor is the generic one
+juce::AudioProcessor* JUCE_CALLTYPE createRackFilter();
+
+struct Plugin
+{
+    const char* name;
+    juce::AudioProcessor* (JUCE_CALLTYPE* create)();
+};
+
+inline const Plugin PLUGINS[] = {
+    { "easyverb", &createEasyverbFilter },
+    { "gramophony", &createGramophonyFilter },
+    { "wavefolder", &createWaveFolderFilter },
+};
+
+// Delivers the messages the plugins have posted to themselves, such as the parts an editor
+// builds after it opens. Needs modal loops, see the options in EditorBenchmarks.jucer.
+inline void dispatchPendingMessages()
+{
+    juce::MessageManager::getInstance()->runDispatchLoopUntil (50);
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    ProcessTiming.h
+    Created: 19 Oct 2026 10:52:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Time per sample of one processing benchmark
+struct ProcessTiming
+{
+    juce::String name;
+    double ns_per_sample = 0.0;
+
+    juce::String toString() const
+    {
+        return name.paddedRight (' ', 48) + juce::String (ns_per_sample, 2).paddedLeft (' ', 10) + " ns/sample";
+    }
+};
+
+// Time per sample of run(), which processes samples_per_run samples. After a warm up run it
+// runs for min_seconds in a few repeats, the result is the fastest repeat, the one least
+// disturbed by the rest of the system.
+inline double measureNsPerSample (const std::function<void()>& run, int samples_per_run, double min_seconds)
+{
+    constexpr int NUM_REPEATS = 5;
+
+    run();
+
+    double ns_per_sample = std::numeric_limits<double>::max();
+
+    for (int repeat = 0; repeat < NUM_REPEATS; ++repeat)
+    {
+        const auto start = juce::Time::getHighResolutionTicks();
+        juce::int64 num_runs = 0;
+        double seconds = 0.0;
+
+        do
+        {
+            run();
+            ++num_runs;
+            seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+        } while (seconds < min_seconds / NUM_REPEATS);
+
+        ns_per_sample = juce::jmin (ns_per_sample, seconds * 1.0e9 / static_cast<double> (num_runs * samples_per_run));
+    }
+
+    return ns_per_sample;
+}
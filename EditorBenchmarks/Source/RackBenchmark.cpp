@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    RackBenchmark.cpp
+    Created: 19 Oct 2026 10:14:52pm
+
+  ==============================================================================
+*/
+
+#include "RackBenchmark.h"
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int NUM_CHANNELS = 2;
+    constexpr int NUM_FRAMES = 16384;
+    // The "4x" entry of the oversampling choices
+    constexpr float OVERSAMPLING_4X = 2.0f;
+
+    void setParameter (juce::AudioProcessor& processor, const juce::String& id, float value)
+    {
+        for (auto* parameter : processor.getParameters())
+        {
+            auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter);
+            if (ranged != nullptr && ranged->paramID == id)
+            {
+                ranged->setValueNotifyingHost (ranged->convertTo0to1 (value));
+                return;
+            }
+        }
+        jassertfalse;
+    }
+
+    // Processors in a row on the same buffer, each prepared the way a host prepares its inserts
+    struct Chain
+    {
+        Chain (std::vector<std::unique_ptr<juce::AudioProcessor>> chain_processors, int block_size)
+            : processors (std::move (chain_processors)),
+              block_size (block_size),
+              input (NUM_CHANNELS, NUM_FRAMES),
+              buffer (NUM_CHANNELS, NUM_FRAMES)
+        {
+            juce::Random random (0x5eed);
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+            {
+                auto* samples = input.getWritePointer (channel);
+                for (int sample = 0; sample < NUM_FRAMES; ++sample)
+                    samples[sample] = random.nextFloat() * 2.0f - 1.0f;
+            }
+
+            for (auto& processor : processors)
+            {
+                processor->setRateAndBufferSizeDetails (SAMPLE_RATE, block_size);
+                processor->prepareToPlay (SAMPLE_RATE, block_size);
+            }
+
+            // The quality settings are applied asynchronously, the DSP is built right away as
+            // nothing has been processed yet
+            dispatchPendingMessages();
+        }
+
+        ~Chain()
+        {
+            for (auto& processor : processors)
+                processor->releaseResources();
+        }
+
+        void run()
+        {
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+                buffer.copyFrom (channel, 0, input, channel, 0, NUM_FRAMES);
+
+            for (int first_sample = 0; first_sample < NUM_FRAMES; first_sample += block_size)
+            {
+                auto block = juce::AudioBuffer<float> (buffer.getArrayOfWritePointers(), NUM_CHANNELS, first_sample, juce::jmin (block_size, NUM_FRAMES - first_sample));
+                for (auto& processor : processors)
+                    processor->processBlock (block, midi);
+            }
+        }
+
+        std::vector<std::unique_ptr<juce::AudioProcessor>> processors;
+        const int block_size;
+        juce::AudioBuffer<float> input;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+    };
+
+    std::unique_ptr<juce::AudioProcessor> createPlugin (juce::AudioProcessor* (JUCE_CALLTYPE* create)(), const juce::StringArray& oversampled_ids)
+    {
+        std::unique_ptr<juce::AudioProcessor> processor (create());
+        for (const auto& id : oversampled_ids)
+            setParameter (*processor, id, OVERSAMPLING_4X);
+        return processor;
+    }
+}
+
+std::vector<ProcessTiming> measureRack (double min_seconds)
+{
+    std::vector<ProcessTiming> results;
+
+    for (int block_size : { 64, 512, 4096 })
+    {
+        std::vector<std::unique_ptr<juce::AudioProcessor>> plugins;
+        plugins.push_back (createPlugin (&createGramophonyFilter, { "OVERSAMPLING" }));
+        plugins.push_back (createPlugin (&createWaveFolderFilter, { "OVERSAMPLING" }));
+        plugins.push_back (createPlugin (&createEasyverbFilter, {}));
+        Chain separate (std::move (plugins), block_size);
+        results.push_back ({ "rack/three plugins/" + juce::String (block_size) + " block", measureNsPerSample ([&separate] { separate.run(); }, NUM_FRAMES, min_seconds) });
+
+        std::vector<std::unique_ptr<juce::AudioProcessor>> rack_plugin;
+        rack_plugin.push_back (createPlugin (&createRackFilter, { "GRAMOPHONY_OVERSAMPLING", "WAVEFOLDER_OVERSAMPLING" }));
+        Chain rack (std::move (rack_plugin), block_size);
+        results.push_back ({ "rack/rack plugin/" + juce::String (block_size) + " block", measureNsPerSample ([&rack] { rack.run(); }, NUM_FRAMES, min_seconds) });
+    }
+
+    return results;
+}
@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    RackBenchmark.h
+    Created: 19 Oct 2026 10:14:52pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Plugins.h"
+#include "ProcessTiming.h"
+
+// The Rack plugin against Gramophony, WaveFolder and Easyverb as three plugins on a track:
+// the same noise goes through the processBlock of each of the three plugins in a row, the way
+// a host runs an insert chain, and through the processBlock of Rack in the same order, both at
+// 4x oversampling and with the plugins' other defaults. Unlike the rack/ benchmarks of
+// Benchmarks, which time the cores, this includes all the plugins do around their DSP.
+// Runs each chain for at least min_seconds at a few host block sizes.
+std::vector<ProcessTiming> measureRack (double min_seconds);
@@ -0,0 +1,15 @@
+/*
+  ==============================================================================
+
+    RackPlugin.cpp
+    Created: 19 Oct 2026 10:14:52pm
+
+  ==============================================================================
+*/
+
+// The processor of Rack as the plugin build compiles it, see Plugins.h
+#define JucePlugin_Name "Rack"
+#define createPluginFilter createRackFilter
+
+#include "Plugins.h"
+#include "../../Rack/Source/PluginProcessor.cpp"
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    WaveFolderPlugin.cpp
+    Created: 19 Oct 2026 3:52:19pm
+
+  ==============================================================================
+*/
+
+// The processor and editor of WaveFolder as the plugin build compiles them, see Plugins.h
+#define JucePlugin_Name "WaveFolder"
+#define createPluginFilter createWaveFolderFilter
+
+#include "Plugins.h"
+#include "../../WaveFolder/Source/PluginEditor.cpp"
+#include "../../WaveFolder/Source/PluginProcessor.cpp"
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    AutomationScript.cpp
+    Created: 19 Oct 2026 2:31:05pm
+
+  ==============================================================================
+*/
+
+#include "AutomationScript.h"
+
+juce::Result AutomationScript::parse (const juce::String& text)
+{
+    events_.clear();
+    auto lines = juce::StringArray::fromLines (text);
+
+    for (int line_number = 0; line_number < lines.size(); ++line_number)
+    {
+        const auto line = lines[line_number].trim();
+        if (line.isEmpty() || line.startsWithChar ('#'))
+            continue;
+
+        auto tokens = juce::StringArray::fromTokens (line, " \t", "\"");
+        tokens.removeEmptyStrings();
+        if (tokens.size() != 3 || ! tokens[0].containsOnly ("0123456789.") || ! tokens[2].containsOnly ("0123456789."))
+            return juce::Result::fail ("Line " + juce::String (line_number + 1) + ": expected <seconds> <parameter> <value>");
+
+        Event event;
+        event.time = tokens[0].getDoubleValue();
+        event.parameter = tokens[1].unquoted();
+        event.value = juce::jlimit (0.0f, 1.0f, tokens[2].getFloatValue());
+        events_.push_back (event);
+    }
+
+    std::stable_sort (events_.begin(), events_.end(), [] (const Event& a, const Event& b) { return a.time < b.time; });
+    return juce::Result::ok();
+}
+
+juce::Result AutomationScript::applyInitialValues (juce::AudioProcessor& processor) const
+{
+    for (const auto& event : events_)
+    {
+        if (event.time > 0.0)
+            break;
+
+        auto* parameter = findParameter (processor, event.parameter);
+        if (parameter == nullptr)
+            return juce::Result::fail ("No parameter with a unique name or index \"" + event.parameter + "\"");
+
+        parameter->setValueNotifyingHost (event.value);
+    }
+    return juce::Result::ok();
+}
+
+juce::Result AutomationScript::render (juce::AudioProcessor& processor, juce::AudioBuffer<float>& buffer, double sample_rate, int block_size) const
+{
+    std::vector<std::pair<juce::int64, juce::AudioProcessorParameter*>> changes;
+    for (const auto& event : events_)
+    {
+        auto* parameter = findParameter (processor, event.parameter);
+        if (parameter == nullptr)
+            return juce::Result::fail ("No parameter with a unique name or index \"" + event.parameter + "\"");
+
+        changes.emplace_back (static_cast<juce::int64> (std::llround (event.time * sample_rate)), parameter);
+    }
+
+    juce::MidiBuffer midi;
+    size_t next_event = 0;
+    int position = 0;
+
+    while (position < buffer.getNumSamples())
+    {
+        while (next_event < events_.size() && changes[next_event].first <= position)
+        {
+            changes[next_event].second->setValueNotifyingHost (events_[next_event].value);
+            ++next_event;
+        }
+
+        int num_samples = juce::jmin (block_size, buffer.getNumSamples() - position);
+        if (next_event < events_.size())
+            num_samples = juce::jmin (num_samples, static_cast<int> (changes[next_event].first - position));
+
+        juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), position, num_samples);
+        processor.processBlock (block, midi);
+        midi.clear();
+        position += num_samples;
+    }
+
+    return juce::Result::ok();
+}
+
+juce::AudioProcessorParameter* AutomationScript::findParameter (juce::AudioProcessor& processor, const juce::String& parameter)
+{
+    const auto& parameters = processor.getParameters();
+
+    if (parameter.containsOnly ("0123456789"))
+    {
+        const int index = parameter.getIntValue();
+        return juce::isPositiveAndBelow (index, parameters.size()) ? parameters[index] : nullptr;
+    }
+
+    juce::AudioProcessorParameter* found = nullptr;
+    for (auto* candidate : parameters)
+    {
+        if (candidate->getName (1024) == parameter)
+        {
+            if (found != nullptr)
+                return nullptr;
+            found = candidate;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    AutomationScript.h
+    Created: 19 Oct 2026 2:31:05pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Parameter changes at fixed times, applied while a signal is rendered through a plugin.
+//
+// Scripts are plain text with one change per line:
+//
+//     <time in seconds> <parameter index or name> <normalised value>
+//
+// Empty lines and lines starting with # are ignored. Names must be unique within the plugin,
+// so parameters that share a name (e.g. the LFO rates of WaveFolder) are given by index.
+class AutomationScript
+{
+public:
+    juce::Result parse (const juce::String& text);
+    bool isEmpty() const { return events_.empty(); }
+
+    // Applies the changes at 0 seconds. Call before preparing the processor, so settings that
+    // a plugin only reads when it is prepared (e.g. quality modes) are in effect from the start.
+    juce::Result applyInitialValues (juce::AudioProcessor& processor) const;
+
+    // Processes buffer in place in blocks of at most block_size samples. Blocks are split at
+    // the automation events so every change lands on the same sample on every run.
+    juce::Result render (juce::AudioProcessor& processor, juce::AudioBuffer<float>& buffer, double sample_rate, int block_size) const;
+
+    // The parameter with the index or unique name, nullptr when there is none
+    static juce::AudioProcessorParameter* findParameter (juce::AudioProcessor& processor, const juce::String& parameter);
+
+private:
+    struct Event
+    {
+        double time = 0.0;
+        juce::String parameter;
+        float value = 0.0f;
+    };
+
+    std::vector<Event> events_;
+};
@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include "AutomationScript.h"
+#include "OutputComparison.h"
+#include "TestSignals.h"
+#include <JuceHeader.h>
+#include <iostream>
+
+namespace
+{
+    struct RenderSettings
+    {
+        double sample_rate = 48000.0;
+        int block_size = 512;
+        double seconds = 4.0;
+        // Renders like a bounce, plugins with quality tiers use their offline one
+        bool offline = false;
+        // Turns off the mono shortcut of plugins that have one, see DualMono
+        bool dual_mono = true;
+        AutomationScript automation;
+    };
+
+    void readAutomation (const juce::File& script, RenderSettings& settings)
+    {
+        const auto result = settings.automation.parse (script.loadFileAsString());
+        if (result.failed())
+            juce::ConsoleApplication::fail (script.getFileName() + ": " + result.getErrorMessage());
+    }
+
+    RenderSettings readSettings (const juce::ArgumentList& args)
+    {
+        RenderSettings settings;
+
+        if (args.containsOption ("--rate"))
+            settings.sample_rate = args.getValueForOption ("--rate").getDoubleValue();
+        if (args.containsOption ("--block"))
+            settings.block_size = args.getValueForOption ("--block").getIntValue();
+        if (args.containsOption ("--seconds"))
+            settings.seconds = args.getValueForOption ("--seconds").getDoubleValue();
+        settings.offline = args.containsOption ("--offline");
+        settings.dual_mono = ! args.containsOption ("--no-dual-mono");
+
+        if (settings.sample_rate <= 0.0 || settings.block_size <= 0 || settings.seconds <= 0.0)
+            juce::ConsoleApplication::fail ("Sample rate, block size and length must be positive");
+
+        if (args.containsOption ("--automation"))
+            readAutomation (args.getExistingFileForOption ("--automation"), settings);
+
+        return settings;
+    }
+
+    juce::File getPluginFile (const juce::ArgumentList::Argument& argument)
+    {
+        // Depending on the build a VST3 is either a single file or a bundle folder
+        const auto file = argument.resolveAsFile();
+        if (! file.exists())
+            juce::ConsoleApplication::fail ("Could not find " + file.getFullPathName());
+        return file;
+    }
+
+    std::unique_ptr<juce::AudioPluginInstance> loadPlugin (const juce::File& file, const RenderSettings& settings)
+    {
+        juce::VST3PluginFormat format;
+        juce::OwnedArray<juce::PluginDescription> descriptions;
+        format.findAllTypesForFile (descriptions, file.getFullPathName());
+
+        if (descriptions.isEmpty())
+            juce::ConsoleApplication::fail ("No VST3 plugin found in " + file.getFullPathName());
+
+        juce::String error;
+        auto plugin = format.createInstanceFromDescription (*descriptions[0], settings.sample_rate, settings.block_size, error);
+        if (plugin == nullptr)
+            juce::ConsoleApplication::fail ("Could not load " + file.getFileName() + ": " + error);
+
+        return plugin;
+    }
+
+    // Every signal gets a freshly loaded plugin, so no state carries over between signals
+    juce::AudioBuffer<float> renderThroughPlugin (const juce::File& plugin_file, TestSignal signal, const RenderSettings& settings)
+    {
+        auto plugin = loadPlugin (plugin_file, settings);
+        plugin->enableAllBuses();
+
+        const auto initial = settings.automation.applyInitialValues (*plugin);
+        if (initial.failed())
+            juce::ConsoleApplication::fail (initial.getErrorMessage());
+
+        if (! settings.dual_mono)
+        {
+            auto* shortcut = AutomationScript::findParameter (*plugin, "Mono shortcut");
+            if (shortcut == nullptr)
+                juce::ConsoleApplication::fail (plugin->getName() + " has no mono shortcut to turn off");
+            shortcut->setValueNotifyingHost (0.0f);
+        }
+
+        plugin->setNonRealtime (settings.offline);
+        // The plugins build their DSP in prepareToPlay when nothing has been processed yet, so
+        // the first block already has it
+        plugin->prepareToPlay (settings.sample_rate, settings.block_size);
+
+        const int num_channels = juce::jmax (plugin->getTotalNumInputChannels(), plugin->getTotalNumOutputChannels());
+        const int num_samples = juce::roundToInt (settings.seconds * settings.sample_rate);
+        juce::AudioBuffer<float> buffer (num_channels, num_samples);
+        renderTestSignal (signal, buffer, settings.sample_rate);
+
+        const auto result = settings.automation.render (*plugin, buffer, settings.sample_rate, settings.block_size);
+        plugin->releaseResources();
+
+        if (result.failed())
+            juce::ConsoleApplication::fail (result.getErrorMessage());
+
+        return buffer;
+    }
+
+    juce::File getReferenceFile (const juce::File& folder, TestSignal signal)
+    {
+        return folder.getChildFile (getSignalName (signal) + ".wav");
+    }
+
+    void writeReference (const juce::File& file, const juce::AudioBuffer<float>& buffer, double sample_rate)
+    {
+        file.deleteFile();
+        auto stream = file.createOutputStream();
+        juce::WavAudioFormat wav;
+
+        // 32 bit float, so the reference holds exactly what the plugin produced
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if (stream != nullptr)
+            writer.reset (wav.createWriterFor (stream.get(), sample_rate, static_cast<unsigned int> (buffer.getNumChannels()), 32, {}, 0));
+
+        if (writer == nullptr)
+            juce::ConsoleApplication::fail ("Could not write " + file.getFullPathName());
+
+        stream.release();
+        writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples());
+    }
+
+    juce::AudioBuffer<float> readReference (const juce::File& file, double sample_rate)
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader (wav.createReaderFor (file.createInputStream().release(), true));
+
+        if (reader == nullptr)
+            juce::ConsoleApplication::fail ("Could not read the reference " + file.getFullPathName());
+        if (reader->sampleRate != sample_rate)
+            juce::ConsoleApplication::fail (file.getFileName() + " was rendered at " + juce::String (reader->sampleRate) + " Hz, use --rate to match");
+
+        juce::AudioBuffer<float> buffer (static_cast<int> (reader->numChannels), static_cast<int> (reader->lengthInSamples));
+        reader->read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+
+    void renderReferences (const juce::ArgumentList& args)
+    {
+        args.checkMinNumArguments (3);
+        const auto plugin_file = getPluginFile (args[1]);
+        const auto folder = args[2].resolveAsFile();
+        const auto settings = readSettings (args);
+
+        if (! folder.createDirectory())
+            juce::ConsoleApplication::fail ("Could not create " + folder.getFullPathName());
+
+        for (int index = 0; index < static_cast<int> (TestSignal::NUM_SIGNALS); ++index)
+        {
+            const auto signal = static_cast<TestSignal> (index);
+            writeReference (getReferenceFile (folder, signal), renderThroughPlugin (plugin_file, signal, settings), settings.sample_rate);
+            std::cout << getSignalName (signal) << ": written" << std::endl;
+        }
+    }
+
+    // Prints a report for every signal and returns how many of them failed
+    int compareSignals (const juce::File& plugin_file, const juce::File& folder, const RenderSettings& settings, const Tolerance& tolerance)
+    {
+        int num_failed = 0;
+        for (int index = 0; index < static_cast<int> (TestSignal::NUM_SIGNALS); ++index)
+        {
+            const auto signal = static_cast<TestSignal> (index);
+            const auto reference = readReference (getReferenceFile (folder, signal), settings.sample_rate);
+            const auto report = compareOutputs (renderThroughPlugin (plugin_file, signal, settings), reference, tolerance);
+
+            std::cout << getSignalName (signal) << ": " << report.toString (settings.sample_rate) << std::endl;
+            if (! report.passed())
+                ++num_failed;
+        }
+        return num_failed;
+    }
+
+    void compareWithReferences (const juce::ArgumentList& args)
+    {
+        args.checkMinNumArguments (3);
+        const auto plugin_file = getPluginFile (args[1]);
+        const auto folder = args[2].resolveAsExistingFolder();
+        const auto settings = readSettings (args);
+
+        Tolerance tolerance;
+        if (args.containsOption ("--ulps"))
+            tolerance.max_ulps = args.getValueForOption ("--ulps").getLargeIntValue();
+        if (args.containsOption ("--db"))
+            tolerance.max_difference_db = args.getValueForOption ("--db").getDoubleValue();
+
+        const int num_failed = compareSignals (plugin_file, folder, settings, tolerance);
+        if (num_failed > 0)
+            juce::ConsoleApplication::fail (juce::String (num_failed) + " of " + juce::String (static_cast<int> (TestSignal::NUM_SIGNALS)) + " signals differ from the references");
+    }
+
+    // Compares the plugins with the references checked in under the GoldenRender folder, at the
+    // default settings with the automation script of each plugin. Meant for before a merge or
+    // release: fails on any difference and on a plugin without references.
+    void checkReferences (const juce::ArgumentList& args)
+    {
+        args.checkMinNumArguments (3);
+        const auto golden_render_folder = args[1].resolveAsExistingFolder();
+
+        int num_failed = 0;
+        for (int argument = 2; argument < args.size(); ++argument)
+        {
+            const auto plugin_file = getPluginFile (args[argument]);
+            const auto name = plugin_file.getFileNameWithoutExtension();
+            const auto folder = golden_render_folder.getChildFile ("References").getChildFile (name);
+            const auto script = golden_render_folder.getChildFile ("Automation").getChildFile (name + ".txt");
+
+            if (! folder.isDirectory())
+                juce::ConsoleApplication::fail ("No references for " + name + " in " + folder.getFullPathName() + ", render them with the release build and check them in");
+
+            RenderSettings settings;
+            if (script.existsAsFile())
+                readAutomation (script, settings);
+
+            std::cout << name << std::endl;
+            num_failed += compareSignals (plugin_file, folder, settings, Tolerance());
+        }
+
+        if (num_failed > 0)
+            juce::ConsoleApplication::fail (juce::String (num_failed) + " signals differ from the checked in references");
+    }
+
+    void listParameters (const juce::ArgumentList& args)
+    {
+        args.checkMinNumArguments (2);
+        auto plugin = loadPlugin (getPluginFile (args[1]), RenderSettings());
+
+        const auto& parameters = plugin->getParameters();
+        for (int index = 0; index < parameters.size(); ++index)
+            std::cout << index << "\t" << parameters[index]->getName (1024) << "\t" << parameters[index]->getValue() << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // Hosting plugins needs a message manager, even without any windows
+    juce::ScopedJuceInitialiser_GUI juce_initialiser;
+
+    juce::ConsoleApplication app;
+    app.addHelpCommand ("--help|-h", "Renders test signals through a plugin and compares the output with stored references.", true);
+
+    const juce::String options = "[--automation=<script>] [--rate=<Hz>] [--block=<samples>] [--seconds=<length>] [--offline] [--no-dual-mono]";
+
+    app.addCommand ({ "render",
+                      "render <plugin.vst3> <reference folder> " + options,
+                      "Renders every test signal and stores the outputs as references.",
+                      "",
+                      renderReferences });
+
+    app.addCommand ({ "compare",
+                      "compare <plugin.vst3> <reference folder> " + options + " [--ulps=<n>] [--db=<dBFS>]",
+                      "Renders every test signal again and reports where the output differs from the references.",
+                      "By default only bit identical output passes. A sample within --ulps floating point steps of the\n"
+                      "reference, or differing by less than --db dBFS, passes as well. Exits with 1 when any signal differs.",
+                      compareWithReferences });
+
+    app.addCommand ({ "check",
+                      "check <GoldenRender folder> <plugin.vst3> [<plugin.vst3>...]",
+                      "Compares every plugin with the references checked in under <GoldenRender folder>/References.",
+                      "The references of a plugin are in the folder named like its file, e.g. References/WaveFolder,\n"
+                      "rendered at the default settings with Automation/<name>.txt. Exits with 1 when any signal\n"
+                      "differs or a plugin has no references.",
+                      checkReferences });
+
+    app.addCommand ({ "parameters",
+                      "parameters <plugin.vst3>",
+                      "Lists the parameter indices and names to use in automation scripts.",
+                      "",
+                      listParameters });
+
+    return app.findAndRunCommand (argc, argv);
+}
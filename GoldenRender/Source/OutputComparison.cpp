@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    OutputComparison.cpp
+    Created: 19 Oct 2026 2:48:17pm
+
+  ==============================================================================
+*/
+
+#include "OutputComparison.h"
+
+namespace
+{
+    // Maps the bits of a float onto integers that are ordered like the floats, so the
+    // distance between two mapped values counts the representable floats between them.
+    juce::int64 toOrderedInteger (float value)
+    {
+        juce::int32 bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        return bits < 0 ? static_cast<juce::int64> (std::numeric_limits<juce::int32>::min()) - bits : bits;
+    }
+
+    double toDecibels (double difference)
+    {
+        return difference > 0.0 ? 20.0 * std::log10 (difference) : -1000.0;
+    }
+}
+
+juce::String ComparisonReport::toString (double sample_rate) const
+{
+    if (! matches_layout)
+        return "channel count or length differs from the reference";
+
+    if (passed())
+        return "matches, worst difference " + juce::String (worst_difference_db, 1) + " dBFS (" + juce::String (worst_ulps) + " ULP)";
+
+    const auto time = [sample_rate] (juce::int64 sample) { return juce::String (sample / sample_rate, 4) + " s"; };
+
+    return juce::String (num_failing_samples) + " samples differ, first in channel " + juce::String (first_failing_channel)
+           + " at sample " + juce::String (first_failing_sample) + " (" + time (first_failing_sample) + "), worst "
+           + juce::String (worst_difference_db, 1) + " dBFS (" + juce::String (worst_ulps) + " ULP) in channel "
+           + juce::String (worst_channel) + " at sample " + juce::String (worst_sample) + " (" + time (worst_sample) + ")";
+}
+
+ComparisonReport compareOutputs (const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference, const Tolerance& tolerance)
+{
+    ComparisonReport report;
+
+    if (output.getNumChannels() != reference.getNumChannels() || output.getNumSamples() != reference.getNumSamples())
+    {
+        report.matches_layout = false;
+        return report;
+    }
+
+    for (int channel = 0; channel < output.getNumChannels(); ++channel)
+    {
+        const auto* rendered = output.getReadPointer (channel);
+        const auto* expected = reference.getReadPointer (channel);
+
+        for (int i = 0; i < output.getNumSamples(); ++i)
+        {
+            if (rendered[i] == expected[i])
+                continue;
+
+            const auto ulps = std::abs (toOrderedInteger (rendered[i]) - toOrderedInteger (expected[i]));
+            const auto difference_db = toDecibels (std::abs (static_cast<double> (rendered[i]) - expected[i]));
+
+            if (difference_db > report.worst_difference_db)
+            {
+                report.worst_difference_db = difference_db;
+                report.worst_channel = channel;
+                report.worst_sample = i;
+            }
+            report.worst_ulps = juce::jmax (report.worst_ulps, ulps);
+
+            // NaN never passes, whatever the tolerance
+            const bool within_tolerance = ! std::isnan (rendered[i])
+                                          && (ulps <= tolerance.max_ulps || difference_db <= tolerance.max_difference_db);
+            if (! within_tolerance)
+            {
+                if (report.num_failing_samples == 0)
+                {
+                    report.first_failing_channel = channel;
+                    report.first_failing_sample = i;
+                }
+                ++report.num_failing_samples;
+            }
+        }
+    }
+
+    return report;
+}
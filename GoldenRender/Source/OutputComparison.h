@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    OutputComparison.h
+    Created: 19 Oct 2026 2:48:17pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// How far a rendered sample may be from the reference. A sample passes when it is at most
+// max_ulps floating point steps away, or when the difference is below max_difference_db
+// dBFS. The defaults only accept bit identical output.
+struct Tolerance
+{
+    juce::int64 max_ulps = 0;
+    double max_difference_db = -1000.0;
+};
+
+// Where and by how much a rendered output diverged from its reference
+struct ComparisonReport
+{
+    bool matches_layout = true;
+    juce::int64 num_failing_samples = 0;
+    int first_failing_channel = -1;
+    juce::int64 first_failing_sample = -1;
+    int worst_channel = -1;
+    juce::int64 worst_sample = -1;
+    double worst_difference_db = -1000.0;
+    juce::int64 worst_ulps = 0;
+
+    bool passed() const { return matches_layout && num_failing_samples == 0; }
+    juce::String toString (double sample_rate) const;
+};
+
+ComparisonReport compareOutputs (const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& reference, const Tolerance& tolerance);
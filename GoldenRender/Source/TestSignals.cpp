@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    TestSignals.cpp
+    Created: 19 Oct 2026 2:12:40pm
+
+  ==============================================================================
+*/
+
+#include "TestSignals.h"
+
+constexpr double SINE_FREQUENCY = 997.0;
+constexpr double SWEEP_START = 20.0;
+constexpr double SWEEP_END = 20000.0;
+constexpr float SINE_LEVEL = 0.5f;
+constexpr float NOISE_LEVEL = 0.25f;
+constexpr juce::int64 NOISE_SEED = 0x5eed;
+
+juce::String getSignalName (TestSignal signal)
+{
+    switch (signal)
+    {
+        case TestSignal::sine:
+            return "sine";
+        case TestSignal::sweep:
+            return "sweep";
+        case TestSignal::noise:
+            return "noise";
+        case TestSignal::impulse:
+            return "impulse";
+        case TestSignal::silence:
+        case TestSignal::NUM_SIGNALS:
+            break;
+    }
+    return "silence";
+}
+
+void renderTestSignal (TestSignal signal, juce::AudioBuffer<float>& buffer, double sample_rate)
+{
+    buffer.clear();
+    const int num_samples = buffer.getNumSamples();
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto* samples = buffer.getWritePointer (channel);
+
+        switch (signal)
+        {
+            case TestSignal::sine:
+            {
+                // Not a divisor of common sample rates, so every cycle hits other phases
+                const double increment = juce::MathConstants<double>::twoPi * SINE_FREQUENCY / sample_rate;
+                for (int i = 0; i < num_samples; ++i)
+                    samples[i] = SINE_LEVEL * static_cast<float> (std::sin (increment * i));
+                break;
+            }
+            case TestSignal::sweep:
+            {
+                // Exponential sweep over the whole length of the buffer
+                const double duration = num_samples / sample_rate;
+                const double log_ratio = std::log (SWEEP_END / SWEEP_START);
+                for (int i = 0; i < num_samples; ++i)
+                {
+                    const double t = i / sample_rate;
+                    const double phase = juce::MathConstants<double>::twoPi * SWEEP_START * duration / log_ratio
+                                         * (std::exp (t * log_ratio / duration) - 1.0);
+                    samples[i] = SINE_LEVEL * static_cast<float> (std::sin (phase));
+                }
+                break;
+            }
+            case TestSignal::noise:
+            {
+                // Different but fixed noise in every channel
+                juce::Random random (NOISE_SEED + channel);
+                for (int i = 0; i < num_samples; ++i)
+                    samples[i] = NOISE_LEVEL * (random.nextFloat() * 2.0f - 1.0f);
+                break;
+            }
+            case TestSignal::impulse:
+            {
+                // One impulse a second, leaving room for the tails
+                const int interval = juce::roundToInt (sample_rate);
+                for (int i = interval / 10; i < num_samples; i += interval)
+                    samples[i] = 1.0f;
+                break;
+            }
+            case TestSignal::silence:
+            case TestSignal::NUM_SIGNALS:
+                break;
+        }
+    }
+}
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    TestSignals.h
+    Created: 19 Oct 2026 2:12:40pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Deterministic input signals that cover the cases the plugins have broken on before:
+// steady tones, the whole spectrum, transients and the gate around silence.
+enum class TestSignal
+{
+    sine = 0,
+    sweep,
+    noise,
+    impulse,
+    silence,
+    NUM_SIGNALS
+};
+
+juce::String getSignalName (TestSignal signal);
+
+// Fills every channel of buffer. The same arguments always give bit identical output.
+void renderTestSignal (TestSignal signal, juce::AudioBuffer<float>& buffer, double sample_rate);
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    GramophonyCore.cpp
+    Created: 19 Oct 2026 9:41:05pm
+
+  ==============================================================================
+*/
+
+#include "GramophonyCore.h"
+
+namespace
+{
+    // Hard knee compression above the treshold, as a sample stage
+    struct ClipStage
+    {
+        float treshold;
+
+        float processSample (float sample) const
+        {
+            if (sample >= treshold)
+                return (sample / 4) + (3 * treshold / 4);
+            if (sample <= -treshold)
+                return (sample / 4) - (3 * treshold / 4);
+            return sample;
+        }
+    };
+}
+
+const CoreParameter GramophonyCore::PARAMETERS[NUM_PARAMETERS] = {
+    { "COMPRESS", "Compress", 0.04f, 0.45f, 0.1f },
+    { "VIBRATO", "Vibrato", 0.0f, 0.33f, 0.01f },
+    { "VIBRATO_RATE", "Rate", 0.5f, 4.0f, 2.0f },
+    { "TONE", "Tone", 320.1f, 4700.0f, 2000.0f },
+    { "MIX", "Mix", 0.0f, 0.5f, 0.0f },
+    { "OVERSAMPLING", "Oversampling", 0.0f, 3.0f, 0.0f, true, true, "Off|2x|4x|8x" },
+    { "OVERSAMPLING_FILTER", "Oversampling Filter", 0.0f, 1.0f, 0.0f, true, true, "Low latency|Linear phase" },
+};
+
+GramophonyCore::GramophonyCore()
+{
+    for (int parameter = 0; parameter < NUM_PARAMETERS; ++parameter)
+        values_[static_cast<size_t> (parameter)] = PARAMETERS[parameter].default_value;
+}
+
+void GramophonyCore::compress (juce::dsp::AudioBlock<float>& block, float treshold)
+{
+    // Clipping and makeup gain in one pass over the oversampled signal
+    auto stages = makeSampleStages (ClipStage { treshold }, GainStage { 5.0f - (11.0f * treshold * treshold) });
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+        stages.process (block.getChannelPointer (channel), static_cast<int> (block.getNumSamples()));
+}
+
+MultiChannelBiquad::Coefficients GramophonyCore::makeBandPass (double sample_rate, float frequency, int channel)
+{
+    // The band-passes are slightly detuned between even (left) and odd (right) channels
+    // to give the sound some width, whatever the channel layout.
+    if (channel % 2 == 0)
+        return MultiChannelBiquad::makeBandPass (sample_rate, frequency + 10.0f, 2.7f);
+    return MultiChannelBiquad::makeBandPass (sample_rate, frequency - 10.0f, 2.73f);
+}
+
+void GramophonyCore::prepare (double sample_rate, int max_block_size, int num_channels)
+{
+    // Every stage only ever sees one micro block
+    const int scratch_size = MicroBlocks::getScratchSize (max_block_size);
+    const juce::dsp::ProcessSpec spec = { sample_rate, static_cast<juce::uint32> (scratch_size), static_cast<juce::uint32> (num_channels) };
+
+    sample_rate_ = sample_rate;
+    num_channels_ = num_channels;
+
+    const auto filter_type = static_cast<Oversampler::FilterType> (juce::roundToInt (values_[OVERSAMPLING_FILTER]));
+    oversampler_.prepare (num_channels, scratch_size, 1 << juce::roundToInt (values_[OVERSAMPLING]), filter_type);
+
+    band_pass_.prepare (num_channels);
+    updateFilters (values_[TONE]);
+
+    chorus_.prepare (spec);
+    mix_.prepare (spec);
+    mix_.setWetLatency (oversampler_.getLatencySamples());
+    dual_mono_.reset();
+    micro_channels_.resize (static_cast<size_t> (num_channels));
+}
+
+void GramophonyCore::reset()
+{
+    oversampler_.reset();
+    dual_mono_.reset();
+    band_pass_.reset();
+    chorus_.reset();
+    mix_.reset();
+}
+
+void GramophonyCore::setFirstChannel (int first_channel)
+{
+    first_channel_ = first_channel;
+    updateFilters (values_[TONE]);
+}
+
+void GramophonyCore::setParameter (int index, float value)
+{
+    if (index >= 0 && index < NUM_PARAMETERS)
+        values_[static_cast<size_t> (index)] = juce::jlimit (PARAMETERS[index].min_value, PARAMETERS[index].max_value, value);
+}
+
+void GramophonyCore::updateFilters (float frequency)
+{
+    for (int channel = 0; channel < band_pass_.getNumChannels(); ++channel)
+        band_pass_.setCoefficients (channel, makeBandPass (sample_rate_, frequency, first_channel_ + channel));
+    band_pass_frequency_ = frequency;
+}
+
+void GramophonyCore::process (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    juce::ScopedNoDenormals no_denormals;
+
+    if (values_[TONE] != band_pass_frequency_)
+        updateFilters (values_[TONE]);
+
+    chorus_.setRate (values_[VIBRATO_RATE]);
+    chorus_.setDepth (values_[VIBRATO]);
+    chorus_.setCentreDelay (1.0f);
+    chorus_.setFeedback (0.0f);
+    chorus_.setMix (1.0f);
+    mix_.setWetMixProportion (1.0f - values_[MIX]);
+
+    // The dry copy and the signal stay in L1 from the compressor to the mix, see MicroBlocks
+    const float treshold = values_[COMPRESS];
+
+    // AudioBlocks refer to the channel pointers without copying them, whatever the layout
+    const auto make_block = [] (float* const* micro_channels, int micro_num_channels, int micro_samples) {
+        return juce::dsp::AudioBlock<float> (micro_channels, static_cast<size_t> (micro_num_channels), 0, static_cast<size_t> (micro_samples));
+    };
+
+    makeStageChain (makeFunctionStage ([&] (float* const* micro_channels, int micro_num_channels, int micro_samples) { mix_.pushDrySamples (make_block (micro_channels, micro_num_channels, micro_samples)); }),
+                    makeFunctionStage ([&] (float* const* micro_channels, int micro_num_channels, int micro_samples) { compressOversampled (micro_channels, micro_num_channels, micro_samples, treshold); }),
+                    BiquadStage { band_pass_ },
+                    makeFunctionStage ([&] (float* const* micro_channels, int micro_num_channels, int micro_samples) {
+                        auto block = make_block (micro_channels, micro_num_channels, micro_samples);
+                        chorus_.process (juce::dsp::ProcessContextReplacing<float> (block));
+                    }),
+                    makeFunctionStage ([&] (float* const* micro_channels, int micro_num_channels, int micro_samples) { mix_.mixWetSamples (make_block (micro_channels, micro_num_channels, micro_samples)); }))
+        .process (channels, num_channels, num_samples, micro_channels_);
+}
+
+void GramophonyCore::compressOversampled (float* const* channels, int num_channels, int num_samples, float treshold)
+{
+    // Only the compressor creates harmonics, so it is the only stage that runs oversampled.
+    // Identical channels compress to the same thing, see DualMono
+    const auto get_difference = [&] { return oversampler_.getStateDifference (num_channels); };
+    const auto copy_state = [&] { oversampler_.copyFirstChannelState (num_channels); };
+    const int num_compressed = dual_mono_.update (channels, num_channels, num_samples, get_difference, copy_state) ? 1 : num_channels;
+
+    oversampler_.process (channels, num_compressed, num_samples, [treshold] (juce::dsp::AudioBlock<float>& oversampled, int /*first_sample*/) { compress (oversampled, treshold); });
+    if (num_compressed < num_channels)
+        DualMono::copyFirstChannel (channels, num_channels, num_samples);
+}
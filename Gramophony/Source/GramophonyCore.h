@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    GramophonyCore.h
+    Created: 19 Oct 2026 9:41:05pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <CoreParameter.h>
+#include <DualMono.h>
+#include <JuceHeader.h>
+#include <MicroBlocks.h>
+#include <MultiChannelBiquad.h>
+#include <Oversampler.h>
+#include <StageChain.h>
+
+// The sound of Gramophony without the plugin around it: compressor, band-pass, vibrato and
+// mix, for hosts that embed the DSP directly. Needs juce_audio_basics and juce_dsp only.
+//
+// Parameters are plain values in the ranges of PARAMETERS. The quality settings OVERSAMPLING
+// and OVERSAMPLING_FILTER take effect at the next prepare(). No presets, tiers, worker
+// threads or CPU governor, those stay in the plugin.
+class GramophonyCore
+{
+public:
+    enum Parameter
+    {
+        COMPRESS = 0,
+        VIBRATO,
+        VIBRATO_RATE,
+        TONE,
+        MIX,
+        OVERSAMPLING,
+        OVERSAMPLING_FILTER,
+        NUM_PARAMETERS
+    };
+
+    static const CoreParameter PARAMETERS[NUM_PARAMETERS];
+
+    GramophonyCore();
+
+    // Also used by the plugin, so both sound the same
+    static void compress (juce::dsp::AudioBlock<float>& block, float treshold);
+    static MultiChannelBiquad::Coefficients makeBandPass (double sample_rate, float frequency, int channel);
+
+    void prepare (double sample_rate, int max_block_size, int num_channels);
+    void reset();
+    // Index of the first channel in the host's layout, when the layout is split into several
+    // cores. The band-passes are detuned by the index in the whole layout.
+    void setFirstChannel (int first_channel);
+
+    void setParameter (int index, float value);
+    float getParameter (int index) const { return values_[static_cast<size_t> (index)]; }
+    int getLatencySamples() const { return juce::roundToInt (oversampler_.getLatencySamples()); }
+
+    // Processes num_channels planar channels in place, num_samples at most the max_block_size
+    // of prepare(). Runs through all stages one micro block at a time, see StageChain.
+    void process (float* const* channels, int num_channels, int num_samples);
+
+private:
+    // The oversampled part of the chain
+    void compressOversampled (float* const* channels, int num_channels, int num_samples, float treshold);
+    void updateFilters (float frequency);
+
+    std::array<float, NUM_PARAMETERS> values_ {};
+    double sample_rate_ = 44100.0;
+    int num_channels_ = 0;
+    int first_channel_ = 0;
+
+    Oversampler oversampler_;
+    DualMono dual_mono_;
+    MultiChannelBiquad band_pass_;
+    float band_pass_frequency_ = 0.0f;
+    juce::dsp::Chorus<float> chorus_;
+    juce::dsp::DryWetMixer<float> mix_ { 64 };
+    // Channel pointers of the micro block the stages run on, see StageChain
+    std::vector<float*> micro_channels_;
+};
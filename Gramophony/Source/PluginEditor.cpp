@@ -13,7 +13,7 @@ constexpr float LINE_THICKNESS = 4.0f;
 
 //==============================================================================
 GramophonyAudioProcessorEditor::GramophonyAudioProcessorEditor (GramophonyAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p), info_button_ (juce::Colours::darkgrey)
+    : AudioProcessorEditor (&p), audioProcessor (p), info_button_ (juce::Colours::darkgrey), governor_display_ (p.getGovernor(), juce::Colour (0xff123456))
 {
     constexpr int TEXT_BOX_SIZE = 25;
 
@@ -52,6 +52,8 @@ GramophonyAudioProcessorEditor::GramophonyAudioProcessorEditor (GramophonyAudioP
 
     mix_slider_attachment_ = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (audioProcessor.apvts, "MIX", mix_slider_);
 
+    addAndMakeVisible (governor_display_);
+
     info_button_.addToEditor (this);
     setSize (500, 300);
 }
@@ -160,6 +162,7 @@ void GramophonyAudioProcessorEditor::resized()
 {
     info_button_.button.setBounds (getWidth() - 35, 10, 20, 20);
     info_button_.info_text.setBounds (30, 50, getWidth() - 60, getHeight() - 100);
+    governor_display_.setBounds (10, getHeight() - 25, 200, 20);
     SetupSections();
     compress_slider_.setBounds (comp_section_);
     tone_slider_.setBounds (tone_section_);
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "PluginProcessor.h"
+#include <CpuGovernorDisplay.h>
 #include <InfoButton.h>
 #include <JuceHeader.h>
 
@@ -33,6 +34,7 @@ private:
     void sliderValueChanged (juce::Slider* slider) override;
 
     InfoButton info_button_;
+    CpuGovernorDisplay governor_display_;
 
     typedef std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> SliderAttatchmentPtr;
 
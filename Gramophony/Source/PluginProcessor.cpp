@@ -9,6 +9,9 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+// Parameters stored in presets, in the order of the Parameter enum.
+const juce::StringArray PARAMETER_IDS { "COMPRESS", "VIBRATO", "VIBRATO_RATE", "TONE", "MIX" };
+
 constexpr float BP_FREQ = 2950.0f;
 
 //==============================================================================
@@ -22,13 +25,29 @@ GramophonyAudioProcessor::GramophonyAudioProcessor()
                           .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
 #endif
                           ),
-      apvts (*this, nullptr, "Parameters", createParameters())
+      apvts (*this, nullptr, "Parameters", createParameters()),
+      program_switcher_ (apvts, PARAMETER_IDS)
 #endif
 {
+    // A bank file next to the other plugin data replaces the factory presets.
+    if (! program_switcher_.getBank().loadFromFile (PresetBank::getDefaultBankFile()))
+    {
+        addFactoryPresets();
+    }
+
+    apvts.addParameterListener ("OVERSAMPLING", this);
+    apvts.addParameterListener ("OVERSAMPLING_FILTER", this);
+    apvts.addParameterListener ("PARALLEL", this);
+    apvts.addParameterListener ("OFFLINE_OVERSAMPLING", this);
 }
 
 GramophonyAudioProcessor::~GramophonyAudioProcessor()
 {
+    apvts.removeParameterListener ("OVERSAMPLING", this);
+    apvts.removeParameterListener ("OVERSAMPLING_FILTER", this);
+    apvts.removeParameterListener ("PARALLEL", this);
+    apvts.removeParameterListener ("OFFLINE_OVERSAMPLING", this);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -71,26 +90,28 @@ double GramophonyAudioProcessor::getTailLengthSeconds() const
 
 int GramophonyAudioProcessor::getNumPrograms()
 {
-    return 1; // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    return program_switcher_.getNumPrograms(); // NB: some hosts don't cope very well if you tell them there are 0 programs,
         // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int GramophonyAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return program_switcher_.getCurrentProgram();
 }
 
-void GramophonyAudioProcessor::setCurrentProgram (int /*index*/)
+void GramophonyAudioProcessor::setCurrentProgram (int index)
 {
+    program_switcher_.setCurrentProgram (index);
 }
 
-const juce::String GramophonyAudioProcessor::getProgramName (int /*index*/)
+const juce::String GramophonyAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return program_switcher_.getProgramName (index);
 }
 
-void GramophonyAudioProcessor::changeProgramName (int /*index*/, const juce::String& /*newName*/)
+void GramophonyAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    program_switcher_.changeProgramName (index, newName);
 }
 
 //==============================================================================
@@ -101,22 +122,34 @@ void GramophonyAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
     juce::dsp::ProcessSpec spec = { sampleRate, static_cast<juce::uint32>(samplesPerBlock), 
                                     static_cast<juce::uint32>(getMainBusNumOutputChannels()) };
 
+    program_switcher_.prepare (sampleRate);
+    treshold_.reset (sampleRate, ProgramSwitcher::CROSSFADE_SECONDS);
+    treshold_.setCurrentAndTargetValue (apvts.getRawParameterValue ("COMPRESS")->load());
+    tresholds_.resize (static_cast<size_t> (juce::jmax (1, (samplesPerBlock + MicroBlocks::SIZE - 1) / MicroBlocks::SIZE)));
+    segment_channels_.resize (static_cast<size_t> (juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels())));
+
     chorus_.prepare (spec);
 
     mix_.prepare (spec);
+    offline_ = isNonRealtime();
+    prepareOversampler (samplesPerBlock);
+    prepareWorkers();
+    dual_mono_.reset();
 
-    float frequency = apvts.getRawParameterValue ("TONE")->load();
-    filter_ch1_.prepare (spec);
-    filter_ch1_.coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass (sampleRate, frequency, 6.0f);
-
-    filter_ch2_.prepare (spec);
-    filter_ch2_.coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass (sampleRate, frequency, 6.0f);
+    for (int group = 0; group < static_cast<int> (groups_.size()); ++group)
+    {
+        const int group_channels = juce::jlimit (1, CHANNELS_PER_GROUP, static_cast<int> (spec.numChannels) - group * CHANNELS_PER_GROUP);
+        groups_[static_cast<size_t> (group)].band_pass.prepare (group_channels);
+    }
+    updateFilters (apvts.getRawParameterValue ("TONE")->load());
 }
 
 void GramophonyAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    // Idle workers spin for a while, so do not keep them around without playback
+    workers_.setNumWorkers (0);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -126,10 +159,8 @@ bool GramophonyAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
     juce::ignoreUnused (layouts);
     return true;
 #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout is supported, every channel gets its own filter state.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
         // This checks if the input layout matches the output layout
@@ -146,6 +177,7 @@ bool GramophonyAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 void GramophonyAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& /*midiMessages*/)
 {
     juce::ScopedNoDenormals noDenormals;
+    juce::AudioProcessLoadMeasurer::ScopedTimer timer (governor_.getLoadMeasurer(), buffer.getNumSamples());
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -160,52 +192,254 @@ void GramophonyAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
         buffer.clear (i, 0, buffer.getNumSamples());
     }
 
-    mix_.pushDrySamples (buffer);
+    // Hosts may start or stop rendering offline without preparing again
+    if (isNonRealtime() != offline_.load())
+        switchTier (isNonRealtime());
+
+    // Bounces have no deadline to keep
+    governor_.setEnabled (apvts.getRawParameterValue ("GOVERNOR")->load() > 0.5f && ! isNonRealtime());
+    dual_mono_.setEnabled (apvts.getRawParameterValue ("DUAL_MONO")->load() > 0.5f);
+    const int governor_level = governor_.update (buffer.getNumSamples());
+    if (governor_level != governor_level_)
+        applyGovernorLevel (governor_level);
 
-    for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+    // A program crossfade hands out its values in short steps, see ProgramSwitcher
+    ParameterValues values;
+    for (int first_sample = 0; first_sample < buffer.getNumSamples();)
     {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
-        {
-            // TODO: make this value tweakable.
-            float treshold = apvts.getRawParameterValue ("COMPRESS")->load();
-            float frequency = apvts.getRawParameterValue ("TONE")->load();
-
-            if (*buffer.getReadPointer (channel, sample) >= treshold)
-            {
-                *buffer.getWritePointer (channel, sample) = (*buffer.getReadPointer (channel, sample) / 4) + (3 * treshold / 4);
-            }
-            else if (*buffer.getReadPointer (channel, sample) <= -treshold)
-            {
-                *buffer.getWritePointer (channel, sample) = (*buffer.getReadPointer (channel, sample) / 4) - (3 * treshold / 4);
-            }
-            // Partly calculated partly by ear set makeup gain.
-            *buffer.getWritePointer (channel, sample) *= 5.0f - (11.0f * treshold * treshold);
-
-            if (channel == 0)
-            {
-                filter_ch1_.coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass (getSampleRate(), frequency + 10.0f, 2.7f);
-                *buffer.getWritePointer (channel, sample) = filter_ch1_.processSample (*buffer.getReadPointer (channel, sample));
-            }
-            else if (channel == 1)
-            {
-                filter_ch2_.coefficients = juce::dsp::IIR::Coefficients<float>::makeBandPass (getSampleRate(), frequency - 10.0f, 2.73f);
-                *buffer.getWritePointer (channel, sample) = filter_ch2_.processSample (*buffer.getReadPointer (channel, sample));
-            }
-        }
+        const int max_samples = juce::jmin (buffer.getNumSamples() - first_sample, static_cast<int> (tresholds_.size()) * MicroBlocks::SIZE);
+        const int num_samples = program_switcher_.readParameters (values, max_samples);
+
+        const int num_buffer_channels = juce::jmin (buffer.getNumChannels(), static_cast<int> (segment_channels_.size()));
+        for (int channel = 0; channel < num_buffer_channels; ++channel)
+            segment_channels_[static_cast<size_t> (channel)] = buffer.getWritePointer (channel, first_sample);
+
+        processSegment (segment_channels_.data(), num_buffer_channels, num_samples, values, totalNumInputChannels);
+        first_sample += num_samples;
+    }
+}
+
+void GramophonyAudioProcessor::processSegment (float* const* channels, int num_buffer_channels, int num_samples, const ParameterValues& values, int num_channels)
+{
+    const float frequency = values[TONE];
+    if (frequency != band_pass_frequency_)
+    {
+        updateFilters (frequency);
     }
-    auto block = juce::dsp::AudioBlock<float> (buffer);
-    auto contextToUse = juce::dsp::ProcessContextReplacing<float> (block);
 
-    chorus_.setRate (apvts.getRawParameterValue ("VIBRATO_RATE")->load());
-    chorus_.setDepth (apvts.getRawParameterValue ("VIBRATO")->load());
+    // The compressor glides to a new treshold one micro block at a time, so moving it does not
+    // zipper. The groups all read the same tresholds.
+    treshold_.setTargetValue (values[COMPRESS]);
+    for (int first_sample = 0; first_sample < num_samples; first_sample += MicroBlocks::SIZE)
+        tresholds_[static_cast<size_t> (first_sample / MicroBlocks::SIZE)] = treshold_.skip (juce::jmin (MicroBlocks::SIZE, num_samples - first_sample));
+
+    chorus_.setRate (values[VIBRATO_RATE]);
+    chorus_.setDepth (values[VIBRATO]);
     chorus_.setCentreDelay (1.0f);
     chorus_.setFeedback (0.0f);
     chorus_.setMix (1.0f);
 
-    chorus_.process (contextToUse);
+    mix_.setWetMixProportion (1.0f - values[MIX]);
+
+    // Compressor and band-pass keep their state per channel, so groups of channels can go to
+    // the workers. The chorus shares its LFO between all channels and stays on this thread.
+    const int num_groups = (num_channels + CHANNELS_PER_GROUP - 1) / CHANNELS_PER_GROUP;
+    const bool parallel = workers_.getNumWorkers() > 0 && num_groups > 1 && num_samples * groups_.front().oversamplers[getTier()].getFactor() >= MIN_PARALLEL_FRAMES;
+
+    auto process_samples = [&] (int first_sample, int micro_samples) {
+        // AudioBlocks refer to the channel pointers without copying them
+        auto block = juce::dsp::AudioBlock<float> (channels, static_cast<size_t> (num_buffer_channels), static_cast<size_t> (first_sample), static_cast<size_t> (micro_samples));
+        auto process_group = [&] (int group) { processGroup (group, channels, first_sample, micro_samples, num_channels); };
+
+        mix_.pushDrySamples (block);
+
+        if (parallel)
+        {
+            workers_.run (num_groups, process_group);
+        }
+        else
+        {
+            for (int group = 0; group < num_groups; ++group)
+                process_group (group);
+        }
+
+        auto contextToUse = juce::dsp::ProcessContextReplacing<float> (block);
+        chorus_.process (contextToUse);
+
+        mix_.mixWetSamples (block);
+    };
 
-    mix_.setWetMixProportion (1.0f - apvts.getRawParameterValue ("MIX")->load());
-    mix_.mixWetSamples (block);
+    // Every stage runs on one micro block before the next one starts, see MicroBlocks. Waking
+    // the workers is only worth it once per host block, they go through their groups in micro
+    // blocks themselves.
+    if (parallel)
+        process_samples (0, num_samples);
+    else
+        MicroBlocks::forEach (num_samples, process_samples);
+}
+
+void GramophonyAudioProcessor::processGroup (int group, float* const* channels, int first_sample, int num_samples, int num_channels)
+{
+    const int first_channel = group * CHANNELS_PER_GROUP;
+    const int group_channels = juce::jmin (CHANNELS_PER_GROUP, num_channels - first_channel);
+    auto& channel_group = groups_[static_cast<size_t> (group)];
+    auto& oversampler = channel_group.oversamplers[getTier()];
+
+    MicroBlocks::forEach (num_samples, [&] (int micro_first_sample, int micro_samples) {
+        // Only the compressor creates harmonics, so it is the only stage that runs oversampled.
+        // Every group has its own pointers, the workers run groups at the same time.
+        std::array<float*, CHANNELS_PER_GROUP> micro_channels {};
+        for (int channel = 0; channel < group_channels; ++channel)
+            micro_channels[static_cast<size_t> (channel)] = channels[first_channel + channel] + first_sample + micro_first_sample;
+
+        // A mono source on a stereo track compresses to the same thing on both channels. The
+        // band-pass is detuned per channel, so it always runs on every one of them.
+        int num_compressed = group_channels;
+        const auto get_difference = [&] { return oversampler.getStateDifference (group_channels); };
+        const auto copy_state = [&] { oversampler.copyFirstChannelState (group_channels); };
+        if (num_channels <= CHANNELS_PER_GROUP && dual_mono_.update (micro_channels.data(), group_channels, micro_samples, get_difference, copy_state))
+            num_compressed = 1;
+
+        const float treshold = tresholds_[static_cast<size_t> ((first_sample + micro_first_sample) / MicroBlocks::SIZE)];
+        oversampler.process (micro_channels.data(), num_compressed, micro_samples, [treshold] (juce::dsp::AudioBlock<float>& block, int /*first_sample*/) { GramophonyCore::compress (block, treshold); });
+
+        if (num_compressed < group_channels)
+            DualMono::copyFirstChannel (micro_channels.data(), group_channels, micro_samples);
+
+        channel_group.band_pass.process (micro_channels.data(), group_channels, micro_samples);
+    });
+}
+
+void GramophonyAudioProcessor::updateFilters (float frequency)
+{
+    // Detuned by the channel index in the whole layout, not in the group
+    for (size_t group = 0; group < groups_.size(); ++group)
+    {
+        auto& band_pass = groups_[group].band_pass;
+
+        for (int channel = 0; channel < band_pass.getNumChannels(); ++channel)
+            band_pass.setCoefficients (channel, GramophonyCore::makeBandPass (getSampleRate(), frequency, static_cast<int> (group) * CHANNELS_PER_GROUP + channel));
+    }
+    band_pass_frequency_ = frequency;
+}
+
+int GramophonyAudioProcessor::getOversamplingFactor (Tier tier) const
+{
+    const auto factor = 1 << static_cast<int> (apvts.getRawParameterValue ("OVERSAMPLING")->load());
+    const auto offline_choice = static_cast<int> (apvts.getRawParameterValue ("OFFLINE_OVERSAMPLING")->load());
+
+    // Bounces never compress with less oversampling than playback
+    if (tier == OFFLINE && offline_choice > 0)
+        return juce::jmax (factor, 1 << offline_choice);
+    return factor;
+}
+
+void GramophonyAudioProcessor::prepareOversampler (int samples_per_block)
+{
+    const auto filter_type = static_cast<Oversampler::FilterType> (static_cast<int> (apvts.getRawParameterValue ("OVERSAMPLING_FILTER")->load()));
+
+    const int num_channels = getMainBusNumOutputChannels();
+    const int num_groups = juce::jmax (1, (num_channels + CHANNELS_PER_GROUP - 1) / CHANNELS_PER_GROUP);
+    groups_.resize (static_cast<size_t> (num_groups));
+    for (int group = 0; group < num_groups; ++group)
+    {
+        const int group_channels = juce::jlimit (1, CHANNELS_PER_GROUP, num_channels - group * CHANNELS_PER_GROUP);
+
+        for (int tier = 0; tier < NUM_TIERS; ++tier)
+            groups_[static_cast<size_t> (group)].oversamplers[static_cast<size_t> (tier)].prepare (group_channels, MicroBlocks::getScratchSize (samples_per_block), getOversamplingFactor (static_cast<Tier> (tier)), filter_type);
+    }
+
+    // All groups use the same filters, so they share the latency
+    const float latency = groups_.front().oversamplers[getTier()].getLatencySamples();
+    mix_.setWetLatency (latency);
+    setLatencySamples (juce::roundToInt (latency));
+
+    // Every halving of the oversampling is one level, the next block applies the level again
+    const int num_levels = 1 + juce::roundToInt (std::log2 (groups_.front().oversamplers[REALTIME].getPreparedFactor()));
+    governor_.prepare (getSampleRate(), samples_per_block, num_levels);
+    governor_level_ = 0;
+}
+
+bool GramophonyAudioProcessor::isOversamplerPrepared() const
+{
+    const auto filter_type = static_cast<Oversampler::FilterType> (static_cast<int> (apvts.getRawParameterValue ("OVERSAMPLING_FILTER")->load()));
+
+    for (int tier = 0; tier < NUM_TIERS; ++tier)
+    {
+        const auto& oversampler = groups_.front().oversamplers[static_cast<size_t> (tier)];
+        if (oversampler.getPreparedFactor() != getOversamplingFactor (static_cast<Tier> (tier)) || oversampler.getFilterType() != filter_type)
+            return false;
+    }
+    return true;
+}
+
+void GramophonyAudioProcessor::switchTier (bool offline)
+{
+    offline_ = offline;
+
+    // The filters may still hold the signal of their last use
+    for (auto& group : groups_)
+        group.oversamplers[getTier()].reset();
+
+    mix_.setWetLatency (groups_.front().oversamplers[getTier()].getLatencySamples());
+
+    // The host is told about the new latency from the message thread
+    triggerAsyncUpdate();
+}
+
+void GramophonyAudioProcessor::applyGovernorLevel (int level)
+{
+    governor_level_ = level;
+
+    // Only playback has a deadline, the offline filters always run at their full factor
+    for (auto& group : groups_)
+    {
+        auto& oversampler = group.oversamplers[REALTIME];
+        oversampler.setActiveFactor (oversampler.getPreparedFactor() >> level);
+    }
+
+    mix_.setWetLatency (groups_.front().oversamplers[getTier()].getLatencySamples());
+
+    // The host is told about the new latency from the message thread
+    triggerAsyncUpdate();
+}
+
+int GramophonyAudioProcessor::getNumWorkersToRun() const
+{
+    // The audio thread takes one group itself, more workers than cores would only compete
+    const bool parallel = apvts.getRawParameterValue ("PARALLEL")->load() > 0.5f;
+    const int num_groups = static_cast<int> (groups_.size());
+    return parallel ? juce::jmin (num_groups - 1, juce::SystemStats::getNumCpus() - 1, MAX_WORKERS) : 0;
+}
+
+void GramophonyAudioProcessor::prepareWorkers()
+{
+    workers_.setNumWorkers (getNumWorkersToRun());
+}
+
+void GramophonyAudioProcessor::parameterChanged (const juce::String& /*parameter_id*/, float /*new_value*/)
+{
+    // Called from whatever thread changed the parameter, the reconfiguration happens later
+    triggerAsyncUpdate();
+}
+
+void GramophonyAudioProcessor::handleAsyncUpdate()
+{
+    if (getSampleRate() <= 0.0)
+        return;
+
+    if (isOversamplerPrepared() && workers_.getNumWorkers() == getNumWorkersToRun())
+    {
+        // Only the tier or the governor level changed, the audio thread has already switched filters
+        setLatencySamples (juce::roundToInt (groups_.front().oversamplers[getTier()].getLatencySamples()));
+        return;
+    }
+
+    // Other filters change the latency, so hold the audio callback while they are set up.
+    suspendProcessing (true);
+    prepareOversampler (getBlockSize());
+    prepareWorkers();
+    suspendProcessing (false);
 }
 
 //==============================================================================
@@ -245,14 +479,53 @@ juce::AudioProcessorValueTreeState::ParameterLayout GramophonyAudioProcessor::cr
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
 
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("COMPRESS", "Compress", 0.04f, 0.45f, 0.1f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("VIBRATO", "Vibrato", 0.0f, 0.33f, 0.01f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("VIBRATO_RATE", "Rate", 0.5f, 4.0f, 2.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("TONE", "Tone", 320.1f, 4700.0f, 2000.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("MIX", "Mix", 0.0f, 0.5f, 0.0f));
+    // The parameters of the core first, the oversampling ones are quality settings and not
+    // part of presets. Then the ones only the plugin has.
+    CoreParameterLayout::addParameters (parameters, GramophonyCore::PARAMETERS);
+    // Oversampling while rendering offline, never less than the one above
+    parameters.push_back (std::make_unique<juce::AudioParameterChoice> ("OFFLINE_OVERSAMPLING", "Offline oversampling", juce::StringArray { "Same as realtime", "2x", "4x", "8x" }, 3));
+    // Compresses and filters groups of channels on worker threads, only pays off for wide layouts
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("PARALLEL", "Parallel channels", false));
+    // Lowers the oversampling when processing gets close to the buffer deadline
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("GOVERNOR", "CPU governor", false));
+    // Off only to compare the output without the shortcut, see DualMono
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("DUAL_MONO", "Mono shortcut", true));
     return { parameters.begin(), parameters.end() };
 }
 
+void GramophonyAudioProcessor::addFactoryPresets()
+{
+    auto& bank = program_switcher_.getBank();
+
+    juce::StringPairArray horn;
+    horn.set ("COMPRESS", "0.1");
+    horn.set ("VIBRATO", "0.01");
+    horn.set ("VIBRATO_RATE", "2.0");
+    horn.set ("TONE", "2000.0");
+    bank.addPreset ("Horn", horn);
+
+    juce::StringPairArray worn_record;
+    worn_record.set ("COMPRESS", "0.06");
+    worn_record.set ("VIBRATO", "0.12");
+    worn_record.set ("VIBRATO_RATE", "0.8");
+    worn_record.set ("TONE", "1400.0");
+    bank.addPreset ("Worn Record", worn_record);
+
+    juce::StringPairArray telephone;
+    telephone.set ("COMPRESS", "0.2");
+    telephone.set ("VIBRATO", "0.0");
+    telephone.set ("TONE", "3200.0");
+    bank.addPreset ("Telephone", telephone);
+
+    juce::StringPairArray warble;
+    warble.set ("COMPRESS", "0.15");
+    warble.set ("VIBRATO", "0.33");
+    warble.set ("VIBRATO_RATE", "3.5");
+    warble.set ("TONE", "2600.0");
+    warble.set ("MIX", "0.2");
+    bank.addPreset ("Warble", warble);
+}
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
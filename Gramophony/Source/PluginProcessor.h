@@ -8,12 +8,23 @@
 
 #pragma once
 
+#include "GramophonyCore.h"
+#include <CoreParameterLayout.h>
+#include <CpuGovernor.h>
+#include <DualMono.h>
 #include <JuceHeader.h>
+#include <MicroBlocks.h>
+#include <MultiChannelBiquad.h>
+#include <Oversampler.h>
+#include <PresetBank.h>
+#include <WorkerPool.h>
 
 //==============================================================================
 /**
 */
-class GramophonyAudioProcessor : public juce::AudioProcessor
+class GramophonyAudioProcessor : public juce::AudioProcessor,
+                                  private juce::AudioProcessorValueTreeState::Listener,
+                                  private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -55,13 +66,84 @@ public:
 
     juce::AudioProcessorValueTreeState apvts;
 
+    // Load and quality level of the opt-in CPU governor, every level halves the oversampling
+    const CpuGovernor& getGovernor() const { return governor_; }
+
 private:
-    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+    // Parameters that make up a preset, in the order of the ids in PARAMETER_IDS
+    enum Parameter
+    {
+        COMPRESS = 0,
+        VIBRATO,
+        VIBRATO_RATE,
+        TONE,
+        MIX,
+        NUM_PARAMETERS
+    };
 
+    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+    void addFactoryPresets();
+
+    ProgramSwitcher program_switcher_;
+
+    // Channels compressed and filtered together by one job, their filters run them side by side
+    static constexpr int CHANNELS_PER_GROUP = 4;
+    static constexpr int MAX_WORKERS = 7;
+    // Oversampled frames below which the workers cost more than they save
+    static constexpr int MIN_PARALLEL_FRAMES = 512;
+
+    // Playback compresses at the oversampling of the quality parameters, bounces may
+    // oversample more. Both are prepared up front, so switching when the host starts or stops
+    // rendering offline never allocates.
+    enum Tier
+    {
+        REALTIME = 0,
+        OFFLINE,
+        NUM_TIERS
+    };
+
+    // The stages of a group of channels that keep per instance state
+    struct ChannelGroup
+    {
+        std::array<Oversampler, NUM_TIERS> oversamplers;
+        MultiChannelBiquad band_pass;
+    };
+
+    // Audio thread: processes part of a host block with one set of parameter values
+    void processSegment (float* const* channels, int num_buffer_channels, int num_samples, const ParameterValues& values, int num_channels);
+    // Audio thread or a worker: compresses and filters the channels of a group, micro block by
+    // micro block
+    void processGroup (int group, float* const* channels, int first_sample, int num_samples, int num_channels);
+    void updateFilters (float frequency);
+    int getOversamplingFactor (Tier tier) const;
+    Tier getTier() const { return offline_.load() ? OFFLINE : REALTIME; }
+    void prepareOversampler (int samples_per_block);
+    bool isOversamplerPrepared() const;
+    void switchTier (bool offline);
+    void applyGovernorLevel (int level);
+    int getNumWorkersToRun() const;
+    void prepareWorkers();
+    void parameterChanged (const juce::String& parameter_id, float new_value) override;
+    void handleAsyncUpdate() override;
+
+    std::vector<ChannelGroup> groups_;
+    WorkerPool workers_;
+    // Compresses one channel for all of them while the input is the same on every channel,
+    // only with a single group of channels
+    DualMono dual_mono_;
+    // Set on the audio thread from isNonRealtime(), read when reporting the latency
+    std::atomic<bool> offline_ { false };
+
+    CpuGovernor governor_;
+    int governor_level_ = 0;
     juce::dsp::Chorus<float> chorus_;
-    juce::dsp::IIR::Filter<float> filter_ch1_;
-    juce::dsp::IIR::Filter<float> filter_ch2_;
-    juce::dsp::DryWetMixer<float> mix_;
+    float band_pass_frequency_ = 0.0f;
+    juce::dsp::DryWetMixer<float> mix_ { 64 };
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> treshold_;
+    // Treshold of every micro block of a segment
+    std::vector<float> tresholds_;
+    // The host buffer's channels from the start of the current segment
+    std::vector<float*> segment_channels_;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GramophonyAudioProcessor)
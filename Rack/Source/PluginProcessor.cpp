@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+
+//==============================================================================
+RackAudioProcessor::RackAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+    : AudioProcessor (BusesProperties()
+#if ! JucePlugin_IsMidiEffect
+#if ! JucePlugin_IsSynth
+                          .withInput ("Input", juce::AudioChannelSet::stereo(), true)
+#endif
+                          .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+#endif
+                          ),
+      apvts (*this, nullptr, "Parameters", createParameters())
+#endif
+{
+    for (int index = 0; index < RackCore::NUM_PARAMETERS; ++index)
+    {
+        const auto id = RackCore::getParameterId (index);
+        values_[static_cast<size_t> (index)] = apvts.getRawParameterValue (id);
+
+        // Quality settings of the cores take effect when they are prepared again
+        if (RackCore::getParameterInfo (index).needs_prepare)
+            apvts.addParameterListener (id, this);
+    }
+}
+
+RackAudioProcessor::~RackAudioProcessor()
+{
+    for (int index = 0; index < RackCore::NUM_PARAMETERS; ++index)
+    {
+        if (RackCore::getParameterInfo (index).needs_prepare)
+            apvts.removeParameterListener (RackCore::getParameterId (index), this);
+    }
+    cancelPendingUpdate();
+}
+
+//==============================================================================
+const juce::String RackAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool RackAudioProcessor::acceptsMidi() const
+{
+#if JucePlugin_WantsMidiInput
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool RackAudioProcessor::producesMidi() const
+{
+#if JucePlugin_ProducesMidiOutput
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool RackAudioProcessor::isMidiEffect() const
+{
+#if JucePlugin_IsMidiEffect
+    return true;
+#else
+    return false;
+#endif
+}
+
+double RackAudioProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+int RackAudioProcessor::getNumPrograms()
+{
+    return 1; // NB: some hosts don't cope very well if you tell them there are 0 programs,
+        // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int RackAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void RackAudioProcessor::setCurrentProgram (int /*index*/)
+{
+}
+
+const juce::String RackAudioProcessor::getProgramName (int /*index*/)
+{
+    return {};
+}
+
+void RackAudioProcessor::changeProgramName (int /*index*/, const juce::String& /*newName*/)
+{
+}
+
+//==============================================================================
+void RackAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // Use this method as the place to do any pre-playback
+    // initialisation that you need..
+    readParameters();
+    core_.prepare (sampleRate, samplesPerBlock, getMainBusNumOutputChannels());
+    setLatencySamples (core_.getLatencySamples());
+}
+
+void RackAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool RackAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+#if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+#else
+    // Any layout is supported, the cores keep state for every channel.
+    if (layouts.getMainOutputChannelSet().isDisabled())
+        return false;
+
+        // This checks if the input layout matches the output layout
+#if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+#endif
+
+    return true;
+#endif
+}
+#endif
+
+void RackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& /*midiMessages*/)
+{
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+    {
+        buffer.clear (i, 0, buffer.getNumSamples());
+    }
+
+    readParameters();
+
+    // All three cores run in place on the host buffer, one micro block at a time
+    const int num_channels = juce::jmin (buffer.getNumChannels(), getMainBusNumOutputChannels());
+    core_.process (buffer.getArrayOfWritePointers(), num_channels, buffer.getNumSamples());
+}
+
+void RackAudioProcessor::readParameters()
+{
+    for (int index = 0; index < RackCore::NUM_PARAMETERS; ++index)
+        core_.setParameter (index, values_[static_cast<size_t> (index)]->load());
+}
+
+void RackAudioProcessor::parameterChanged (const juce::String& /*parameter_id*/, float /*new_value*/)
+{
+    // Called from whatever thread changed the parameter, the reconfiguration happens later
+    triggerAsyncUpdate();
+}
+
+void RackAudioProcessor::handleAsyncUpdate()
+{
+    if (getSampleRate() <= 0.0)
+        return;
+
+    // The new oversampling or eco changes the latency, so hold the audio callback while the
+    // cores are set up.
+    suspendProcessing (true);
+    readParameters();
+    core_.prepare (getSampleRate(), getBlockSize(), getMainBusNumOutputChannels());
+    setLatencySamples (core_.getLatencySamples());
+    suspendProcessing (false);
+}
+
+//==============================================================================
+bool RackAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* RackAudioProcessor::createEditor()
+{
+    // Sliders and menus for all parameters of the three cores
+    return new juce::GenericAudioProcessorEditor (*this);
+}
+
+//==============================================================================
+void RackAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // You should use this method to store your parameters in the memory block.
+    // You could do that either as raw data, or use the XML or ValueTree classes
+    // as intermediaries to make it easy to save and load complex data.
+    auto state = apvts.copyState();
+    std::unique_ptr<juce::XmlElement> xml (state.createXml());
+    copyXmlToBinary (*xml, destData);
+}
+
+void RackAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // You should use this method to restore your parameters from this memory block,
+    // whose contents will have been created by the getStateInformation() call.
+    std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary (data, sizeInBytes));
+
+    if (xmlState.get() != nullptr)
+        if (xmlState->hasTagName (apvts.state.getType()))
+            apvts.replaceState (juce::ValueTree::fromXml (*xmlState));
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout RackAudioProcessor::createParameters()
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
+
+    parameters.push_back (std::make_unique<juce::AudioParameterChoice> (RackCore::getParameterId (RackCore::ORDER), RackCore::ORDER_PARAMETER.name, RackCore::ORDER_NAMES, 0));
+
+    // The ranges of the cores, choices and counts only stop at whole numbers
+    for (int index = RackCore::ORDER + 1; index < RackCore::NUM_PARAMETERS; ++index)
+    {
+        const auto& info = RackCore::getParameterInfo (index);
+        const juce::NormalisableRange<float> range (info.min_value, info.max_value, info.is_stepped ? 1.0f : 0.0f);
+        parameters.push_back (std::make_unique<juce::AudioParameterFloat> (RackCore::getParameterId (index), info.name, range, info.default_value));
+    }
+    return { parameters.begin(), parameters.end() };
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new RackAudioProcessor();
+}
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    RackCore.cpp
+    Created: 19 Oct 2026 2:37:12pm
+
+  ==============================================================================
+*/
+
+#include "RackCore.h"
+
+namespace
+{
+    // The stages of each entry of ORDER_NAMES, first to last
+    const RackCore::Stage ORDERS[][RackCore::NUM_STAGES] = {
+        { RackCore::GRAMOPHONY, RackCore::WAVEFOLDER, RackCore::EASYVERB },
+        { RackCore::WAVEFOLDER, RackCore::GRAMOPHONY, RackCore::EASYVERB },
+        { RackCore::GRAMOPHONY, RackCore::EASYVERB, RackCore::WAVEFOLDER },
+        { RackCore::WAVEFOLDER, RackCore::EASYVERB, RackCore::GRAMOPHONY },
+        { RackCore::EASYVERB, RackCore::GRAMOPHONY, RackCore::WAVEFOLDER },
+        { RackCore::EASYVERB, RackCore::WAVEFOLDER, RackCore::GRAMOPHONY },
+    };
+
+    const char* const PREFIXES[RackCore::NUM_STAGES] = { "GRAMOPHONY_", "WAVEFOLDER_", "EASYVERB_" };
+}
+
+const juce::StringArray RackCore::ORDER_NAMES {
+    "Gramophony > WaveFolder > Easyverb",
+    "WaveFolder > Gramophony > Easyverb",
+    "Gramophony > Easyverb > WaveFolder",
+    "WaveFolder > Easyverb > Gramophony",
+    "Easyverb > Gramophony > WaveFolder",
+    "Easyverb > WaveFolder > Gramophony",
+};
+
+const CoreParameter RackCore::ORDER_PARAMETER = { "ORDER", "Order", 0.0f, static_cast<float> (std::size (ORDERS) - 1), 0.0f, true };
+
+const CoreParameter& RackCore::getParameterInfo (int index)
+{
+    jassert (index >= 0 && index < NUM_PARAMETERS);
+
+    if (index >= getFirstParameter (EASYVERB))
+        return EasyverbCore::PARAMETERS[index - getFirstParameter (EASYVERB)];
+    if (index >= getFirstParameter (WAVEFOLDER))
+        return WaveFolderCore::PARAMETERS[index - getFirstParameter (WAVEFOLDER)];
+    if (index >= getFirstParameter (GRAMOPHONY))
+        return GramophonyCore::PARAMETERS[index - getFirstParameter (GRAMOPHONY)];
+    return ORDER_PARAMETER;
+}
+
+juce::String RackCore::getParameterId (int index)
+{
+    for (int stage = NUM_STAGES - 1; stage >= 0; --stage)
+    {
+        if (index >= getFirstParameter (static_cast<Stage> (stage)))
+            return PREFIXES[stage] + juce::String (getParameterInfo (index).id);
+    }
+    return ORDER_PARAMETER.id;
+}
+
+int RackCore::getFirstParameter (Stage stage)
+{
+    switch (stage)
+    {
+        case GRAMOPHONY:
+            return 1;
+        case WAVEFOLDER:
+            return 1 + GramophonyCore::NUM_PARAMETERS;
+        case EASYVERB:
+        default:
+            return 1 + GramophonyCore::NUM_PARAMETERS + WaveFolderCore::NUM_PARAMETERS;
+    }
+}
+
+RackCore::RackCore()
+    : order_ (ORDER_PARAMETER.default_value)
+{
+}
+
+void RackCore::prepare (double sample_rate, int max_block_size, int num_channels)
+{
+    num_channels_ = num_channels;
+    micro_channels_.resize (static_cast<size_t> (num_channels));
+
+    const int scratch_size = MicroBlocks::getScratchSize (max_block_size);
+    gramophony_.prepare (sample_rate, scratch_size, num_channels);
+    wavefolder_.prepare (sample_rate, scratch_size, num_channels);
+    easyverb_.prepare (sample_rate, scratch_size, num_channels);
+}
+
+void RackCore::reset()
+{
+    gramophony_.reset();
+    wavefolder_.reset();
+    easyverb_.reset();
+}
+
+void RackCore::setParameter (int index, float value)
+{
+    if (index >= getFirstParameter (EASYVERB))
+        easyverb_.setParameter (index - getFirstParameter (EASYVERB), value);
+    else if (index >= getFirstParameter (WAVEFOLDER))
+        wavefolder_.setParameter (index - getFirstParameter (WAVEFOLDER), value);
+    else if (index >= getFirstParameter (GRAMOPHONY))
+        gramophony_.setParameter (index - getFirstParameter (GRAMOPHONY), value);
+    else if (index == ORDER)
+        order_ = juce::jlimit (ORDER_PARAMETER.min_value, ORDER_PARAMETER.max_value, value);
+}
+
+float RackCore::getParameter (int index) const
+{
+    if (index >= getFirstParameter (EASYVERB))
+        return easyverb_.getParameter (index - getFirstParameter (EASYVERB));
+    if (index >= getFirstParameter (WAVEFOLDER))
+        return wavefolder_.getParameter (index - getFirstParameter (WAVEFOLDER));
+    if (index >= getFirstParameter (GRAMOPHONY))
+        return gramophony_.getParameter (index - getFirstParameter (GRAMOPHONY));
+    return order_;
+}
+
+int RackCore::getLatencySamples() const
+{
+    return gramophony_.getLatencySamples() + wavefolder_.getLatencySamples() + easyverb_.getLatencySamples();
+}
+
+void RackCore::process (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    const auto& order = ORDERS[juce::roundToInt (order_)];
+
+    // Each core runs its own stages on the micro block in one go, see MicroBlocks, and the next
+    // core picks it up while it is still in L1
+    MicroBlocks::forEach (num_samples, [&] (int first_sample, int micro_samples) {
+        for (int channel = 0; channel < num_channels; ++channel)
+            micro_channels_[static_cast<size_t> (channel)] = channels[channel] + first_sample;
+
+        for (auto stage : order)
+            processStage (stage, num_channels, micro_samples);
+    });
+}
+
+void RackCore::processStage (Stage stage, int num_channels, int num_samples)
+{
+    switch (stage)
+    {
+        case GRAMOPHONY:
+            gramophony_.process (micro_channels_.data(), num_channels, num_samples);
+            break;
+        case WAVEFOLDER:
+            wavefolder_.process (micro_channels_.data(), num_channels, num_samples);
+            break;
+        case EASYVERB:
+            easyverb_.process (micro_channels_.data(), num_channels, num_samples);
+            break;
+        case NUM_STAGES:
+        default:
+            break;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    RackCore.h
+    Created: 19 Oct 2026 2:37:12pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "EasyverbCore.h"
+#include "GramophonyCore.h"
+#include "WaveFolderCore.h"
+#include <CoreParameter.h>
+#include <JuceHeader.h>
+#include <MicroBlocks.h>
+
+// Gramophony, WaveFolder and Easyverb in one processor, in any of the orders of ORDER_NAMES.
+//
+// Three plugins in a row each run a whole host block before the next one starts, so with
+// large buffers every plugin reads its input back from L2 or memory. The rack hands each micro
+// block through all three cores before the next micro block starts: the signal is processed in
+// place in the host buffer and stays in L1 from the first stage to the last, with no buffers
+// between the cores. The cores only ever see micro blocks, so they are prepared for one.
+//
+// Parameter 0 is ORDER, followed by the parameters of each core in the order of Stage. Their
+// ids get the prefix of the core, e.g. "WAVEFOLDER_GAIN", so the cores can share names.
+class RackCore
+{
+public:
+    enum Stage
+    {
+        GRAMOPHONY = 0,
+        WAVEFOLDER,
+        EASYVERB,
+        NUM_STAGES
+    };
+
+    static constexpr int ORDER = 0;
+    static constexpr int NUM_PARAMETERS = 1 + GramophonyCore::NUM_PARAMETERS + WaveFolderCore::NUM_PARAMETERS + EasyverbCore::NUM_PARAMETERS;
+
+    static const juce::StringArray ORDER_NAMES;
+    static const CoreParameter ORDER_PARAMETER;
+
+    // The entry of the core's table, without the prefix
+    static const CoreParameter& getParameterInfo (int index);
+    static juce::String getParameterId (int index);
+    // Index of the first parameter of a stage
+    static int getFirstParameter (Stage stage);
+
+    RackCore();
+
+    void prepare (double sample_rate, int max_block_size, int num_channels);
+    void reset();
+
+    void setParameter (int index, float value);
+    float getParameter (int index) const;
+    // The cores delay the signal one after the other
+    int getLatencySamples() const;
+
+    // Processes num_channels planar channels in place, num_samples at most the max_block_size
+    // of prepare().
+    void process (float* const* channels, int num_channels, int num_samples);
+
+private:
+    void processStage (Stage stage, int num_channels, int num_samples);
+
+    float order_ = 0.0f;
+    int num_channels_ = 0;
+    // Points into the host buffer at the current micro block
+    std::vector<float*> micro_channels_;
+
+    GramophonyCore gramophony_;
+    WaveFolderCore wavefolder_;
+    EasyverbCore easyverb_;
+};
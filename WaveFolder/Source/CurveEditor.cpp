@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    CurveEditor.cpp
+    Created: 19 Oct 2026 7:31:18pm
+
+  ==============================================================================
+*/
+
+#include "CurveEditor.h"
+
+CurveEditor::CurveEditor (CustomCurve& curve)
+    : curve_ (curve)
+{
+}
+
+juce::Point<float> CurveEditor::getPointPosition (int index, float value) const
+{
+    const auto bounds = getLocalBounds().toFloat();
+    return { bounds.getX() + bounds.getWidth() * static_cast<float> (index) / (CustomCurve::NUM_POINTS - 1),
+             bounds.getCentreY() - 0.5f * bounds.getHeight() * value };
+}
+
+void CurveEditor::paint (juce::Graphics& g)
+{
+    const auto bounds = getLocalBounds().toFloat();
+
+    g.setColour (juce::Colours::white);
+    g.fillRect (bounds);
+
+    // Axes, and the input at every threshold
+    g.setColour (juce::Colours::lightgrey);
+    const int num_thresholds = static_cast<int> (FoldCurves::Lookup::RANGE);
+    for (int threshold = -num_thresholds + 1; threshold < num_thresholds; ++threshold)
+    {
+        const float x = bounds.getCentreX() + 0.5f * bounds.getWidth() * static_cast<float> (threshold) / FoldCurves::Lookup::RANGE;
+        g.drawVerticalLine (juce::roundToInt (x), bounds.getY(), bounds.getBottom());
+    }
+    g.drawHorizontalLine (juce::roundToInt (bounds.getCentreY()), bounds.getX(), bounds.getRight());
+
+    const auto& points = curve_.getPoints();
+    juce::Path path;
+    path.startNewSubPath (getPointPosition (0, points[0]));
+    for (int i = 1; i < CustomCurve::NUM_POINTS; ++i)
+        path.lineTo (getPointPosition (i, points[static_cast<size_t> (i)]));
+
+    g.setColour (juce::Colours::darkslategrey);
+    g.strokePath (path, juce::PathStrokeType (2.0f));
+}
+
+void CurveEditor::mouseDown (const juce::MouseEvent& event)
+{
+    last_position_ = event.position;
+    drawTo (event.position);
+}
+
+void CurveEditor::mouseDrag (const juce::MouseEvent& event)
+{
+    drawTo (event.position);
+}
+
+void CurveEditor::mouseDoubleClick (const juce::MouseEvent&)
+{
+    curve_.setPoints (CustomCurve::getDefaultPoints());
+    repaint();
+}
+
+void CurveEditor::drawTo (juce::Point<float> position)
+{
+    const auto bounds = getLocalBounds().toFloat();
+    if (bounds.isEmpty())
+        return;
+
+    const auto toIndex = [&bounds] (float x)
+    {
+        return juce::jlimit (0, CustomCurve::NUM_POINTS - 1, juce::roundToInt ((x - bounds.getX()) / bounds.getWidth() * (CustomCurve::NUM_POINTS - 1)));
+    };
+    const auto toValue = [&bounds] (float y)
+    {
+        return juce::jlimit (-1.0f, 1.0f, (bounds.getCentreY() - y) / (0.5f * bounds.getHeight()));
+    };
+
+    const int first = toIndex (last_position_.x);
+    const int last = toIndex (position.x);
+    const float first_value = toValue (last_position_.y);
+    const float last_value = toValue (position.y);
+
+    auto points = curve_.getPoints();
+    for (int i = juce::jmin (first, last); i <= juce::jmax (first, last); ++i)
+    {
+        const float amount = first == last ? 1.0f : static_cast<float> (i - first) / static_cast<float> (last - first);
+        points[static_cast<size_t> (i)] = first_value + amount * (last_value - first_value);
+    }
+
+    last_position_ = position;
+    curve_.setPoints (points);
+    repaint();
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    CurveEditor.h
+    Created: 19 Oct 2026 7:31:18pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "CustomCurve.h"
+#include <JuceHeader.h>
+
+// Draws the custom transfer curve and lets the user redraw it with the mouse. The horizontal
+// axis is the input and the vertical axis the output, both in multiples of the threshold.
+// Dragging sets the points under the mouse, double click restores the original fold.
+class CurveEditor : public juce::Component
+{
+public:
+    explicit CurveEditor (CustomCurve& curve);
+
+    void paint (juce::Graphics& g) override;
+    void mouseDown (const juce::MouseEvent& event) override;
+    void mouseDrag (const juce::MouseEvent& event) override;
+    void mouseDoubleClick (const juce::MouseEvent& event) override;
+
+private:
+    // Sets the points between the previous and the current mouse position, so a fast drag
+    // leaves no gaps
+    void drawTo (juce::Point<float> position);
+    juce::Point<float> getPointPosition (int index, float value) const;
+
+    CustomCurve& curve_;
+    juce::Point<float> last_position_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CurveEditor)
+};
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    CustomCurve.cpp
+    Created: 19 Oct 2026 7:02:45pm
+
+  ==============================================================================
+*/
+
+#include "CustomCurve.h"
+
+const juce::Identifier CURVE_PROPERTY ("CUSTOM_CURVE");
+
+// Corners of the drawn curve are rounded over this many table steps on each side, 1/16 of
+// the threshold. A corner in a transfer curve makes harmonics that fall off slowly and alias,
+// the rounded curve keeps its shape but limits how high they reach.
+constexpr int SMOOTHING_STEPS = 4;
+
+CustomCurve::CustomCurve (juce::AudioProcessorValueTreeState& apvts)
+    : apvts_ (apvts)
+{
+    loadFromState();
+}
+
+CustomCurve::Points CustomCurve::getDefaultPoints()
+{
+    Points points;
+    for (int i = 0; i < NUM_POINTS; ++i)
+    {
+        const float x = FoldCurves::Lookup::RANGE * (2.0f * static_cast<float> (i) / (NUM_POINTS - 1) - 1.0f);
+        // A triangle wave through (-1, -1) and (1, 1) with a period of four thresholds
+        const float phase = x + 1.0f - 4.0f * std::floor ((x + 1.0f) / 4.0f);
+        points[static_cast<size_t> (i)] = phase < 2.0f ? phase - 1.0f : 3.0f - phase;
+    }
+    return points;
+}
+
+void CustomCurve::setPoints (const Points& points)
+{
+    points_ = points;
+    for (auto& point : points_)
+        point = juce::jlimit (-1.0f, 1.0f, point);
+
+    juce::StringArray values;
+    for (auto point : points_)
+        values.add (juce::String (point));
+    apvts_.state.setProperty (CURVE_PROPERTY, values.joinIntoString (" "), nullptr);
+
+    compile (points_, tables_[static_cast<size_t> (write_index_)]);
+    write_index_ = exchange_.exchange (write_index_ | NEW_TABLE) & ~NEW_TABLE;
+}
+
+void CustomCurve::loadFromState()
+{
+    juce::StringArray values;
+    values.addTokens (apvts_.state.getProperty (CURVE_PROPERTY).toString(), " ", "");
+    values.removeEmptyStrings();
+
+    // A state saved before the curve existed, or a damaged one, gets the original fold
+    auto points = getDefaultPoints();
+    if (values.size() == NUM_POINTS)
+    {
+        for (int i = 0; i < NUM_POINTS; ++i)
+            points[static_cast<size_t> (i)] = values[i].getFloatValue();
+    }
+
+    setPoints (points);
+}
+
+const float* CustomCurve::acquireTable()
+{
+    if ((exchange_.load() & NEW_TABLE) != 0)
+        read_index_ = exchange_.exchange (read_index_) & ~NEW_TABLE;
+
+    return tables_[static_cast<size_t> (read_index_)].data();
+}
+
+void CustomCurve::compile (const Points& points, Table& table)
+{
+    constexpr int TABLE_SIZE = FoldCurves::Lookup::TABLE_SIZE;
+    constexpr float STEPS_PER_SEGMENT = static_cast<float> (TABLE_SIZE) / (NUM_POINTS - 1);
+
+    // The drawn points joined by straight lines
+    std::array<float, TABLE_SIZE + 1> lines;
+    for (int i = 0; i <= TABLE_SIZE; ++i)
+    {
+        const float position = static_cast<float> (i) / STEPS_PER_SEGMENT;
+        const int point = juce::jmin (static_cast<int> (position), NUM_POINTS - 2);
+        const float fraction = position - static_cast<float> (point);
+        lines[static_cast<size_t> (i)] = points[static_cast<size_t> (point)] + fraction * (points[static_cast<size_t> (point + 1)] - points[static_cast<size_t> (point)]);
+    }
+
+    // Smoothed with a Hann window, the ends of the range are held
+    std::array<float, SMOOTHING_STEPS * 2 + 1> window;
+    float window_sum = 0.0f;
+    for (int k = -SMOOTHING_STEPS; k <= SMOOTHING_STEPS; ++k)
+    {
+        const float weight = 0.5f + 0.5f * std::cos (juce::MathConstants<float>::pi * static_cast<float> (k) / (SMOOTHING_STEPS + 1));
+        window[static_cast<size_t> (k + SMOOTHING_STEPS)] = weight;
+        window_sum += weight;
+    }
+
+    for (int i = 0; i <= TABLE_SIZE; ++i)
+    {
+        float sum = 0.0f;
+        for (int k = -SMOOTHING_STEPS; k <= SMOOTHING_STEPS; ++k)
+            sum += window[static_cast<size_t> (k + SMOOTHING_STEPS)] * lines[static_cast<size_t> (juce::jlimit (0, TABLE_SIZE, i + k))];
+        table[static_cast<size_t> (i)] = sum / window_sum;
+    }
+
+    table[TABLE_SIZE + 1] = table[TABLE_SIZE];
+}
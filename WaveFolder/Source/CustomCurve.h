@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    CustomCurve.h
+    Created: 19 Oct 2026 7:02:45pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FoldCurves.h"
+#include <JuceHeader.h>
+
+// The transfer curve drawn in the editor, and the lookup table the audio thread folds with.
+//
+// The curve is NUM_POINTS values at evenly spaced multiples of the threshold from
+// -FoldCurves::Lookup::RANGE to RANGE. It is stored as a property of the processor state, so
+// it is saved with the project. setPoints() compiles the curve into a table on the message
+// thread and publishes it through a triple buffer: the audio thread picks up the newest
+// table with one atomic exchange in acquireTable(), never waits and never sees a table that
+// is being written.
+class CustomCurve
+{
+public:
+    static constexpr int NUM_POINTS = 33;
+    typedef std::array<float, NUM_POINTS> Points;
+
+    explicit CustomCurve (juce::AudioProcessorValueTreeState& apvts);
+
+    // The original fold, reflected at every odd multiple of the threshold
+    static Points getDefaultPoints();
+
+    // Message thread: stores the points in the state, compiles and publishes them
+    void setPoints (const Points& points);
+    const Points& getPoints() const { return points_; }
+    // Message thread: compiles the points stored in the state, after it has been replaced
+    void loadFromState();
+
+    // Audio thread: the newest published table, valid until the next call
+    const float* acquireTable();
+
+private:
+    typedef std::array<float, FoldCurves::Lookup::TABLE_SIZE + 2> Table;
+
+    static void compile (const Points& points, Table& table);
+
+    juce::AudioProcessorValueTreeState& apvts_;
+    Points points_ {};
+
+    // The writer owns one table and the reader another. The third is exchanged between
+    // them, with NEW_TABLE set when the writer has put a table there the reader has not seen.
+    static constexpr int NEW_TABLE = 4;
+    std::array<Table, 3> tables_ {};
+    int write_index_ = 0;
+    int read_index_ = 1;
+    std::atomic<int> exchange_ { 2 };
+};
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    FoldCascade.cpp
+    Created: 19 Oct 2026 5:12:40pm
+
+  ==============================================================================
+*/
+
+#include "FoldCascade.h"
+
+namespace
+{
+    template <typename Shape, int... StageCounts>
+    constexpr std::array<FoldCascade::Kernel, sizeof... (StageCounts)> makeKernels (std::integer_sequence<int, StageCounts...>)
+    {
+        return { { &FoldCascade::processStages<Shape, StageCounts + 1>... } };
+    }
+}
+
+template <typename Shape, int NumStages>
+forcedinline float FoldCascade::foldSample (const Shape& shape, float sample, float threshold, Stages stages)
+{
+    // Recursion instead of a loop over the stages, so every instantiation is unrolled
+    // before the compiler tries to vectorise the sample loop around it.
+    sample = shape.apply (sample, threshold);
+
+    if constexpr (NumStages > 1)
+        return foldSample<Shape, NumStages - 1> (shape, sample * stages.gain, threshold * stages.threshold_scale, stages);
+    else
+        return sample;
+}
+
+template <typename Shape, int NumStages>
+void FoldCascade::processStages (float* __restrict samples, int num_samples, int factor, const Modulation& modulation, int first_frame, const Stages& shared_stages)
+{
+    // A local copy, so the compiler knows the samples written never change it
+    const Stages stages = shared_stages;
+    const float makeup_gain = NumStages > 1 ? stages.makeup_gain : 1.0f;
+    Shape shape;
+    if constexpr (std::is_same<Shape, FoldCurves::Lookup>::value)
+        shape.values = stages.table;
+
+    const auto* input_gains = modulation.input_gains + first_frame;
+    const auto* biases = modulation.biases + first_frame;
+    const auto* thresholds = modulation.thresholds + first_frame;
+
+    if (factor == 1)
+    {
+        // One sample per frame, a straight loop over arrays that compilers vectorise
+        for (int i = 0; i < num_samples; ++i)
+            samples[i] = foldSample<Shape, NumStages> (shape, samples[i] * input_gains[i] + biases[i], thresholds[i], stages) * makeup_gain;
+        return;
+    }
+
+    for (int frame = 0; frame < num_samples / factor; ++frame)
+    {
+        const float input_gain = input_gains[frame];
+        const float bias = biases[frame];
+        const float threshold = thresholds[frame];
+        auto* frame_samples = samples + frame * factor;
+
+        for (int i = 0; i < factor; ++i)
+            frame_samples[i] = foldSample<Shape, NumStages> (shape, frame_samples[i] * input_gain + bias, threshold, stages) * makeup_gain;
+    }
+}
+
+FoldCascade::FoldCascade()
+{
+    setStages (Curve::triangle, 1, 1.0f, 1.0f);
+}
+
+void FoldCascade::setStages (Curve curve, int num_stages, float threshold_scale, float stage_gain)
+{
+    // One row of kernels per curve, in the order of the Curve enum
+    static constexpr std::array<std::array<Kernel, MAX_STAGES>, NUM_CURVES> KERNELS = { {
+        makeKernels<FoldCurves::Triangle> (std::make_integer_sequence<int, MAX_STAGES>()),
+        makeKernels<FoldCurves::Sine> (std::make_integer_sequence<int, MAX_STAGES>()),
+        makeKernels<FoldCurves::Buchla> (std::make_integer_sequence<int, MAX_STAGES>()),
+        makeKernels<FoldCurves::Soft> (std::make_integer_sequence<int, MAX_STAGES>()),
+        makeKernels<FoldCurves::Lookup> (std::make_integer_sequence<int, MAX_STAGES>()),
+    } };
+
+    curve_ = static_cast<Curve> (juce::jlimit (0, NUM_CURVES - 1, static_cast<int> (curve)));
+    // Without a table the custom curve falls back to the original fold
+    if (curve_ == Curve::custom && stages_.table == nullptr)
+        curve_ = Curve::triangle;
+
+    num_stages_ = juce::jlimit (1, MAX_STAGES, num_stages);
+    kernel_ = KERNELS[static_cast<size_t> (curve_)][static_cast<size_t> (num_stages_ - 1)];
+    stages_.threshold_scale = threshold_scale;
+    stages_.gain = stage_gain;
+    stages_.makeup_gain = 1.0f / std::pow (stage_gain, static_cast<float> (num_stages_ - 1));
+}
+
+void FoldCascade::process (float* samples, int num_samples, int factor, const Modulation& modulation, int first_frame) const
+{
+    kernel_ (samples, num_samples, factor, modulation, first_frame, stages_);
+}
+
+void FoldCascade::processInterleaved (float* samples, int num_samples, int num_streams, int factor, const Modulation& modulation, int first_frame) const
+{
+    // A frame of the interleaved streams is factor * num_streams samples that all share the
+    // modulation, which is exactly what the kernel folds for a frame
+    kernel_ (samples, num_samples * num_streams, factor * num_streams, modulation, first_frame, stages_);
+}
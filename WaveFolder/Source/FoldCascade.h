@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    FoldCascade.h
+    Created: 19 Oct 2026 5:12:40pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FoldCurves.h"
+#include <JuceHeader.h>
+
+// One to MAX_STAGES folds in series, all with the same transfer curve. Every stage folds at
+// the threshold of the previous stage times threshold_scale, and stages after the first are
+// driven by stage_gain.
+// The fold does not limit the level, so the output is scaled back by the total stage gain.
+//
+// Every curve and stage count is its own kernel instantiation, so the curve is inlined, the
+// stage loop is unrolled and the signal stays in registers. The kernel is picked once per
+// block in setStages().
+class FoldCascade
+{
+public:
+    static constexpr int MAX_STAGES = 8;
+
+    // The curves of FoldCurves.h
+    enum class Curve
+    {
+        triangle = 0,
+        sine,
+        buchla,
+        soft,
+        custom
+    };
+    static constexpr int NUM_CURVES = 5;
+
+    // Input gain, bias and threshold of every sample frame at the host rate
+    struct Modulation
+    {
+        const float* input_gains = nullptr;
+        const float* biases = nullptr;
+        const float* thresholds = nullptr;
+    };
+
+    FoldCascade();
+
+    void setStages (Curve curve, int num_stages, float threshold_scale, float stage_gain);
+    // Table of the custom curve, laid out as FoldCurves::Lookup expects. Set it before
+    // setStages() selects the custom curve, it has to stay valid until it is replaced.
+    void setCustomTable (const float* table) { stages_.table = table; }
+    Curve getCurve() const { return curve_; }
+    int getNumStages() const { return num_stages_; }
+
+    // Folds num_samples samples running at factor times the host rate in place, starting
+    // with the modulation of first_frame. factor is a power of two.
+    void process (float* samples, int num_samples, int factor, const Modulation& modulation, int first_frame) const;
+    // Folds num_streams streams with the same settings and modulation at once. The streams are
+    // interleaved, sample i of stream s sits at i * num_streams + s, so each stream takes a SIMD
+    // lane of the same kernel. num_samples counts the samples of one stream.
+    void processInterleaved (float* samples, int num_samples, int num_streams, int factor, const Modulation& modulation, int first_frame) const;
+
+    struct Stages
+    {
+        float threshold_scale = 1.0f;
+        float gain = 1.0f;
+        float makeup_gain = 1.0f;
+        const float* table = nullptr;
+    };
+
+    typedef void (*Kernel) (float*, int, int, const Modulation&, int, const Stages&);
+
+    template <typename Shape, int NumStages>
+    static void processStages (float* samples, int num_samples, int factor, const Modulation& modulation, int first_frame, const Stages& stages);
+
+private:
+    // Forced inline, so the recursion does not stop at the inlining limits of the compiler
+    // and leave a call in the sample loop
+    template <typename Shape, int NumStages>
+    static forcedinline float foldSample (const Shape& shape, float sample, float threshold, Stages stages);
+
+    Kernel kernel_ = nullptr;
+    Curve curve_ = Curve::triangle;
+    int num_stages_ = 0;
+    Stages stages_;
+};
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    FoldCurves.h
+    Created: 19 Oct 2026 5:48:03pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Transfer functions of one fold stage, used to specialise the FoldCascade kernels.
+//
+// Every curve maps a sample to the folded sample at a threshold. They are written with
+// arithmetic, abs, copysign, min and max only, no branches or library calls, which would keep
+// the kernels they are inlined into from being vectorised.
+namespace FoldCurves
+{
+    // Added to the thresholds the smooth curves divide by, the threshold LFO can reach zero
+    constexpr float MIN_THRESHOLD = 1.0e-4f;
+
+    // Adding and subtracting 1.5 * 2^23 rounds a float below 2^22 to the nearest integer
+    constexpr float ROUNDING_MAGIC = 12582912.0f;
+
+    // max (value, 0) without a compare
+    inline float positivePart (float value)
+    {
+        return 0.5f * (value + std::abs (value));
+    }
+
+    // value limited to [-limit, limit] with a min and a max. NaN ends up at limit, std::min
+    // returns its first argument when the compare fails.
+    inline float clampSymmetric (float value, float limit)
+    {
+        return std::max (0.0f - limit, std::min (limit, value));
+    }
+
+    // The original WaveFolder fold: one reflection at the threshold on each side
+    struct Triangle
+    {
+        static float apply (float sample, float threshold)
+        {
+            // Beyond the threshold the reflection is the smaller (larger) value, so min and
+            // max replace the branches.
+            // Positive side of waveform
+            sample = juce::jmin (sample, 2.0f * threshold - sample);
+            // Negative side of waveform
+            sample = juce::jmax (sample, 2.0f * (0.0f - threshold) - sample);
+            return sample;
+        }
+    };
+
+    // threshold * sin (pi / 2 * sample / threshold), folds endlessly with round peaks
+    struct Sine
+    {
+        static float apply (float sample, float threshold)
+        {
+            threshold = std::abs (threshold) + MIN_THRESHOLD;
+
+            // A triangle wave of the sample with period 4 * threshold and peaks of +-1 at odd
+            // multiples of the threshold, sin (pi / 2 * x) has the same zeros and peaks.
+            // Samples beyond 2^22 thresholds land on a peak, the curve stays bounded.
+            const float cycles = (sample / threshold + 1.0f) * 0.25f;
+            const float wrapped = cycles - ((cycles + ROUNDING_MAGIC) - ROUNDING_MAGIC);
+            const float triangle = 4.0f * std::abs (wrapped) - 1.0f;
+
+            // Taylor series of sin (pi / 2 * x) to the 9th power, error below 4e-6
+            const float x = juce::MathConstants<float>::halfPi * triangle;
+            const float x2 = x * x;
+            const float sine = x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+            return threshold * sine;
+        }
+    };
+
+    // Parallel folding cells in the style of the Buchla 259. Every cell starts at its own
+    // multiple of the threshold and turns the slope around, with shrinking slopes so the
+    // folds get smaller, until the curve is flat beyond 5.8 times the threshold.
+    struct Buchla
+    {
+        static float apply (float sample, float threshold)
+        {
+            threshold = std::abs (threshold) + MIN_THRESHOLD;
+
+            constexpr float CELL_STARTS[] = { 1.0f, 2.2f, 3.4f, 4.6f, 5.8f };
+            constexpr float CELL_GAINS[] = { 2.0f, -1.8f, 1.6f, -1.4f, 0.6f };
+
+            const float level = std::abs (sample / threshold);
+            float folded = level;
+            for (int cell = 0; cell < 5; ++cell)
+                folded -= CELL_GAINS[cell] * positivePart (level - CELL_STARTS[cell]);
+
+            return std::copysign (threshold * folded, sample);
+        }
+    };
+
+    // The triangle fold with its corners rounded by a soft clipper at the threshold
+    struct Soft
+    {
+        static float apply (float sample, float threshold)
+        {
+            threshold = std::abs (threshold) + MIN_THRESHOLD;
+
+            // Rational approximation of tanh, exact enough and monotonic up to 3
+            const float x = clampSymmetric (Triangle::apply (sample, threshold) / threshold, 3.0f);
+            const float x2 = x * x;
+            return threshold * x * (27.0f + x2) / (27.0f + 9.0f * x2);
+        }
+    };
+
+    // A drawn curve, compiled into a table by CustomCurve. The table holds the curve at
+    // TABLE_SIZE + 1 evenly spaced multiples of the threshold from -RANGE to RANGE, and a copy
+    // of the last value so the interpolation can always read one value ahead. The curve is
+    // flat beyond the range. Every sample costs the same, whatever shape was drawn.
+    struct Lookup
+    {
+        static constexpr float RANGE = 4.0f;
+        static constexpr int TABLE_SIZE = 512;
+
+        float apply (float sample, float threshold) const
+        {
+            threshold = std::abs (threshold) + MIN_THRESHOLD;
+
+            // Within [0, TABLE_SIZE] even for infinite or NaN samples, so the conversion to int
+            // rounds down and the index stays in the table
+            const float position = (clampSymmetric (sample / threshold, RANGE) + RANGE) * (TABLE_SIZE / (2.0f * RANGE));
+            const int index = static_cast<int> (position);
+            const float fraction = position - static_cast<float> (index);
+
+            return threshold * (values[index] + fraction * (values[index + 1] - values[index]));
+        }
+
+        const float* values = nullptr;
+    };
+}
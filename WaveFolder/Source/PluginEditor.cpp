@@ -11,7 +11,8 @@
 
 //==============================================================================
 WaveFolderAudioProcessorEditor::WaveFolderAudioProcessorEditor (WaveFolderAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p), info_button_ (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId))
+    : AudioProcessorEditor (&p), audioProcessor (p), info_button_ (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId)),
+      governor_display_ (p.getGovernor(), juce::Colours::white), curve_editor_ (p.getCustomCurve())
 {
     constexpr int TEXT_BOX_SIZE = 25;
 
@@ -85,7 +86,16 @@ WaveFolderAudioProcessorEditor::WaveFolderAudioProcessorEditor (WaveFolderAudioP
 
     mix_slider_attachment_ = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (audioProcessor.apvts, "DRY_WET_MIX", mix_slider_);
 
-    setSize (600, 250);
+    // Fold curve, the drawn curve is used when "Custom" is selected
+    curve_box_.addItemList (audioProcessor.apvts.getParameter ("CURVE")->getAllValueStrings(), 1);
+    addAndMakeVisible (curve_box_);
+
+    curve_box_attachment_ = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (audioProcessor.apvts, "CURVE", curve_box_);
+
+    addAndMakeVisible (curve_editor_);
+    addAndMakeVisible (governor_display_);
+
+    setSize (600, 400);
     DivideSections();
 
     // Paint info last so the info popup window will not be covered by the sliders.
@@ -125,6 +135,8 @@ void WaveFolderAudioProcessorEditor::paint (juce::Graphics& g)
     g.fillRect (bias_lfo_rate_section_);
     g.setColour (juce::Colours::peachpuff);
     g.fillRect (mix_section_);
+    g.setColour (juce::Colours::thistle);
+    g.fillRect (curve_section_);
 
     g.setColour (juce::Colours::white);
     g.setFont (40.0f);
@@ -140,12 +152,14 @@ void WaveFolderAudioProcessorEditor::paint (juce::Graphics& g)
     g.drawFittedText ("LFO", bias_section_, juce::Justification::centredBottom, 1);
     g.drawFittedText ("VOLUME", volume_section_, juce::Justification::centredTop, 1);
     g.drawFittedText ("MIX", volume_section_, juce::Justification::centredBottom, 1);
+    g.drawFittedText ("CURVE", curve_section_.withWidth (150), juce::Justification::centredTop, 1);
 }
 
 void WaveFolderAudioProcessorEditor::resized()
 {
     info_button_.button.setBounds (getWidth() - 35, 15, 20, 20);
     info_button_.info_text.setBounds (80, 50, getWidth() - 160, getHeight() - 100);
+    governor_display_.setBounds (15, 15, 200, 20);
     DivideSections();
     constexpr int KNOB_SECTION_REDUCTION = 30;
     gain_slider_.setBounds (gain_section_.reduced (KNOB_SECTION_REDUCTION));
@@ -159,6 +173,9 @@ void WaveFolderAudioProcessorEditor::resized()
     bias_lfo_rate_slider_.setBounds (bias_lfo_rate_section_);
     bias_lfo_depth_slider_.setBounds (bias_lfo_depth_section_);
     mix_slider_.setBounds (mix_section_);
+    auto curve_section = curve_section_.reduced (10);
+    curve_box_.setBounds (curve_section.removeFromLeft (130).withSizeKeepingCentre (130, 25));
+    curve_editor_.setBounds (curve_section.withTrimmedLeft (20));
 }
 
 void WaveFolderAudioProcessorEditor::DivideSections()
@@ -166,6 +183,7 @@ void WaveFolderAudioProcessorEditor::DivideSections()
     juce::Rectangle<int> r = getLocalBounds();
 
     top_section_ = r.removeFromTop (50);
+    curve_section_ = r.removeFromBottom (150);
     juce::Rectangle<int> bottom_section = r.removeFromBottom (50);
     gain_section_ = r.removeFromLeft (150);
     threshold_section_ = r.removeFromLeft (150);
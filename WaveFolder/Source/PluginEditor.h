@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include "CurveEditor.h"
 #include "PluginProcessor.h"
+#include <CpuGovernorDisplay.h>
 #include <InfoButton.h>
 #include <JuceHeader.h>
 
@@ -28,6 +30,7 @@ public:
 private:
     void DivideSections();
     InfoButton info_button_;
+    CpuGovernorDisplay governor_display_;
     juce::Slider gain_slider_;
     juce::Slider threshold_slider_;
     juce::Slider bias_slider_;
@@ -39,6 +42,8 @@ private:
     juce::Slider bias_lfo_rate_slider_;
     juce::Slider bias_lfo_depth_slider_;
     juce::Slider mix_slider_;
+    juce::ComboBox curve_box_;
+    CurveEditor curve_editor_;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
         gain_slider_attachment_;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
@@ -61,6 +66,8 @@ private:
         bias_lfo_depth_slider_attachment_;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
         mix_slider_attachment_;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>
+        curve_box_attachment_;
     juce::Rectangle<int> top_section_;
     juce::Rectangle<int> gain_section_;
     juce::Rectangle<int> threshold_section_;
@@ -73,6 +80,7 @@ private:
     juce::Rectangle<int> bias_lfo_rate_section_;
     juce::Rectangle<int> bias_lfo_depth_section_;
     juce::Rectangle<int> mix_section_;
+    juce::Rectangle<int> curve_section_;
 
     WaveFolderAudioProcessor& audioProcessor;
 
@@ -9,7 +9,12 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
-const float gate_threshold = 0.005;
+// Parameters stored in presets, in the order of the Parameter enum.
+// Marks states saved since the LFOs advance once per sample frame, see processSegment()
+const juce::Identifier LFO_PER_FRAME_PROPERTY ("LFO_PER_FRAME");
+
+// Parameters stored in presets, in the order of the Parameter enum.
+const juce::StringArray PARAMETER_IDS { "GAIN", "BIAS", "THRESHOLD", "VOLUME", "GAIN_LFO_RATE", "GAIN_LFO_DEPTH", "THR_LFO_RATE", "THR_LFO_DEPTH", "BIAS_LFO_RATE", "BIAS_LFO_DEPTH", "DRY_WET_MIX", "FOLD_STAGES", "STAGE_THRESHOLD", "STAGE_GAIN", "CURVE" };
 
 //==============================================================================
 WaveFolderAudioProcessor::WaveFolderAudioProcessor()
@@ -22,13 +27,31 @@ WaveFolderAudioProcessor::WaveFolderAudioProcessor()
                           .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
 #endif
                           ),
-      apvts (*this, nullptr, "Parameters", createParameters())
+      apvts (*this, nullptr, "Parameters", createParameters()),
+      program_switcher_ (apvts, PARAMETER_IDS)
 #endif
 {
+    // A bank file next to the other plugin data replaces the factory presets.
+    if (! program_switcher_.getBank().loadFromFile (PresetBank::getDefaultBankFile()))
+    {
+        addFactoryPresets();
+    }
+
+    apvts.state.setProperty (LFO_PER_FRAME_PROPERTY, true, nullptr);
+
+    apvts.addParameterListener ("OVERSAMPLING", this);
+    apvts.addParameterListener ("OVERSAMPLING_FILTER", this);
+    apvts.addParameterListener ("PARALLEL", this);
+    apvts.addParameterListener ("OFFLINE_OVERSAMPLING", this);
 }
 
 WaveFolderAudioProcessor::~WaveFolderAudioProcessor()
 {
+    apvts.removeParameterListener ("OVERSAMPLING", this);
+    apvts.removeParameterListener ("OVERSAMPLING_FILTER", this);
+    apvts.removeParameterListener ("PARALLEL", this);
+    apvts.removeParameterListener ("OFFLINE_OVERSAMPLING", this);
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -71,49 +94,58 @@ double WaveFolderAudioProcessor::getTailLengthSeconds() const
 
 int WaveFolderAudioProcessor::getNumPrograms()
 {
-    return 1; // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    return program_switcher_.getNumPrograms(); // NB: some hosts don't cope very well if you tell them there are 0 programs,
         // so this should be at least 1, even if you're not really implementing programs.
 }
 
 int WaveFolderAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return program_switcher_.getCurrentProgram();
 }
 
 void WaveFolderAudioProcessor::setCurrentProgram (int index)
 {
+    program_switcher_.setCurrentProgram (index);
 }
 
 const juce::String WaveFolderAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return program_switcher_.getProgramName (index);
 }
 
 void WaveFolderAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    program_switcher_.changeProgramName (index, newName);
 }
 
 //==============================================================================
 void WaveFolderAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    //prepare lfos
-    juce::dsp::ProcessSpec lfo_spec = { sampleRate, samplesPerBlock, getMainBusNumOutputChannels() };
-    gain_lfo_.prepare (lfo_spec);
-    gain_lfo_.initialise ([] (float x) { return std::sin (x); }, 128);
-
-    juce::dsp::ProcessSpec lfo_spec2 = { sampleRate, samplesPerBlock, getMainBusNumOutputChannels() };
-    thr_lfo_.prepare (lfo_spec2);
-    thr_lfo_.initialise ([] (float x) { return std::sin (x); }, 128);
-
-    juce::dsp::ProcessSpec lfo_spec3 = { sampleRate, samplesPerBlock, getMainBusNumOutputChannels() };
-    bias_lfo_.prepare (lfo_spec3);
-    bias_lfo_.initialise ([] (float x) { return std::sin (x); }, 128);
+    program_switcher_.prepare (sampleRate);
+
+    // The LFOs share one sine table with every other instance in the process
+    gain_lfo_.prepare (sampleRate);
+    thr_lfo_.prepare (sampleRate);
+    bias_lfo_.prepare (sampleRate);
+
+    // The modulation covers a block for the workers, the dry copy only ever one micro block
+    max_block_size_ = juce::jmax (1, samplesPerBlock);
+    modulation_.setSize (4, max_block_size_);
+    dry_.setSize (getMainBusNumOutputChannels(), MicroBlocks::getScratchSize (max_block_size_));
+    // One more channel for the biases
+    dry_delay_.prepare ({ sampleRate, static_cast<juce::uint32> (max_block_size_), static_cast<juce::uint32> (getMainBusNumOutputChannels() + 1) });
+    offline_ = isNonRealtime();
+    prepareOversampler (max_block_size_);
+    prepareWorkers();
+    dual_mono_.reset();
 }
 
 void WaveFolderAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    // Idle workers spin for a while, so do not keep them around without playback
+    workers_.setNumWorkers (0);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -123,10 +155,8 @@ bool WaveFolderAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
     juce::ignoreUnused (layouts);
     return true;
 #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout is supported, the fold is applied to every channel on its own.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
         // This checks if the input layout matches the output layout
@@ -143,6 +173,7 @@ bool WaveFolderAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 void WaveFolderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    juce::AudioProcessLoadMeasurer::ScopedTimer timer (governor_.getLoadMeasurer(), buffer.getNumSamples());
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -157,57 +188,269 @@ void WaveFolderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
         buffer.clear (i, 0, buffer.getNumSamples());
     }
 
-    // Handle the audio buffer for each channel
-    for (float sample = 0; sample < buffer.getNumSamples(); ++sample)
+    // Hosts may start or stop rendering offline without preparing again
+    if (isNonRealtime() != offline_.load())
+        switchTier (isNonRealtime());
+
+    // Bounces have no deadline to keep
+    governor_.setEnabled (apvts.getRawParameterValue ("GOVERNOR")->load() > 0.5f && ! isNonRealtime());
+    dual_mono_.setEnabled (apvts.getRawParameterValue ("DUAL_MONO")->load() > 0.5f);
+    const int governor_level = governor_.update (buffer.getNumSamples());
+    if (governor_level != governor_level_)
+        applyGovernorLevel (governor_level);
+
+    // A program crossfade hands out its values in short steps, see ProgramSwitcher
+    ParameterValues values;
+    for (int first_sample = 0; first_sample < buffer.getNumSamples();)
     {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
-        {
-            float dry_sample = *buffer.getWritePointer (channel, sample);
-            // LFO settings
-            gain_lfo_.setFrequency (apvts.getRawParameterValue ("GAIN_LFO_RATE")->load());
-            gain_lfo_volume_.setTargetValue (apvts.getRawParameterValue ("GAIN_LFO_DEPTH")->load());
-            thr_lfo_.setFrequency (apvts.getRawParameterValue ("THR_LFO_RATE")->load());
-            thr_lfo_volume_.setTargetValue (apvts.getRawParameterValue ("THR_LFO_DEPTH")->load());
-            bias_lfo_.setFrequency (apvts.getRawParameterValue ("BIAS_LFO_RATE")->load());
-            bias_lfo_volume_.setTargetValue (apvts.getRawParameterValue ("BIAS_LFO_DEPTH")->load());
-
-            float gain_lfo_offset = gain_lfo_.processSample (0.0f) * gain_lfo_volume_.getNextValue();
-            float thr_lfo_offset = thr_lfo_.processSample (0.0f) * thr_lfo_volume_.getNextValue();
-            float bias_lfo_offset = bias_lfo_.processSample (0.0f) * bias_lfo_volume_.getNextValue();
-
-            // Update all parameters
-            float threshold = apvts.getRawParameterValue ("THRESHOLD")->load() + thr_lfo_offset;
-            float bias = apvts.getRawParameterValue ("BIAS")->load() + bias_lfo_offset;
-            float input_gain = apvts.getRawParameterValue ("GAIN")->load() + gain_lfo_offset;
-            float output_gain = apvts.getRawParameterValue ("VOLUME")->load();
-
-            // Do not add any effects if volume is to low to prevent lfos to leak.
-            if (*buffer.getWritePointer (channel, sample) + bias<gate_threshold&& * buffer.getWritePointer (channel, sample) + bias> - gate_threshold)
-            {
-                continue;
-            }
+        const int num_samples = program_switcher_.readParameters (values, buffer.getNumSamples() - first_sample);
+        processSegment (buffer, first_sample, num_samples, totalNumInputChannels, values);
+        first_sample += num_samples;
+    }
+}
 
-            // Process the signal using parameters
-            *buffer.getWritePointer (channel, sample) *= input_gain;
-            *buffer.getWritePointer (channel, sample) += bias;
-            // Positive side of waveform
-            if (*buffer.getWritePointer (channel, sample) > threshold)
-            {
-                *buffer.getWritePointer (channel, sample) =
-                    2.0f * threshold - *buffer.getWritePointer (channel, sample);
-            }
-            // Negative side of waveform
-            if (*buffer.getWritePointer (channel, sample) < 0 - threshold)
+void WaveFolderAudioProcessor::processSegment (juce::AudioBuffer<float>& buffer, int first_sample, int num_samples, int num_channels, const ParameterValues& values)
+{
+    // The LFOs used to advance once per channel sample, so a stereo track ran them twice as
+    // fast as their rate. Projects saved then keep that speed, new ones get the rate.
+    const float lfo_rate_scale = lfo_per_frame_.load() ? 1.0f : static_cast<float> (num_channels);
+
+    // LFO settings
+    gain_lfo_.setFrequency (values[GAIN_LFO_RATE] * lfo_rate_scale);
+    gain_lfo_volume_.setTargetValue (values[GAIN_LFO_DEPTH]);
+    thr_lfo_.setFrequency (values[THR_LFO_RATE] * lfo_rate_scale);
+    thr_lfo_volume_.setTargetValue (values[THR_LFO_DEPTH]);
+    bias_lfo_.setFrequency (values[BIAS_LFO_RATE] * lfo_rate_scale);
+    bias_lfo_volume_.setTargetValue (values[BIAS_LFO_DEPTH]);
+
+    // Presets crossfade the curve and stage count like every other value, so round them
+    const auto curve = static_cast<FoldCascade::Curve> (juce::roundToInt (values[CURVE]));
+    fold_.setCustomTable (custom_curve_.acquireTable());
+    fold_.setStages (curve, juce::roundToInt (values[FOLD_STAGES]), values[STAGE_THRESHOLD], values[STAGE_GAIN]);
+
+    // Groups of channels share nothing but the read only modulation, so the workers can take
+    // them while the audio thread works on one itself. Short blocks go serially, waking a
+    // worker costs more than folding a few hundred samples.
+    const int num_groups = (num_channels + CHANNELS_PER_GROUP - 1) / CHANNELS_PER_GROUP;
+    const bool parallel = workers_.getNumWorkers() > 0 && num_groups > 1 && num_samples * getOversamplers().front().getFactor() >= MIN_PARALLEL_FRAMES;
+
+    // Every stage runs on one micro block before the next one starts, see MicroBlocks. Waking
+    // the workers is only worth it once per prepared block, they go through their groups in
+    // micro blocks themselves.
+    const int chunk_size = parallel ? max_block_size_ : MicroBlocks::SIZE;
+    const int end_sample = first_sample + num_samples;
+
+    for (int chunk_start = first_sample; chunk_start < end_sample; chunk_start += chunk_size)
+    {
+        const int chunk_samples = juce::jmin (chunk_size, end_sample - chunk_start);
+        processChunk (buffer, chunk_start, chunk_samples, num_channels, values, parallel);
+    }
+}
+
+void WaveFolderAudioProcessor::processChunk (juce::AudioBuffer<float>& buffer, int first_sample, int num_samples, int num_channels, const ParameterValues& values, bool parallel)
+{
+    auto* input_gains = modulation_.getWritePointer (0);
+    auto* biases = modulation_.getWritePointer (1);
+    auto* thresholds = modulation_.getWritePointer (2);
+
+    // The LFOs advance once per sample frame and are shared by all channels, so their rate
+    // depends neither on the layout nor on the oversampling factor.
+    for (int sample = 0; sample < num_samples; ++sample)
+    {
+        input_gains[sample] = values[GAIN] + gain_lfo_.processSample() * gain_lfo_volume_.getNextValue();
+        thresholds[sample] = values[THRESHOLD] + thr_lfo_.processSample() * thr_lfo_volume_.getNextValue();
+        biases[sample] = values[BIAS] + bias_lfo_.processSample() * bias_lfo_volume_.getNextValue();
+    }
+
+    // The gate in mixDry() adds the biases to the dry signal, so they are delayed like it
+    const bool delay_dry = getOversamplers().front().getFactor() > 1;
+    WaveFolderCore::delaySamples (dry_delay_, getMainBusNumOutputChannels(), biases, modulation_.getWritePointer (3), num_samples, delay_dry);
+
+    const int num_groups = (num_channels + CHANNELS_PER_GROUP - 1) / CHANNELS_PER_GROUP;
+    auto process_group = [&] (int group) { processGroup (group, buffer, first_sample, num_samples, num_channels, values); };
+
+    if (parallel)
+    {
+        workers_.run (num_groups, process_group);
+    }
+    else
+    {
+        for (int group = 0; group < num_groups; ++group)
+            process_group (group);
+    }
+}
+
+void WaveFolderAudioProcessor::processGroup (int group, juce::AudioBuffer<float>& buffer, int first_sample, int num_samples, int num_channels, const ParameterValues& values)
+{
+    const int first_channel = group * CHANNELS_PER_GROUP;
+    const int last_channel = juce::jmin (num_channels, first_channel + CHANNELS_PER_GROUP);
+    auto& oversampler = getOversamplers()[static_cast<size_t> (group)];
+    const int factor = oversampler.getFactor();
+    const bool delay_dry = factor > 1;
+    const float dry_wet_mix = values[DRY_WET_MIX];
+    const float output_gain = values[VOLUME];
+
+    MicroBlocks::forEach (num_samples, [&] (int micro_first_sample, int micro_samples) {
+        const int start_sample = first_sample + micro_first_sample;
+        const auto* input_gains = modulation_.getReadPointer (0, micro_first_sample);
+        const auto* biases = modulation_.getReadPointer (1, micro_first_sample);
+        const auto* thresholds = modulation_.getReadPointer (2, micro_first_sample);
+        const auto* dry_biases = modulation_.getReadPointer (3, micro_first_sample);
+
+        // Keep the dry signal lined up with the resampled wet signal. The delay line keeps its
+        // state per channel, so groups may use it at the same time.
+        for (int channel = first_channel; channel < last_channel; ++channel)
+            WaveFolderCore::delaySamples (dry_delay_, channel, buffer.getReadPointer (channel, start_sample), dry_.getWritePointer (channel), micro_samples, delay_dry);
+
+        // Only the folding creates harmonics, so it is the only stage that runs oversampled.
+        auto chunk = juce::AudioBuffer<float> (buffer.getArrayOfWritePointers() + first_channel, last_channel - first_channel, start_sample, micro_samples);
+
+        // A mono source on a stereo track folds to the same thing on both channels. The fold
+        // is shared, so that is only known for a single group.
+        int num_folded = chunk.getNumChannels();
+        const auto get_difference = [&] { return oversampler.getStateDifference (chunk.getNumChannels()); };
+        const auto copy_state = [&] { oversampler.copyFirstChannelState (chunk.getNumChannels()); };
+        if (num_channels <= CHANNELS_PER_GROUP && dual_mono_.update (chunk.getArrayOfReadPointers(), chunk.getNumChannels(), micro_samples, get_difference, copy_state))
+            num_folded = 1;
+
+        const FoldCascade::Modulation modulation { input_gains, biases, thresholds };
+
+        oversampler.process (chunk, num_folded, [&] (juce::dsp::AudioBlock<float>& block, int offset) {
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
             {
-                *buffer.getWritePointer (channel, sample) =
-                    2.0f * (0.0f - threshold) - *buffer.getWritePointer (channel, sample);
+                fold_.process (block.getChannelPointer (channel), static_cast<int> (block.getNumSamples()), factor, modulation, offset);
             }
-            float dry_wet_mix = apvts.getRawParameterValue ("DRY_WET_MIX")->load();
-            // Crossfade between wet signal and dry signal
-            *buffer.getWritePointer (channel, sample) = *buffer.getWritePointer (channel, sample) * dry_wet_mix + dry_sample * (1.0f - dry_wet_mix);
-            *buffer.getWritePointer (channel, sample) *= output_gain;
+        });
+
+        if (num_folded < chunk.getNumChannels())
+            DualMono::copyFirstChannel (chunk.getArrayOfWritePointers(), chunk.getNumChannels(), micro_samples);
+
+        for (int channel = first_channel; channel < last_channel; ++channel)
+            WaveFolderCore::mixDry (buffer.getWritePointer (channel, start_sample), dry_.getReadPointer (channel), dry_biases, micro_samples, dry_wet_mix, output_gain);
+    });
+}
+
+int WaveFolderAudioProcessor::getOversamplingFactor (Tier tier) const
+{
+    const auto factor = 1 << static_cast<int> (apvts.getRawParameterValue ("OVERSAMPLING")->load());
+    const auto offline_choice = static_cast<int> (apvts.getRawParameterValue ("OFFLINE_OVERSAMPLING")->load());
+
+    // Bounces never fold with less oversampling than playback
+    if (tier == OFFLINE && offline_choice > 0)
+        return juce::jmax (factor, 1 << offline_choice);
+    return factor;
+}
+
+void WaveFolderAudioProcessor::prepareOversampler (int samples_per_block)
+{
+    const auto filter_type = static_cast<Oversampler::FilterType> (static_cast<int> (apvts.getRawParameterValue ("OVERSAMPLING_FILTER")->load()));
+
+    const int num_channels = getMainBusNumOutputChannels();
+    const int num_groups = juce::jmax (1, (num_channels + CHANNELS_PER_GROUP - 1) / CHANNELS_PER_GROUP);
+    for (int tier = 0; tier < NUM_TIERS; ++tier)
+    {
+        auto& oversamplers = oversamplers_[static_cast<size_t> (tier)];
+        oversamplers.resize (static_cast<size_t> (num_groups));
+
+        for (int group = 0; group < num_groups; ++group)
+        {
+            const int group_channels = juce::jlimit (1, CHANNELS_PER_GROUP, num_channels - group * CHANNELS_PER_GROUP);
+            oversamplers[static_cast<size_t> (group)].prepare (group_channels, MicroBlocks::getScratchSize (samples_per_block), getOversamplingFactor (static_cast<Tier> (tier)), filter_type);
         }
     }
+
+    // All groups use the same filters, so they share the latency
+    const float latency = getOversamplers().front().getLatencySamples();
+    dry_delay_.reset();
+    dry_delay_.setDelay (latency);
+    setLatencySamples (juce::roundToInt (latency));
+
+    // Every halving of the oversampling is one level, the next block applies the level again
+    const int num_levels = 1 + juce::roundToInt (std::log2 (oversamplers_[REALTIME].front().getPreparedFactor()));
+    governor_.prepare (getSampleRate(), samples_per_block, num_levels);
+    governor_level_ = 0;
+}
+
+bool WaveFolderAudioProcessor::isOversamplerPrepared() const
+{
+    const auto filter_type = static_cast<Oversampler::FilterType> (static_cast<int> (apvts.getRawParameterValue ("OVERSAMPLING_FILTER")->load()));
+
+    for (int tier = 0; tier < NUM_TIERS; ++tier)
+    {
+        const auto& oversampler = oversamplers_[static_cast<size_t> (tier)].front();
+        if (oversampler.getPreparedFactor() != getOversamplingFactor (static_cast<Tier> (tier)) || oversampler.getFilterType() != filter_type)
+            return false;
+    }
+    return true;
+}
+
+void WaveFolderAudioProcessor::switchTier (bool offline)
+{
+    offline_ = offline;
+
+    // The filters may still hold the signal of their last use
+    for (auto& oversampler : getOversamplers())
+        oversampler.reset();
+
+    const float latency = getOversamplers().front().getLatencySamples();
+    dry_delay_.setDelay (latency);
+
+    // The host is told about the new latency from the message thread
+    triggerAsyncUpdate();
+}
+
+void WaveFolderAudioProcessor::applyGovernorLevel (int level)
+{
+    governor_level_ = level;
+
+    // Only playback has a deadline, the offline filters always run at their full factor
+    for (auto& oversampler : oversamplers_[REALTIME])
+        oversampler.setActiveFactor (oversampler.getPreparedFactor() >> level);
+
+    // The dry delay was not running while the factor was 1
+    dry_delay_.reset();
+    dry_delay_.setDelay (getOversamplers().front().getLatencySamples());
+
+    // The host is told about the new latency from the message thread
+    triggerAsyncUpdate();
+}
+
+int WaveFolderAudioProcessor::getNumWorkersToRun() const
+{
+    // The audio thread takes one group itself, more workers than cores would only compete
+    const bool parallel = apvts.getRawParameterValue ("PARALLEL")->load() > 0.5f;
+    const int num_groups = static_cast<int> (oversamplers_[REALTIME].size());
+    return parallel ? juce::jmin (num_groups - 1, juce::SystemStats::getNumCpus() - 1, MAX_WORKERS) : 0;
+}
+
+void WaveFolderAudioProcessor::prepareWorkers()
+{
+    workers_.setNumWorkers (getNumWorkersToRun());
+}
+
+void WaveFolderAudioProcessor::parameterChanged (const juce::String& /*parameter_id*/, float /*new_value*/)
+{
+    // Called from whatever thread changed the parameter, the reconfiguration happens later
+    triggerAsyncUpdate();
+}
+
+void WaveFolderAudioProcessor::handleAsyncUpdate()
+{
+    if (getSampleRate() <= 0.0)
+        return;
+
+    if (isOversamplerPrepared() && workers_.getNumWorkers() == getNumWorkersToRun())
+    {
+        // Only the tier or the governor level changed, the audio thread has already switched filters
+        setLatencySamples (juce::roundToInt (getOversamplers().front().getLatencySamples()));
+        return;
+    }
+
+    // Other filters change the latency, so hold the audio callback while they are set up.
+    suspendProcessing (true);
+    prepareOversampler (max_block_size_);
+    prepareWorkers();
+    suspendProcessing (false);
 }
 
 //==============================================================================
@@ -240,27 +483,83 @@ void WaveFolderAudioProcessor::setStateInformation (const void* data, int sizeIn
 
     if (xmlState.get() != nullptr)
         if (xmlState->hasTagName (apvts.state.getType()))
+        {
             apvts.replaceState (juce::ValueTree::fromXml (*xmlState));
+            custom_curve_.loadFromState();
+            // Saved again without the property, an old project keeps its LFO speed
+            lfo_per_frame_ = static_cast<bool> (apvts.state.getProperty (LFO_PER_FRAME_PROPERTY, false));
+        }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout WaveFolderAudioProcessor::createParameters()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
 
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("GAIN", "Gain", 0.0f, 2.0f, 1.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("BIAS", "Bias", -0.5f, 0.5f, 0.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("THRESHOLD", "Threshold", 0.0f, 0.5f, 0.1f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("VOLUME", "Volume", 0.0f, 2.0f, 1.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("GAIN_LFO_RATE", "Rate", 0.01f, 10.0f, 1.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("GAIN_LFO_DEPTH", "Depth", 0.0f, 0.2f, 0.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("THR_LFO_RATE", "Rate", 0.01f, 10.0f, 1.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("THR_LFO_DEPTH", "Depth", 0.0f, 0.2f, 0.01f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("BIAS_LFO_RATE", "Rate", 0.01f, 10.0f, 1.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("BIAS_LFO_DEPTH", "Depth", 0.0f, 0.2f, 0.0f));
-    parameters.push_back (std::make_unique<juce::AudioParameterFloat> ("DRY_WET_MIX", "Mix", 0.0f, 1.0f, 1.0f));
+    // The parameters of the core first, the oversampling ones are quality settings and not
+    // part of presets. Then the ones only the plugin has.
+    CoreParameterLayout::addParameters (parameters, WaveFolderCore::PARAMETERS);
+    // Oversampling while rendering offline, never less than the one above
+    parameters.push_back (std::make_unique<juce::AudioParameterChoice> ("OFFLINE_OVERSAMPLING", "Offline oversampling", juce::StringArray { "Same as realtime", "2x", "4x", "8x" }, 3));
+    // Folds groups of channels on worker threads, only pays off for wide layouts
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("PARALLEL", "Parallel channels", false));
+    // Lowers the oversampling when processing gets close to the buffer deadline
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("GOVERNOR", "CPU governor", false));
+    // Off only to compare the output without the shortcut, see DualMono
+    parameters.push_back (std::make_unique<juce::AudioParameterBool> ("DUAL_MONO", "Mono shortcut", true));
     return { parameters.begin(), parameters.end() };
 }
 
+void WaveFolderAudioProcessor::addFactoryPresets()
+{
+    auto& bank = program_switcher_.getBank();
+
+    juce::StringPairArray gentle;
+    gentle.set ("GAIN", "1.0");
+    gentle.set ("THRESHOLD", "0.3");
+    gentle.set ("DRY_WET_MIX", "0.5");
+    bank.addPreset ("Gentle Fold", gentle);
+
+    juce::StringPairArray buzz;
+    buzz.set ("GAIN", "1.8");
+    buzz.set ("THRESHOLD", "0.05");
+    buzz.set ("VOLUME", "0.8");
+    bank.addPreset ("Buzz", buzz);
+
+    juce::StringPairArray wobble;
+    wobble.set ("THRESHOLD", "0.15");
+    wobble.set ("THR_LFO_RATE", "0.5");
+    wobble.set ("THR_LFO_DEPTH", "0.1");
+    wobble.set ("GAIN_LFO_RATE", "4.0");
+    wobble.set ("GAIN_LFO_DEPTH", "0.1");
+    bank.addPreset ("Wobble", wobble);
+
+    juce::StringPairArray asymmetric;
+    asymmetric.set ("BIAS", "0.2");
+    asymmetric.set ("THRESHOLD", "0.12");
+    asymmetric.set ("BIAS_LFO_RATE", "0.2");
+    asymmetric.set ("BIAS_LFO_DEPTH", "0.05");
+    bank.addPreset ("Asymmetric", asymmetric);
+
+    juce::StringPairArray cascade;
+    cascade.set ("GAIN", "1.4");
+    cascade.set ("THRESHOLD", "0.25");
+    cascade.set ("FOLD_STAGES", "4");
+    cascade.set ("STAGE_THRESHOLD", "0.8");
+    cascade.set ("STAGE_GAIN", "1.3");
+    cascade.set ("VOLUME", "1.2");
+    bank.addPreset ("Cascade", cascade);
+
+    juce::StringPairArray west_coast;
+    west_coast.set ("GAIN", "1.6");
+    west_coast.set ("THRESHOLD", "0.2");
+    west_coast.set ("CURVE", "2");
+    west_coast.set ("FOLD_STAGES", "2");
+    west_coast.set ("STAGE_GAIN", "1.2");
+    west_coast.set ("THR_LFO_RATE", "0.3");
+    west_coast.set ("THR_LFO_DEPTH", "0.05");
+    bank.addPreset ("West Coast", west_coast);
+}
+
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
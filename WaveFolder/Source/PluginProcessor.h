@@ -8,12 +8,25 @@
 
 #pragma once
 
+#include "CustomCurve.h"
+#include "FoldCascade.h"
+#include "WaveFolderCore.h"
+#include <CoreParameterLayout.h>
+#include <CpuGovernor.h>
+#include <DualMono.h>
 #include <JuceHeader.h>
+#include <Lfo.h>
+#include <MicroBlocks.h>
+#include <Oversampler.h>
+#include <PresetBank.h>
+#include <WorkerPool.h>
 
 //==============================================================================
 /**
 */
-class WaveFolderAudioProcessor : public juce::AudioProcessor
+class WaveFolderAudioProcessor : public juce::AudioProcessor,
+                                 private juce::AudioProcessorValueTreeState::Listener,
+                                 private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -55,14 +68,97 @@ public:
 
     juce::AudioProcessorValueTreeState apvts;
 
+    CustomCurve& getCustomCurve() { return custom_curve_; }
+    // Load and quality level of the opt-in CPU governor, every level halves the oversampling
+    const CpuGovernor& getGovernor() const { return governor_; }
+
 private:
-    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+    // Parameters that make up a preset, in the order of the ids in PARAMETER_IDS
+    enum Parameter
+    {
+        GAIN = 0,
+        BIAS,
+        THRESHOLD,
+        VOLUME,
+        GAIN_LFO_RATE,
+        GAIN_LFO_DEPTH,
+        THR_LFO_RATE,
+        THR_LFO_DEPTH,
+        BIAS_LFO_RATE,
+        BIAS_LFO_DEPTH,
+        DRY_WET_MIX,
+        FOLD_STAGES,
+        STAGE_THRESHOLD,
+        STAGE_GAIN,
+        CURVE,
+        NUM_PARAMETERS
+    };
 
-    juce::dsp::Oscillator<float> gain_lfo_;
+    juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
+    void addFactoryPresets();
+
+    ProgramSwitcher program_switcher_;
+
+    // Channels folded together by one job, their oversampler runs them through its filters
+    // side by side
+    static constexpr int CHANNELS_PER_GROUP = 4;
+    static constexpr int MAX_WORKERS = 7;
+    // Oversampled frames per group below which the workers cost more than they save
+    static constexpr int MIN_PARALLEL_FRAMES = 512;
+
+    // Playback folds at the oversampling of the quality parameters, bounces may oversample
+    // more. Both are prepared up front, so switching when the host starts or stops rendering
+    // offline never allocates.
+    enum Tier
+    {
+        REALTIME = 0,
+        OFFLINE,
+        NUM_TIERS
+    };
+
+    // Processes part of a host block with one set of parameter values
+    void processSegment (juce::AudioBuffer<float>& buffer, int first_sample, int num_samples, int num_channels, const ParameterValues& values);
+    void processChunk (juce::AudioBuffer<float>& buffer, int first_sample, int num_samples, int num_channels, const ParameterValues& values, bool parallel);
+    void processGroup (int group, juce::AudioBuffer<float>& buffer, int first_sample, int num_samples, int num_channels, const ParameterValues& values);
+    int getOversamplingFactor (Tier tier) const;
+    std::vector<Oversampler>& getOversamplers() { return oversamplers_[offline_.load() ? OFFLINE : REALTIME]; }
+    void prepareOversampler (int samples_per_block);
+    bool isOversamplerPrepared() const;
+    void switchTier (bool offline);
+    void applyGovernorLevel (int level);
+    int getNumWorkersToRun() const;
+    void prepareWorkers();
+    void parameterChanged (const juce::String& parameter_id, float new_value) override;
+    void handleAsyncUpdate() override;
+
+    FoldCascade fold_;
+    CustomCurve custom_curve_ { apvts };
+    // One per group of channels and tier, the filters keep per instance state
+    std::array<std::vector<Oversampler>, NUM_TIERS> oversamplers_;
+    // Set on the audio thread from isNonRealtime(), read when reporting the latency
+    std::atomic<bool> offline_ { false };
+    // False for a state saved before the LFOs advanced once per sample frame
+    std::atomic<bool> lfo_per_frame_ { true };
+
+    CpuGovernor governor_;
+    int governor_level_ = 0;
+    WorkerPool workers_;
+    // Folds one channel for all of them while the input is the same on every channel, only
+    // with a single group of channels
+    DualMono dual_mono_;
+    // One channel per audio channel and a last one for the biases, see WaveFolderCore
+    WaveFolderCore::DryDelay dry_delay_ { 64 };
+    juce::AudioBuffer<float> dry_;
+    // Input gain, bias and threshold of every sample frame in a chunk, and the bias delayed
+    // like the dry signal
+    juce::AudioBuffer<float> modulation_;
+    int max_block_size_ = 0;
+
+    Lfo gain_lfo_;
     juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> gain_lfo_volume_;
-    juce::dsp::Oscillator<float> thr_lfo_;
+    Lfo thr_lfo_;
     juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> thr_lfo_volume_;
-    juce::dsp::Oscillator<float> bias_lfo_;
+    Lfo bias_lfo_;
     juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> bias_lfo_volume_;
 
     //==============================================================================
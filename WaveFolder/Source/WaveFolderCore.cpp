@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    WaveFolderCore.cpp
+    Created: 19 Oct 2026 9:58:17pm
+
+  ==============================================================================
+*/
+
+#include "WaveFolderCore.h"
+
+const float GATE_THRESHOLD = 0.005f;
+
+const CoreParameter WaveFolderCore::PARAMETERS[NUM_PARAMETERS] = {
+    { "GAIN", "Gain", 0.0f, 2.0f, 1.0f },
+    { "BIAS", "Bias", -0.5f, 0.5f, 0.0f },
+    { "THRESHOLD", "Threshold", 0.0f, 0.5f, 0.1f },
+    { "VOLUME", "Volume", 0.0f, 2.0f, 1.0f },
+    { "GAIN_LFO_RATE", "Rate", 0.01f, 10.0f, 1.0f },
+    { "GAIN_LFO_DEPTH", "Depth", 0.0f, 0.2f, 0.0f },
+    { "THR_LFO_RATE", "Rate", 0.01f, 10.0f, 1.0f },
+    { "THR_LFO_DEPTH", "Depth", 0.0f, 0.2f, 0.01f },
+    { "BIAS_LFO_RATE", "Rate", 0.01f, 10.0f, 1.0f },
+    { "BIAS_LFO_DEPTH", "Depth", 0.0f, 0.2f, 0.0f },
+    { "DRY_WET_MIX", "Mix", 0.0f, 1.0f, 1.0f },
+    // Further folds in series, each at the previous threshold times the stage threshold
+    { "FOLD_STAGES", "Stages", 1.0f, static_cast<float> (FoldCascade::MAX_STAGES), 1.0f, true },
+    { "STAGE_THRESHOLD", "Stage threshold", 0.5f, 1.5f, 1.0f },
+    { "STAGE_GAIN", "Stage gain", 1.0f, 2.0f, 1.0f },
+    // Transfer curve of every fold stage, in the order of FoldCascade::Curve
+    { "CURVE", "Curve", 0.0f, static_cast<float> (FoldCascade::NUM_CURVES - 1), 0.0f, true, false, "Triangle|Sine|Buchla|Soft|Custom" },
+    { "OVERSAMPLING", "Oversampling", 0.0f, 3.0f, 0.0f, true, true, "Off|2x|4x|8x" },
+    { "OVERSAMPLING_FILTER", "Oversampling Filter", 0.0f, 1.0f, 0.0f, true, true, "Low latency|Linear phase" },
+};
+
+WaveFolderCore::WaveFolderCore()
+{
+    for (int parameter = 0; parameter < NUM_PARAMETERS; ++parameter)
+        values_[static_cast<size_t> (parameter)] = PARAMETERS[parameter].default_value;
+}
+
+void WaveFolderCore::mixDry (float* samples, const float* dry, const float* biases, int num_samples, float dry_wet_mix, float output_gain)
+{
+    for (int sample = 0; sample < num_samples; ++sample)
+    {
+        // Do not add any effects if volume is to low to prevent lfos to leak.
+        if (dry[sample] + biases[sample] < GATE_THRESHOLD && dry[sample] + biases[sample] > -GATE_THRESHOLD)
+        {
+            samples[sample] = dry[sample];
+            continue;
+        }
+
+        // Crossfade between wet signal and dry signal
+        samples[sample] = (samples[sample] * dry_wet_mix + dry[sample] * (1.0f - dry_wet_mix)) * output_gain;
+    }
+}
+
+void WaveFolderCore::delaySamples (DryDelay& delay, int channel, const float* input, float* output, int num_samples, bool delayed)
+{
+    for (int sample = 0; sample < num_samples; ++sample)
+    {
+        if (delayed)
+        {
+            delay.pushSample (channel, input[sample]);
+            output[sample] = delay.popSample (channel);
+        }
+        else
+        {
+            output[sample] = input[sample];
+        }
+    }
+}
+
+void WaveFolderCore::prepare (double sample_rate, int max_block_size, int num_channels)
+{
+    num_channels_ = num_channels;
+    // Every stage only ever sees one micro block
+    const int scratch_size = MicroBlocks::getScratchSize (max_block_size);
+
+    gain_lfo_.prepare (sample_rate);
+    thr_lfo_.prepare (sample_rate);
+    bias_lfo_.prepare (sample_rate);
+
+    modulation_.setSize (4, scratch_size);
+    dry_.setSize (num_channels, scratch_size);
+    // One more channel for the biases
+    dry_delay_.prepare ({ sample_rate, static_cast<juce::uint32> (scratch_size), static_cast<juce::uint32> (num_channels + 1) });
+
+    const auto filter_type = static_cast<Oversampler::FilterType> (juce::roundToInt (values_[OVERSAMPLING_FILTER]));
+    oversampler_.prepare (num_channels, scratch_size, 1 << juce::roundToInt (values_[OVERSAMPLING]), filter_type);
+    dry_delay_.setDelay (oversampler_.getLatencySamples());
+    dual_mono_.reset();
+    micro_channels_.resize (static_cast<size_t> (num_channels));
+}
+
+void WaveFolderCore::reset()
+{
+    gain_lfo_.reset();
+    thr_lfo_.reset();
+    bias_lfo_.reset();
+    oversampler_.reset();
+    dry_delay_.reset();
+    dual_mono_.reset();
+}
+
+void WaveFolderCore::setParameter (int index, float value)
+{
+    if (index >= 0 && index < NUM_PARAMETERS)
+        values_[static_cast<size_t> (index)] = juce::jlimit (PARAMETERS[index].min_value, PARAMETERS[index].max_value, value);
+}
+
+void WaveFolderCore::process (float* const* channels, int num_channels, int num_samples)
+{
+    jassert (num_channels <= num_channels_);
+
+    juce::ScopedNoDenormals no_denormals;
+
+    gain_lfo_.setFrequency (values_[GAIN_LFO_RATE]);
+    gain_lfo_volume_.setTargetValue (values_[GAIN_LFO_DEPTH]);
+    thr_lfo_.setFrequency (values_[THR_LFO_RATE]);
+    thr_lfo_volume_.setTargetValue (values_[THR_LFO_DEPTH]);
+    bias_lfo_.setFrequency (values_[BIAS_LFO_RATE]);
+    bias_lfo_volume_.setTargetValue (values_[BIAS_LFO_DEPTH]);
+
+    const auto curve = static_cast<FoldCascade::Curve> (juce::roundToInt (values_[CURVE]));
+    fold_.setStages (curve, juce::roundToInt (values_[FOLD_STAGES]), values_[STAGE_THRESHOLD], values_[STAGE_GAIN]);
+
+    // The modulation, the dry copy and the oversampled signal stay in L1 from the LFOs to the
+    // mix, see MicroBlocks
+    makeStageChain (makeFunctionStage ([this] (float* const*, int, int micro_samples) { modulate (micro_samples); }),
+                    makeFunctionStage ([this] (float* const* micro_channels, int micro_num_channels, int micro_samples) { delayDry (micro_channels, micro_num_channels, micro_samples); }),
+                    makeFunctionStage ([this] (float* const* micro_channels, int micro_num_channels, int micro_samples) { fold (micro_channels, micro_num_channels, micro_samples); }),
+                    makeFunctionStage ([this] (float* const* micro_channels, int micro_num_channels, int micro_samples) { mix (micro_channels, micro_num_channels, micro_samples); }))
+        .process (channels, num_channels, num_samples, micro_channels_);
+}
+
+void WaveFolderCore::modulate (int num_samples)
+{
+    auto* input_gains = modulation_.getWritePointer (0);
+    auto* biases = modulation_.getWritePointer (1);
+    auto* thresholds = modulation_.getWritePointer (2);
+
+    // The LFOs advance once per sample frame and are shared by all channels, so their rate
+    // depends neither on the layout nor on the oversampling factor.
+    for (int sample = 0; sample < num_samples; ++sample)
+    {
+        input_gains[sample] = values_[GAIN] + gain_lfo_.processSample() * gain_lfo_volume_.getNextValue();
+        thresholds[sample] = values_[THRESHOLD] + thr_lfo_.processSample() * thr_lfo_volume_.getNextValue();
+        biases[sample] = values_[BIAS] + bias_lfo_.processSample() * bias_lfo_volume_.getNextValue();
+    }
+}
+
+void WaveFolderCore::delayDry (const float* const* channels, int num_channels, int num_samples)
+{
+    // Keep the dry signal lined up with the resampled wet signal, and the biases the gate in
+    // mixDry() adds to it lined up with the dry signal
+    const bool delay_dry = oversampler_.getFactor() > 1;
+    delaySamples (dry_delay_, num_channels_, modulation_.getReadPointer (1), modulation_.getWritePointer (3), num_samples, delay_dry);
+
+    for (int channel = 0; channel < num_channels; ++channel)
+        delaySamples (dry_delay_, channel, channels[channel], dry_.getWritePointer (channel), num_samples, delay_dry);
+}
+
+void WaveFolderCore::fold (float* const* channels, int num_channels, int num_samples)
+{
+    // Only the folding creates harmonics, so it is the only stage that runs oversampled.
+    const int factor = oversampler_.getFactor();
+    const FoldCascade::Modulation modulation { modulation_.getReadPointer (0), modulation_.getReadPointer (1), modulation_.getReadPointer (2) };
+
+    // Identical channels fold to the same thing, see DualMono
+    const auto get_difference = [&] { return oversampler_.getStateDifference (num_channels); };
+    const auto copy_state = [&] { oversampler_.copyFirstChannelState (num_channels); };
+    const int num_folded = dual_mono_.update (channels, num_channels, num_samples, get_difference, copy_state) ? 1 : num_channels;
+
+    oversampler_.process (channels, num_folded, num_samples, [&] (juce::dsp::AudioBlock<float>& block, int offset) {
+        for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            fold_.process (block.getChannelPointer (channel), static_cast<int> (block.getNumSamples()), factor, modulation, offset);
+    });
+
+    if (num_folded < num_channels)
+        DualMono::copyFirstChannel (channels, num_channels, num_samples);
+}
+
+void WaveFolderCore::mix (float* const* channels, int num_channels, int num_samples)
+{
+    for (int channel = 0; channel < num_channels; ++channel)
+        mixDry (channels[channel], dry_.getReadPointer (channel), modulation_.getReadPointer (3), num_samples, values_[DRY_WET_MIX], values_[VOLUME]);
+}
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    WaveFolderCore.h
+    Created: 19 Oct 2026 9:58:17pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FoldCascade.h"
+#include <CoreParameter.h>
+#include <DualMono.h>
+#include <JuceHeader.h>
+#include <Lfo.h>
+#include <MicroBlocks.h>
+#include <Oversampler.h>
+#include <StageChain.h>
+
+// The sound of WaveFolder without the plugin around it: modulated fold cascade, gate and
+// mix, for hosts that embed the DSP directly. Needs juce_audio_basics and juce_dsp only.
+//
+// Parameters are plain values in the ranges of PARAMETERS. The quality settings OVERSAMPLING
+// and OVERSAMPLING_FILTER take effect at the next prepare(). The custom curve needs a table
+// from setCustomTable(), without one it folds with the triangle. No presets, tiers, worker
+// threads or CPU governor, those stay in the plugin.
+class WaveFolderCore
+{
+public:
+    enum Parameter
+    {
+        GAIN = 0,
+        BIAS,
+        THRESHOLD,
+        VOLUME,
+        GAIN_LFO_RATE,
+        GAIN_LFO_DEPTH,
+        THR_LFO_RATE,
+        THR_LFO_DEPTH,
+        BIAS_LFO_RATE,
+        BIAS_LFO_DEPTH,
+        DRY_WET_MIX,
+        FOLD_STAGES,
+        STAGE_THRESHOLD,
+        STAGE_GAIN,
+        CURVE,
+        OVERSAMPLING,
+        OVERSAMPLING_FILTER,
+        NUM_PARAMETERS
+    };
+
+    static const CoreParameter PARAMETERS[NUM_PARAMETERS];
+
+    WaveFolderCore();
+
+    // Also used by the plugin, so both sound the same: passes the dry signal where it is too
+    // quiet to fold, so the LFOs do not leak into silence, and crossfades everywhere else
+    static void mixDry (float* samples, const float* dry, const float* biases, int num_samples, float dry_wet_mix, float output_gain);
+
+    // Delays the dry signal by the latency of the oversampler
+    typedef juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> DryDelay;
+    // Also used by the plugin: copies input to output through one channel of the delay, or
+    // straight while the oversampler has no latency
+    static void delaySamples (DryDelay& delay, int channel, const float* input, float* output, int num_samples, bool delayed);
+
+    void prepare (double sample_rate, int max_block_size, int num_channels);
+    void reset();
+
+    void setParameter (int index, float value);
+    float getParameter (int index) const { return values_[static_cast<size_t> (index)]; }
+    int getLatencySamples() const { return juce::roundToInt (oversampler_.getLatencySamples()); }
+    // See FoldCascade::setCustomTable()
+    void setCustomTable (const float* table) { fold_.setCustomTable (table); }
+
+    // Processes num_channels planar channels in place, one micro block at a time through all
+    // stages, see StageChain
+    void process (float* const* channels, int num_channels, int num_samples);
+
+private:
+    // The stages of a micro block, in order
+    void modulate (int num_samples);
+    void delayDry (const float* const* channels, int num_channels, int num_samples);
+    void fold (float* const* channels, int num_channels, int num_samples);
+    void mix (float* const* channels, int num_channels, int num_samples);
+
+    std::array<float, NUM_PARAMETERS> values_ {};
+    int num_channels_ = 0;
+
+    FoldCascade fold_;
+    Oversampler oversampler_;
+    DualMono dual_mono_;
+    // One channel per audio channel and a last one for the biases
+    DryDelay dry_delay_ { 64 };
+    juce::AudioBuffer<float> dry_;
+    // Input gain, bias and threshold of every sample frame in a micro block, and the bias
+    // delayed like the dry signal
+    juce::AudioBuffer<float> modulation_;
+    // Channel pointers of the micro block the stages run on, see StageChain
+    std::vector<float*> micro_channels_;
+
+    Lfo gain_lfo_;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> gain_lfo_volume_;
+    Lfo thr_lfo_;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> thr_lfo_volume_;
+    Lfo bias_lfo_;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> bias_lfo_volume_;
+};